@@ -15,6 +15,8 @@
 
 #include "../audio/audio.hpp"
 #include "../core/game_core.hpp"
+#include "../core/sprite_manager.hpp"
+#include "../core/perf_counters.hpp"
 #include "../level/level.hpp"
 #include "../overworld/overworld.hpp"
 #include "../user/preferences.hpp"
@@ -34,14 +36,23 @@ namespace SMC {
 
 void Finished_Sound(const int channel)
 {
-    // find the finished sound and free the data
-    for (AudioSoundList::iterator itr = pAudio->m_active_sounds.begin(); itr != pAudio->m_active_sounds.end(); ++itr) {
-        cAudio_Sound* obj = (*itr);
+    pAudio->Sound_Channel_Finished(channel);
+}
 
-        if (obj->m_channel == channel) {
-            obj->Finished();
+float Get_Distance_Volume_Mod(float distance, float reduction_begin, float reduction_end)
+{
+    // if in volume reduction range
+    if (distance > reduction_begin) {
+        // out of range
+        if (distance >= reduction_end) {
+            return 0.0f;
         }
+
+        return 1.0f - (distance - reduction_begin) / (reduction_end - reduction_begin);
     }
+
+    // no reduction
+    return 1.0f;
 }
 
 /* *** *** *** *** *** *** *** *** Audio Sound *** *** *** *** *** *** *** *** *** */
@@ -49,8 +60,12 @@ void Finished_Sound(const int channel)
 cAudio_Sound::cAudio_Sound(void)
 {
     m_data = NULL;
+    m_voice = -1;
     m_channel = -1;
     m_resource_id = -1;
+    m_priority = SOUND_PRIORITY_NORMAL;
+    m_play_id = 0;
+    m_free = 0;
 }
 
 cAudio_Sound::~cAudio_Sound(void)
@@ -85,7 +100,7 @@ void cAudio_Sound::Finished(void)
 
 int cAudio_Sound::Play(int use_res_id /* = -1 */, int loops /* = 0 */)
 {
-    if (!m_data || !m_data->m_chunk) {
+    if (!m_data || !m_data->m_chunk || m_voice < 0) {
         return 0;
     }
 
@@ -95,7 +110,7 @@ int cAudio_Sound::Play(int use_res_id /* = -1 */, int loops /* = 0 */)
             cAudio_Sound* obj = (*itr);
 
             // skip self
-            if (!obj || obj->m_channel == m_channel) {
+            if (!obj || obj == this) {
                 continue;
             }
 
@@ -107,11 +122,21 @@ int cAudio_Sound::Play(int use_res_id /* = -1 */, int loops /* = 0 */)
     }
 
     m_resource_id = use_res_id;
-    // play sound
-    m_channel = Mix_PlayChannel(-1, m_data->m_chunk, loops);
     // add callback if sound finished playing
     Mix_ChannelFinished(&Finished_Sound);
 
+    // the finished callback must not run before the channel is set
+    SDL_LockAudio();
+
+    // play sound
+    m_channel = Mix_PlayChannel(m_voice, m_data->m_chunk, loops);
+
+    if (m_channel >= 0) {
+        m_data->m_playing_count++;
+    }
+
+    SDL_UnlockAudio();
+
     return m_channel;
 }
 
@@ -140,9 +165,17 @@ cAudio::cAudio(void)
     m_music_volume = cPreferences::m_music_volume_default;
 
     m_music = NULL;
-    m_music_old = NULL;
 
     m_max_sounds = 0;
+    m_max_sound_instances = 4;
+    m_sound_distance_reduction_begin = 800.0f;
+    m_sound_distance_reduction_end = 2000.0f;
+
+    m_sounds_dropped = 0;
+    m_sounds_stolen = 0;
+    m_sounds_culled = 0;
+
+    m_play_counter = 0;
 
     m_audio_buffer = 4096; // below 2048 can be choppy
     m_audio_channels = MIX_DEFAULT_CHANNELS; // 1 = Mono, 2 = Stereo
@@ -300,6 +333,7 @@ void cAudio::Close(void)
             }
 
             m_active_sounds.clear();
+            m_free_voices.clear();
 
             Mix_AllocateChannels(0);
             m_max_sounds = 0;
@@ -309,16 +343,17 @@ void cAudio::Close(void)
         if (m_music_enabled) {
             Halt_Music();
 
+            m_music_requests.clear();
+            // the mixer must not be used by the loading track when closed
+            m_music_loader.Clear(1);
+
+            Clear_Music_Queue();
+
             if (m_music) {
-                Mix_FreeMusic(m_music);
+                delete m_music;
                 m_music = NULL;
             }
 
-            if (m_music_old) {
-                Mix_FreeMusic(m_music_old);
-                m_music_old = NULL;
-            }
-
             m_music_enabled = 0;
         }
 
@@ -341,21 +376,36 @@ void cAudio::Set_Max_Sounds(unsigned int limit /* = 10 */)
 
     m_max_sounds = limit;
 
-    // remove exceeding sounds
-    AudioSoundList::iterator last_itr;
+    // remove the old voices
+    Stop_Sounds();
 
-    while (m_active_sounds.size() > m_max_sounds) {
-        last_itr = (m_active_sounds.end() - 1);
-
-        // delete data
-        delete *(last_itr);
-        // erase from list
-        m_active_sounds.erase(last_itr);
+    for (AudioSoundList::iterator itr = m_active_sounds.begin(); itr != m_active_sounds.end(); ++itr) {
+        delete *itr;
     }
 
+    m_active_sounds.clear();
+    m_free_voices.clear();
+
     // change channels managed by the mixer
     Mix_AllocateChannels(m_max_sounds);
 
+    // one voice per mixer channel
+    m_active_sounds.reserve(m_max_sounds);
+    // never reallocated in the mixer callback
+    m_free_voices.reserve(m_max_sounds);
+
+    for (unsigned int i = 0; i < m_max_sounds; i++) {
+        cAudio_Sound* sound = new cAudio_Sound();
+        sound->m_voice = i;
+        m_active_sounds.push_back(sound);
+    }
+
+    // lowest voice is used first
+    for (AudioSoundList::reverse_iterator itr = m_active_sounds.rbegin(); itr != m_active_sounds.rend(); ++itr) {
+        (*itr)->m_free = 1;
+        m_free_voices.push_back(*itr);
+    }
+
     if (m_debug) {
         cout << "Audio Sound Channels changed : " << Mix_AllocateChannels(-1) << endl;
     }
@@ -368,7 +418,7 @@ cSound* cAudio::Get_Sound_File(fs::path filename) const
     }
 
     // not available
-    if (!File_Exists(filename)) {
+    if (!pPackage_Manager->Resource_Exists(filename)) {
         // add sound directory if required
         if (!filename.is_absolute())
             filename = pPackage_Manager->Get_Sound_Reading_Path(path_to_utf8(filename));
@@ -376,6 +426,11 @@ cSound* cAudio::Get_Sound_File(fs::path filename) const
 
     cSound* sound = pSound_Manager->Get_Pointer(filename);
 
+    // decoded in the background
+    if (!sound) {
+        sound = pSound_Manager->Take_Prewarmed(filename);
+    }
+
     // if not already cached
     if (!sound) {
         sound = new cSound();
@@ -396,24 +451,98 @@ cSound* cAudio::Get_Sound_File(fs::path filename) const
             return NULL;
         }
     }
+    else {
+        pSound_Manager->Touch(sound);
+    }
 
     return sound;
 }
 
-bool cAudio::Play_Sound(fs::path filename, int res_id /* = -1 */, int volume /* = -1 */, int loops /* = 0 */)
+void cAudio::Prewarm_Sounds(cSprite_Manager* sprite_manager) const
+{
+    if (!m_initialised || !m_sound_enabled) {
+        return;
+    }
+
+    vector<std::string> sound_files;
+
+    for (cSprite_List::const_iterator itr = sprite_manager->objects.begin(); itr != sprite_manager->objects.end(); ++itr) {
+        (*itr)->Get_Sound_Files(sound_files);
+    }
+
+    // remove duplicates
+    std::sort(sound_files.begin(), sound_files.end());
+    sound_files.erase(std::unique(sound_files.begin(), sound_files.end()), sound_files.end());
+
+    vector<fs::path> filenames;
+
+    for (vector<std::string>::const_iterator itr = sound_files.begin(); itr != sound_files.end(); ++itr) {
+        if (itr->empty()) {
+            continue;
+        }
+
+        fs::path filename = utf8_to_path(*itr);
+
+        // add sound directory if required
+        if (!pPackage_Manager->Resource_Exists(filename) && !filename.is_absolute()) {
+            filename = pPackage_Manager->Get_Sound_Reading_Path(*itr);
+        }
+
+        if (!pPackage_Manager->Resource_Exists(filename)) {
+            continue;
+        }
+
+        filenames.push_back(filename);
+    }
+
+    if (m_debug) {
+        cout << "Prewarming " << filenames.size() << " level sounds" << endl;
+    }
+
+    pSound_Manager->Prewarm(filenames);
+}
+
+void cAudio::Trim_Sound_Cache(void)
+{
+    if (!pSound_Manager->Is_Over_Budget()) {
+        return;
+    }
+
+    SoundList in_use;
+
+    for (AudioSoundList::iterator itr = m_active_sounds.begin(); itr != m_active_sounds.end(); ++itr) {
+        cAudio_Sound* obj = (*itr);
+
+        if (!obj->m_data) {
+            continue;
+        }
+
+        // release the data of finished sounds
+        if (obj->m_channel < 0) {
+            obj->Free();
+            continue;
+        }
+
+        in_use.push_back(obj->m_data);
+    }
+
+    pSound_Manager->Trim(in_use);
+}
+
+bool cAudio::Play_Sound(fs::path filename, int res_id /* = -1 */, int volume /* = -1 */, int loops /* = 0 */, int priority /* = SOUND_PRIORITY_AUTO */)
 {
     if (!m_initialised || !m_sound_enabled) {
         return 0;
     }
 
     // not available
-    if (!File_Exists(filename)) {
+    if (!pPackage_Manager->Resource_Exists(filename)) {
         // add sound directory
         if (!filename.is_absolute())
             filename = pPackage_Manager->Get_Sound_Reading_Path(path_to_utf8(filename));
 
         // not found
-        if (!File_Exists(filename)) {
+        if (!pPackage_Manager->Resource_Exists(filename)) {
             cerr << "Warning: Could not find sound file '" << path_to_utf8(filename) << "'" << endl;
             return false;
         }
@@ -427,8 +556,38 @@ bool cAudio::Play_Sound(fs::path filename, int res_id /* = -1 */, int volume /*
         return false;
     }
 
+    if (priority == SOUND_PRIORITY_AUTO) {
+        priority = (res_id >= 0) ? SOUND_PRIORITY_HIGH : SOUND_PRIORITY_NORMAL;
+    }
+
+    // too many instances of this sound
+    const unsigned int max_instances = sound_data->m_max_instances ? sound_data->m_max_instances : m_max_sound_instances;
+
+    if (max_instances && sound_data->m_playing_count >= max_instances) {
+        // replace the oldest instance
+        cAudio_Sound* oldest = NULL;
+
+        for (AudioSoundList::iterator itr = m_active_sounds.begin(); itr != m_active_sounds.end(); ++itr) {
+            cAudio_Sound* obj = (*itr);
+
+            if (obj->m_channel >= 0 && obj->m_data == sound_data && (!oldest || obj->m_play_id < oldest->m_play_id)) {
+                oldest = obj;
+            }
+        }
+
+        if (!oldest || oldest->m_priority > priority) {
+            m_sounds_dropped++;
+            pPerf_Counters->Add(PERF_COUNT_SOUNDS_SKIPPED);
+            return 0;
+        }
+
+        oldest->Stop();
+        m_sounds_stolen++;
+        pPerf_Counters->Add(PERF_COUNT_SOUNDS_SKIPPED);
+    }
+
     // create channel
-    cAudio_Sound* sound = Create_Sound_Channel();
+    cAudio_Sound* sound = Create_Sound_Channel(priority);
 
     if (!sound) {
         // no free channel available
@@ -437,12 +596,19 @@ bool cAudio::Play_Sound(fs::path filename, int res_id /* = -1 */, int volume /*
 
     // load data
     sound->Load(sound_data);
+    sound->m_priority = priority;
+    sound->m_play_id = ++m_play_counter;
     // play
     sound->Play(res_id, loops);
 
     // failed to play
     if (sound->m_channel < 0) {
         debug_print("Could not play sound file : %s\n", path_to_utf8(filename).c_str());
+
+        // return the voice
+        SDL_LockAudio();
+        Sound_Channel_Finished(sound->m_voice);
+        SDL_UnlockAudio();
         return 0;
     }
     // playing successfully
@@ -459,18 +625,45 @@ bool cAudio::Play_Sound(fs::path filename, int res_id /* = -1 */, int volume /*
 
         // set volume
         Mix_Volume(sound->m_channel, volume);
+
+        pPerf_Counters->Add(PERF_COUNT_SOUNDS_PLAYED);
     }
 
     return 1;
 }
 
+bool cAudio::Play_Sound_At(fs::path filename, float pos_x, float pos_y, int res_id /* = -1 */, int volume /* = -1 */, int loops /* = 0 */, int priority /* = SOUND_PRIORITY_AUTO */)
+{
+    if (!m_initialised || !m_sound_enabled) {
+        return 0;
+    }
+
+    // distance from the camera center
+    const float dx = pActive_Camera->m_x + (game_res_w * 0.5f) - pos_x;
+    const float dy = pActive_Camera->m_y + (game_res_h * 0.5f) - pos_y;
+    const float volume_mod = Get_Distance_Volume_Mod(sqrt(dx * dx + dy * dy), m_sound_distance_reduction_begin, m_sound_distance_reduction_end);
+
+    // too far away
+    if (volume_mod <= 0.0f) {
+        m_sounds_culled++;
+        pPerf_Counters->Add(PERF_COUNT_SOUNDS_SKIPPED);
+        return 0;
+    }
+
+    if (volume < 0 || volume > MIX_MAX_VOLUME) {
+        volume = m_sound_volume;
+    }
+
+    return Play_Sound(filename, res_id, static_cast<int>(static_cast<float>(volume) * volume_mod), loops, priority);
+}
+
 bool cAudio::Play_Music(fs::path filename, int loops /* = 0 */, bool force /* = 1 */, unsigned int fadein_ms /* = 0 */)
 {
     if (!filename.is_absolute())
         filename = pPackage_Manager->Get_Music_Reading_Path(path_to_utf8(filename));
 
     // no valid file
-    if (!File_Exists(filename)) {
+    if (!pPackage_Manager->Resource_Exists(filename)) {
         cerr << "Warning: Couldn't find music file '" << path_to_utf8(filename) << "'" << endl;
         return 0;
     }
@@ -482,65 +675,121 @@ bool cAudio::Play_Music(fs::path filename, int loops /* = 0 */, bool force /* =
         return 0;
     }
 
+    // not readable ( archived files are mapped already )
+    if (!pPackage_Manager->Is_Archived(filename)) {
+        fs::ifstream file(filename, ios::in | ios::binary);
+
+        if (!file.is_open()) {
+            cerr << "Warning: Couldn't open music file '" << path_to_utf8(filename) << "'" << endl;
+            return 0;
+        }
+    }
+
     // if music is stopped resume it
     Resume_Music();
 
-    // if no music is playing or force to play the given music
-    if (!Is_Music_Playing() || force) {
-        // stop and free current music
-        if (m_music) {
-            Halt_Music();
-            Mix_FreeMusic(m_music);
+    // forced music replaces the waiting music
+    if (force) {
+        m_music_requests.clear();
+        m_music_loader.Clear();
+    }
+
+    cMusic_Request request;
+    request.m_filename = filename;
+    request.m_loops = loops;
+    request.m_force = force;
+    request.m_fadein_ms = fadein_ms;
+    m_music_requests.push_back(request);
+
+    m_music_loader.Load(filename);
+
+    return true;
+}
+
+void cAudio::Update_Music_Requests(void)
+{
+    while (!m_music_requests.empty()) {
+        const cMusic_Request request = m_music_requests.front();
+        cMusic_Track* track = m_music_loader.Take(request.m_filename);
+
+        // still loading
+        if (!track) {
+            return;
         }
-        // free old music
-        if (m_music_old) {
-            Mix_FreeMusic(m_music_old);
-            m_music_old = NULL;
+
+        m_music_requests.erase(m_music_requests.begin());
+
+        // not loaded
+        if (!track->m_music) {
+            cerr << "Warning: Couldn't load music file '" << path_to_utf8(request.m_filename) << "' : " << track->m_error << endl;
+            delete track;
+            continue;
         }
 
-        // load the given music
-        m_music = Mix_LoadMUS(path_to_utf8(filename).c_str());
+        Start_Music(track, request.m_loops, request.m_force, request.m_fadein_ms);
+    }
+}
+
+void cAudio::Start_Music(cMusic_Track* track, int loops, bool force, unsigned int fadein_ms)
+{
+    cMusic_Queue_Item item;
+    item.m_track = track;
+    item.m_loops = loops;
+    item.m_force = force;
+    item.m_fadein_ms = fadein_ms;
+
+    // fade out the current music and play the given music after it
+    if (force && fadein_ms && m_music && Is_Music_Playing() && !Is_Music_Paused()) {
+        Clear_Music_Queue();
+        m_music_queue.push_back(item);
+
+        Fadeout_Music(fadein_ms);
+    }
+    // if no music is playing or force to play the given music
+    else if (!Is_Music_Playing() || force) {
+        // stop and free current music
+        Halt_Music();
+        Clear_Music_Queue();
 
-        // loaded
         if (m_music) {
-            // no fade in
-            if (!fadein_ms) {
-                Mix_PlayMusic(m_music, loops);
-            }
-            // fade in
-            else {
-                Mix_FadeInMusic(m_music, loops, fadein_ms);
-            }
+            delete m_music;
         }
-        // not loaded
-        else {
-            debug_print("Couldn't load music file : %s\n", path_to_utf8(filename).c_str());
 
-            // failed to play
-            return false;
-        }
+        m_music = track;
+        Play_Music_Track(m_music, loops, fadein_ms);
     }
     // music is playing and is not forced
     else {
-        // if music is loaded
-        if (m_music) {
-            // if old music is loaded free the wanted next playing music data
-            if (m_music_old) {
-                Mix_FreeMusic(m_music);
-                m_music = NULL;
-            }
-            // if no old music move current to old music
-            else {
-                m_music_old = m_music;
-                m_music = NULL;
-            }
+        // replace the wanted next playing music
+        if (!m_music_queue.empty() && !m_music_queue.back().m_force) {
+            delete m_music_queue.back().m_track;
+            m_music_queue.pop_back();
         }
 
-        // load the wanted next playing music
-        m_music = Mix_LoadMUS(path_to_utf8(filename).c_str());
+        item.m_fadein_ms = 0;
+        m_music_queue.push_back(item);
     }
+}
 
-    return true;
+void cAudio::Play_Music_Track(cMusic_Track* track, int loops, unsigned int fadein_ms) const
+{
+    // no fade in
+    if (!fadein_ms) {
+        Mix_PlayMusic(track->m_music, loops);
+    }
+    // fade in
+    else {
+        Mix_FadeInMusic(track->m_music, loops, fadein_ms);
+    }
+}
+
+void cAudio::Clear_Music_Queue(void)
+{
+    for (vector<cMusic_Queue_Item>::iterator itr = m_music_queue.begin(); itr != m_music_queue.end(); ++itr) {
+        delete itr->m_track;
+    }
+
+    m_music_queue.clear();
 }
 
 cAudio_Sound* cAudio::Get_Playing_Sound(fs::path filename)
@@ -574,30 +823,87 @@ cAudio_Sound* cAudio::Get_Playing_Sound(fs::path filename)
     return NULL;
 }
 
-cAudio_Sound* cAudio::Create_Sound_Channel(void)
+cAudio_Sound* cAudio::Create_Sound_Channel(int priority /* = SOUND_PRIORITY_NORMAL */)
 {
-    // get all sounds
+    cAudio_Sound* sound = Get_Free_Voice();
+
+    // found a free channel
+    if (sound) {
+        sound->Free();
+        return sound;
+    }
+
+    // find the oldest sound with the lowest priority
+    cAudio_Sound* oldest = NULL;
+
     for (AudioSoundList::iterator itr = m_active_sounds.begin(); itr != m_active_sounds.end(); ++itr) {
-        // get object pointer
         cAudio_Sound* obj = (*itr);
 
-        // if not playing
-        if (obj->m_channel < 0) {
-            // found a free channel
-            obj->Free();
-            return obj;
+        if (obj->m_channel < 0 || obj->m_priority > priority || obj->m_priority >= SOUND_PRIORITY_CRITICAL) {
+            continue;
         }
-    }
 
-    // if not maximum sounds
-    if (m_active_sounds.size() < m_max_sounds) {
-        cAudio_Sound* sound = new cAudio_Sound();
-        m_active_sounds.push_back(sound);
-        return sound;
+        if (!oldest || obj->m_priority < oldest->m_priority || (obj->m_priority == oldest->m_priority && obj->m_play_id < oldest->m_play_id)) {
+            oldest = obj;
+        }
     }
 
     // none found
-    return NULL;
+    if (!oldest) {
+        m_sounds_dropped++;
+        pPerf_Counters->Add(PERF_COUNT_SOUNDS_SKIPPED);
+        return NULL;
+    }
+
+    // stopping returns it to the free voices
+    oldest->Stop();
+    m_sounds_stolen++;
+    pPerf_Counters->Add(PERF_COUNT_SOUNDS_SKIPPED);
+
+    sound = Get_Free_Voice();
+
+    if (sound) {
+        sound->Free();
+    }
+
+    return sound;
+}
+
+cAudio_Sound* cAudio::Get_Free_Voice(void)
+{
+    cAudio_Sound* sound = NULL;
+
+    SDL_LockAudio();
+
+    if (!m_free_voices.empty()) {
+        sound = m_free_voices.back();
+        m_free_voices.pop_back();
+        sound->m_free = 0;
+    }
+
+    SDL_UnlockAudio();
+
+    return sound;
+}
+
+void cAudio::Sound_Channel_Finished(int channel)
+{
+    if (channel < 0 || channel >= static_cast<int>(m_active_sounds.size())) {
+        return;
+    }
+
+    cAudio_Sound* sound = m_active_sounds[channel];
+
+    if (sound->m_channel >= 0 && sound->m_data && sound->m_data->m_playing_count) {
+        sound->m_data->m_playing_count--;
+    }
+
+    sound->Finished();
+
+    if (!sound->m_free) {
+        sound->m_free = 1;
+        m_free_voices.push_back(sound);
+    }
 }
 
 void cAudio::Toggle_Music(void)
@@ -690,8 +996,8 @@ void cAudio::Fadeout_Sounds(unsigned int ms, fs::path filename, bool overwrite_f
         // get object pointer
         const cAudio_Sound* obj = (*itr);
 
-        // filename does not match
-        if (obj->m_data->m_filename.compare(filename) != 0) {
+        // not playing or filename does not match
+        if (obj->m_channel < 0 || !obj->m_data || obj->m_data->m_filename.compare(filename) != 0) {
             continue;
         }
 
@@ -862,16 +1168,30 @@ void cAudio::Update(void)
         return;
     }
 
+    pSound_Manager->Set_Memory_Budget(pPreferences->m_audio_sound_cache_size * 1024 * 1024);
+    Trim_Sound_Cache();
+
     // if music is enabled
     if (m_music_enabled) {
+        Update_Music_Requests();
+
         // if no music is playing
-        if (!Mix_PlayingMusic() && m_music) {
-            Mix_PlayMusic(m_music, 0);
+        if (!Mix_PlayingMusic()) {
+            // play the waiting music
+            if (!m_music_queue.empty()) {
+                const cMusic_Queue_Item item = m_music_queue.front();
+                m_music_queue.erase(m_music_queue.begin());
+
+                // delete old music
+                if (m_music) {
+                    delete m_music;
+                }
 
-            // delete old music if available
-            if (m_music_old) {
-                Mix_FreeMusic(m_music_old);
-                m_music_old = NULL;
+                m_music = item.m_track;
+                Play_Music_Track(m_music, item.m_loops, item.m_fadein_ms);
+            }
+            else if (m_music) {
+                Play_Music_Track(m_music, 0, 0);
             }
         }
     }
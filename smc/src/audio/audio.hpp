@@ -17,7 +17,9 @@
 #define SMC_AUDIO_HPP
 
 #include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
 #include "../audio/sound_manager.hpp"
+#include "../audio/music_loader.hpp"
 #include "../scripting/scriptable_object.hpp"
 #include "../scripting/objects/misc/mrb_audio.hpp"
 
@@ -44,6 +46,27 @@ namespace SMC {
         RID_MOON            = 7
     };
 
+    /* *** *** *** *** *** *** *** Sound priority *** *** *** *** *** *** *** *** *** *** */
+
+// if all channels are used a sound can take the channel of a sound with the same or a lower priority
+    enum SoundPriority {
+        // high if a resource id is given else normal
+        SOUND_PRIORITY_AUTO     = -1,
+        // ambient sounds
+        SOUND_PRIORITY_LOW      = 0,
+        SOUND_PRIORITY_NORMAL   = 1,
+        // player sounds
+        SOUND_PRIORITY_HIGH     = 2,
+        // never taken by other sounds
+        SOUND_PRIORITY_CRITICAL = 3
+    };
+
+    /* Returns the volume modifier (0.0 - 1.0) for the given distance
+     * reduction_begin : the volume is reduced beyond this distance
+     * reduction_end : the volume is zero at this distance
+    */
+    float Get_Distance_Volume_Mod(float distance, float reduction_begin, float reduction_end);
+
     /* *** *** *** *** *** *** *** Audio Sound object *** *** *** *** *** *** *** *** *** *** */
 
 // Callback for a sound finished playing
@@ -61,7 +84,7 @@ namespace SMC {
         // Finished playing
         void Finished(void);
 
-        /* Play the Sound
+        /* Play the Sound on the mixer channel of this voice
          * use_res_id: if set stops all sounds using the same resource id.
          * loops : if set to -1 loops indefinitely or if greater than zero, loop the sound that many times.
         */
@@ -72,10 +95,18 @@ namespace SMC {
         // sound object
         cSound* m_data;
 
+        // mixer channel used by this voice
+        int m_voice;
         // channel if playing else -1
         int m_channel;
         // the last used resource id
         int m_resource_id;
+        // priority of the playing sound
+        int m_priority;
+        // play order to find the oldest sound
+        Uint32 m_play_id;
+        // in the free voice list
+        bool m_free;
     };
 
     typedef vector<cAudio_Sound*> AudioSoundList;
@@ -107,10 +138,31 @@ namespace SMC {
          * The returned sound should not be deleted or modified.
          */
         cSound* Get_Sound_File(boost::filesystem::path filename) const;
+        /* Decode the sounds the sprites can play in the background
+         * Called after a level is loaded so the first use does not stutter.
+        */
+        void Prewarm_Sounds(cSprite_Manager* sprite_manager) const;
+        /* Free least recently used sounds if the sound cache memory budget is exceeded
+         * Playing sounds are kept.
+        */
+        void Trim_Sound_Cache(void);
 
-        // Play the given sound. `filename' should be relative to the sounds/ directory.
-        bool Play_Sound(boost::filesystem::path filename, int res_id = -1, int volume = -1, int loops = 0);
-        // If no forcing it will be played after the current music
+        /* Play the given sound. `filename' should be relative to the sounds/ directory.
+         * priority : SoundPriority used if all channels are in use
+        */
+        bool Play_Sound(boost::filesystem::path filename, int res_id = -1, int volume = -1, int loops = 0, int priority = SOUND_PRIORITY_AUTO);
+        /* Play the given sound emitted at the given level position
+         * The volume is reduced with the distance to the camera center and
+         * the sound is not played if it is too far away.
+        */
+        bool Play_Sound_At(boost::filesystem::path filename, float pos_x, float pos_y, int res_id = -1, int volume = -1, int loops = 0, int priority = SOUND_PRIORITY_AUTO);
+        /* Play the given music. `filename' should be relative to the music/ directory.
+         * The music is loaded in the background and started on Update() once it is ready.
+         * If no forcing it will be played after the current music.
+         * If forced with a fade in the current music fades out first.
+         * Returns true if the file was found and queued for loading. A file which can not
+         * be decoded is only reported with a warning once the loading finished.
+        */
         bool Play_Music(boost::filesystem::path filename, int loops = 0, bool force = 1, unsigned int fadein_ms = 0);
 
         /* Returns a pointer to the sound if it is active.
@@ -118,9 +170,13 @@ namespace SMC {
          */
         cAudio_Sound* Get_Playing_Sound(boost::filesystem::path filename);
 
-        /* Returns true if a free channel for the sound is available
+        /* Returns a free channel for the sound
+         * If all channels are in use the oldest sound with the lowest priority not
+         * above the given priority is stopped. Returns NULL if none is available.
         */
-        cAudio_Sound* Create_Sound_Channel(void);
+        cAudio_Sound* Create_Sound_Channel(int priority = SOUND_PRIORITY_NORMAL);
+        // Called from the mixer if the sound on the channel finished
+        void Sound_Channel_Finished(int channel);
 
         // Toggle Music on/off
         void Toggle_Music(void);
@@ -206,19 +262,69 @@ namespace SMC {
 
         // current playing music filename
         boost::filesystem::path m_music_filename;
-        // current playing music pointer
-        Mix_Music* m_music;
-        // if new music should play after the current this is the old data
-        Mix_Music* m_music_old;
+        // current playing music
+        cMusic_Track* m_music;
 
         // The current sounds pointer array
         AudioSoundList m_active_sounds;
 
         // maximum sounds allowed at once
         unsigned int m_max_sounds;
+        // default maximum instances of the same sound playing at once
+        unsigned int m_max_sound_instances;
+        // sounds further away from the camera center are quieter or not played
+        float m_sound_distance_reduction_begin;
+        float m_sound_distance_reduction_end;
+
+        // sounds not played because no channel was available
+        unsigned int m_sounds_dropped;
+        // sounds stopped to play a new sound
+        unsigned int m_sounds_stolen;
+        // sounds not played because they were too far away
+        unsigned int m_sounds_culled;
 
         // initialization information
         int m_audio_buffer, m_audio_channels;
+
+    private:
+        // Return a free voice or NULL
+        cAudio_Sound* Get_Free_Voice(void);
+        // Start the loaded music requests
+        void Update_Music_Requests(void);
+        // Play or queue the loaded music track
+        void Start_Music(cMusic_Track* track, int loops, bool force, unsigned int fadein_ms);
+        // Start playing the music track
+        void Play_Music_Track(cMusic_Track* track, int loops, unsigned int fadein_ms) const;
+        // Delete the music waiting for the current music
+        void Clear_Music_Queue(void);
+
+        // a music waiting to be loaded
+        struct cMusic_Request {
+            boost::filesystem::path m_filename;
+            int m_loops;
+            bool m_force;
+            unsigned int m_fadein_ms;
+        };
+
+        // a loaded music waiting for the current music to end
+        struct cMusic_Queue_Item {
+            cMusic_Track* m_track;
+            int m_loops;
+            bool m_force;
+            unsigned int m_fadein_ms;
+        };
+
+        // loads the music files in the background
+        cMusic_Loader m_music_loader;
+        // music to play in order once loaded
+        vector<cMusic_Request> m_music_requests;
+        // music to play in order after the current music
+        vector<cMusic_Queue_Item> m_music_queue;
+
+        // voices not playing. Also modified by the mixer callback with the audio locked
+        vector<cAudio_Sound*> m_free_voices;
+        // play order counter
+        Uint32 m_play_counter;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -0,0 +1,217 @@
+/***************************************************************************
+ * music_loader.cpp  -  background music loading
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../audio/music_loader.hpp"
+#include "../core/property_helper.hpp"
+#include "../core/filesystem/package_manager.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace SMC {
+
+/* *** *** *** *** *** *** *** cMusic_Track *** *** *** *** *** *** *** *** *** *** */
+
+cMusic_Track::cMusic_Track(void)
+{
+    m_music = NULL;
+    m_rw = NULL;
+}
+
+cMusic_Track::~cMusic_Track(void)
+{
+    if (m_music) {
+        Mix_FreeMusic(m_music);
+        m_music = NULL;
+    }
+
+    // the mixer does not free the source
+    if (m_rw) {
+        SDL_RWclose(m_rw);
+        m_rw = NULL;
+    }
+}
+
+bool cMusic_Track::Load(const fs::path& filename)
+{
+    m_filename = filename;
+
+    // read from the mapped package archive
+    if (pPackage_Manager->Is_Archived(filename)) {
+        m_rw = pPackage_Manager->Open_Resource_RW(filename);
+
+        if (!m_rw) {
+            return 0;
+        }
+
+        m_music = Mix_LoadMUS_RW(m_rw);
+
+        return m_music != NULL;
+    }
+
+    fs::ifstream file(filename, ios::in | ios::binary);
+
+    if (!file.is_open()) {
+        return 0;
+    }
+
+    file.seekg(0, ios::end);
+    const streamoff size = file.tellg();
+    file.seekg(0, ios::beg);
+
+    if (size <= 0) {
+        return 0;
+    }
+
+    m_data.resize(static_cast<size_t>(size));
+
+    if (!file.read(&m_data[0], size)) {
+        m_data.clear();
+        return 0;
+    }
+
+    m_rw = SDL_RWFromConstMem(&m_data[0], static_cast<int>(m_data.size()));
+
+    if (!m_rw) {
+        return 0;
+    }
+
+    m_music = Mix_LoadMUS_RW(m_rw);
+
+    return m_music != NULL;
+}
+
+/* *** *** *** *** *** *** *** cMusic_Loader *** *** *** *** *** *** *** *** *** *** */
+
+cMusic_Loader::cMusic_Loader(void)
+{
+    m_generation = 0;
+    m_loading = 0;
+    m_exit = 0;
+}
+
+cMusic_Loader::~cMusic_Loader(void)
+{
+    if (m_thread.joinable()) {
+        {
+            boost::lock_guard<boost::mutex> lock(m_mutex);
+            m_exit = 1;
+        }
+
+        m_cond.notify_one();
+        m_thread.join();
+    }
+
+    Clear();
+}
+
+void cMusic_Loader::Load(const fs::path& filename)
+{
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_queue.push_back(filename);
+    }
+
+    if (!m_thread.joinable()) {
+        m_thread = boost::thread(&cMusic_Loader::Thread_Loop, this);
+    }
+
+    m_cond.notify_one();
+}
+
+cMusic_Track* cMusic_Loader::Take(const fs::path& filename)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    for (vector<cMusic_Track*>::iterator itr = m_loaded.begin(); itr != m_loaded.end(); ++itr) {
+        cMusic_Track* track = (*itr);
+
+        if (track->m_filename == filename) {
+            m_loaded.erase(itr);
+            return track;
+        }
+    }
+
+    return NULL;
+}
+
+void cMusic_Loader::Clear(bool wait /* = 0 */)
+{
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+
+    m_queue.clear();
+    m_generation++;
+
+    // the thread deletes the dropped track before it signals
+    if (wait) {
+        while (m_loading) {
+            m_loading_cond.wait(lock);
+        }
+    }
+
+    for (vector<cMusic_Track*>::iterator itr = m_loaded.begin(); itr != m_loaded.end(); ++itr) {
+        delete *itr;
+    }
+
+    m_loaded.clear();
+}
+
+void cMusic_Loader::Thread_Loop(void)
+{
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+
+    while (1) {
+        while (m_queue.empty() && !m_exit) {
+            m_cond.wait(lock);
+        }
+
+        if (m_exit) {
+            return;
+        }
+
+        const fs::path filename = m_queue.front();
+        m_queue.erase(m_queue.begin());
+        const Uint32 generation = m_generation;
+        m_loading = 1;
+
+        // load without blocking the requests
+        lock.unlock();
+
+        cMusic_Track* track = new cMusic_Track();
+
+        // reported when taken in the main thread
+        if (!track->Load(filename)) {
+            track->m_error = Mix_GetError();
+        }
+
+        lock.lock();
+
+        // cleared while loading
+        if (generation != m_generation) {
+            delete track;
+        }
+        else {
+            m_loaded.push_back(track);
+        }
+
+        m_loading = 0;
+        m_loading_cond.notify_all();
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,98 @@
+/***************************************************************************
+ * music_loader.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_MUSIC_LOADER_HPP
+#define SMC_MUSIC_LOADER_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** cMusic_Track *** *** *** *** *** *** *** *** *** *** */
+
+    /* A music file read into memory and opened by the mixer
+     * The mixer streams the music from memory so playing it does not access the disk.
+    */
+    class cMusic_Track {
+    public:
+        cMusic_Track(void);
+        ~cMusic_Track(void);
+
+        /* Read and open the music file
+         * returns true on success
+        */
+        bool Load(const boost::filesystem::path& filename);
+
+        // filename
+        boost::filesystem::path m_filename;
+        // mixer music if loaded else NULL
+        Mix_Music* m_music;
+        // reason if not loaded
+        std::string m_error;
+
+    private:
+        // file data the music is streamed from
+        vector<char> m_data;
+        SDL_RWops* m_rw;
+    };
+
+    /* *** *** *** *** *** *** *** cMusic_Loader *** *** *** *** *** *** *** *** *** *** */
+
+    /* Loads music tracks in a background thread
+     * Each Load() request results in one track which is returned by Take().
+    */
+    class cMusic_Loader {
+    public:
+        cMusic_Loader(void);
+        ~cMusic_Loader(void);
+
+        // Load the music file in the background
+        void Load(const boost::filesystem::path& filename);
+        /* Return the loaded track of the file or NULL if it is still loading
+         * The caller owns the track. If loading failed its music is NULL.
+        */
+        cMusic_Track* Take(const boost::filesystem::path& filename);
+        /* Remove all requests and delete the loaded tracks
+         * wait : also wait until the track loading in the background is deleted
+         * Needed before the mixer is closed as loading uses the mixer.
+        */
+        void Clear(bool wait = 0);
+
+    private:
+        // Background thread loading the requested tracks
+        void Thread_Loop(void);
+
+        boost::thread m_thread;
+        boost::mutex m_mutex;
+        boost::condition_variable m_cond;
+        // signaled when the loading of a track finished
+        boost::condition_variable m_loading_cond;
+        // files to load
+        vector<boost::filesystem::path> m_queue;
+        // loaded tracks not yet taken
+        vector<cMusic_Track*> m_loaded;
+        // increased on Clear() to drop the track currently loading
+        Uint32 m_generation;
+        // a track is loading
+        bool m_loading;
+        // the thread should exit
+        bool m_exit;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
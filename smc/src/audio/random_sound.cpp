@@ -74,6 +74,8 @@ void cRandom_Sound::Init(void)
     m_editor_pos_z = 0.111f;
     m_camera_range = 0;
     m_name = "Sound";
+    // the delays are in milliseconds and do not need to be checked every frame
+    Set_Update_Policy(UPDATE_POLICY_INTERVAL, 3);
 
     m_rect.m_w = 10.0f;
     m_rect.m_h = 10.0f;
@@ -119,6 +121,13 @@ std::string cRandom_Sound::Get_XML_Type_Name()
     return "";
 }
 
+void cRandom_Sound::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    if (!m_filename.empty()) {
+        sound_files.push_back(m_filename);
+    }
+}
+
 xmlpp::Element* cRandom_Sound::Save_To_XML_Node(xmlpp::Element* p_element)
 {
     xmlpp::Element* p_node = cSprite::Save_To_XML_Node(p_element);
@@ -274,14 +283,7 @@ float cRandom_Sound::Get_Volume_Reduction_End(void) const
 
 float cRandom_Sound::Get_Distance_Volume_Mod(void) const
 {
-    // if in volume reduction range
-    if (m_distance_to_camera > m_volume_reduction_begin) {
-        const float distance = m_distance_to_camera - m_volume_reduction_begin;
-        return 1.0f - distance / (m_volume_reduction_end - m_volume_reduction_begin);
-    }
-
-    // no reduction
-    return 1.0f;
+    return SMC::Get_Distance_Volume_Mod(m_distance_to_camera, m_volume_reduction_begin, m_volume_reduction_end);
 }
 
 void cRandom_Sound::Update(void)
@@ -371,7 +373,7 @@ void cRandom_Sound::Update(void)
         sound_volume *= static_cast<float>(MIX_MAX_VOLUME);
 
         // play sound
-        pAudio->Play_Sound(m_filename, -1, static_cast<int>(sound_volume), loops);
+        pAudio->Play_Sound(m_filename, -1, static_cast<int>(sound_volume), loops, SOUND_PRIORITY_LOW);
     }
 }
 
@@ -74,6 +74,9 @@ namespace SMC {
         // Returns the volume modifier (0.0 - 1.0) for the current distance
         float Get_Distance_Volume_Mod(void) const;
 
+        // Add the played sound file
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+
         // update
         virtual void Update(void);
         // draw
@@ -15,6 +15,9 @@
 
 #include "../core/property_helper.hpp"
 #include "../audio/sound_manager.hpp"
+#include "../core/filesystem/package_manager.hpp"
+
+using namespace std;
 
 namespace fs = boost::filesystem;
 
@@ -25,6 +28,9 @@ namespace SMC {
 cSound::cSound(void)
 {
     m_chunk = NULL;
+    m_last_use = 0;
+    m_playing_count = 0;
+    m_max_instances = 0;
 }
 
 cSound::~cSound(void)
@@ -36,7 +42,14 @@ bool cSound::Load(const fs::path& filename)
 {
     Free();
 
-    m_chunk = Mix_LoadWAV(path_to_utf8(filename).c_str());
+    SDL_RWops* rw = pPackage_Manager->Open_Resource_RW(filename);
+
+    if (!rw) {
+        return 0;
+    }
+
+    // closes the read operation
+    m_chunk = Mix_LoadWAV_RW(rw, 1);
 
     if (m_chunk) {
         m_filename = filename;
@@ -56,6 +69,15 @@ void cSound::Free(void)
     m_filename.clear();
 }
 
+Uint32 cSound::Get_Memory_Size(void) const
+{
+    if (!m_chunk) {
+        return 0;
+    }
+
+    return m_chunk->alen;
+}
+
 
 /* *** *** *** *** *** *** cSound_Manager *** *** *** *** *** *** *** *** *** *** *** */
 
@@ -63,6 +85,10 @@ cSound_Manager::cSound_Manager(void)
     : cObject_Manager<cSound>()
 {
     m_load_count = 0;
+    m_use_counter = 0;
+    m_memory_usage = 0;
+    m_memory_budget = 0;
+    m_prewarm_discard = 0;
 }
 
 cSound_Manager::~cSound_Manager(void)
@@ -88,6 +114,8 @@ cSound* cSound_Manager::Get_Pointer(const fs::path& path) const
 void cSound_Manager::Add(cSound* sound)
 {
     m_load_count++;
+    m_memory_usage += sound->Get_Memory_Size();
+    Touch(sound);
     cObject_Manager<cSound>::Add(sound);
 }
 
@@ -99,6 +127,158 @@ void cSound_Manager::Delete_Sounds(void)
         delete obj;
         obj = NULL;
     }
+
+    m_memory_usage = 0;
+}
+
+void cSound_Manager::Delete_All(void)
+{
+    Prewarm_Cancel();
+    cObject_Manager<cSound>::Delete_All();
+    m_memory_usage = 0;
+}
+
+void cSound_Manager::Touch(cSound* sound)
+{
+    m_use_counter++;
+    sound->m_last_use = m_use_counter;
+}
+
+void cSound_Manager::Prewarm(const vector<fs::path>& filenames)
+{
+    for (vector<fs::path>::const_iterator itr = filenames.begin(); itr != filenames.end(); ++itr) {
+        const fs::path& filename = (*itr);
+
+        // already cached or queued
+        if (Get_Pointer(filename) || m_prewarm_jobs.find(filename) != m_prewarm_jobs.end()) {
+            continue;
+        }
+
+        m_prewarm_jobs[filename] = pJob_System->Add(new cPrewarm_Job(this, filename));
+    }
+}
+
+void cSound_Manager::Prewarm_Cancel(void)
+{
+    if (m_prewarm_jobs.empty()) {
+        return;
+    }
+
+    // copy as the continuations remove the jobs
+    const std::map<fs::path, Job_ID> jobs = m_prewarm_jobs;
+
+    for (std::map<fs::path, Job_ID>::const_iterator itr = jobs.begin(); itr != jobs.end(); ++itr) {
+        pJob_System->Cancel(itr->second);
+    }
+
+    m_prewarm_discard = 1;
+
+    for (std::map<fs::path, Job_ID>::const_iterator itr = jobs.begin(); itr != jobs.end(); ++itr) {
+        pJob_System->Wait(itr->second);
+    }
+
+    m_prewarm_discard = 0;
+    m_prewarm_jobs.clear();
+}
+
+cSound* cSound_Manager::Take_Prewarmed(const fs::path& filename)
+{
+    std::map<fs::path, Job_ID>::iterator itr = m_prewarm_jobs.find(filename);
+
+    if (itr == m_prewarm_jobs.end()) {
+        return NULL;
+    }
+
+    const Job_ID id = itr->second;
+
+    // the caller loads it now if not started
+    pJob_System->Cancel(id);
+    pJob_System->Wait(id);
+
+    return Get_Pointer(filename);
+}
+
+void cSound_Manager::Set_Memory_Budget(Uint32 bytes)
+{
+    m_memory_budget = bytes;
+}
+
+bool cSound_Manager::Is_Over_Budget(void) const
+{
+    return m_memory_budget && m_memory_usage > m_memory_budget;
+}
+
+void cSound_Manager::Trim(const SoundList& in_use)
+{
+    while (Is_Over_Budget()) {
+        cSound* oldest = NULL;
+
+        for (SoundList::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+            cSound* sound = (*itr);
+
+            if (!sound->m_chunk || std::find(in_use.begin(), in_use.end(), sound) != in_use.end()) {
+                continue;
+            }
+
+            if (!oldest || sound->m_last_use < oldest->m_last_use) {
+                oldest = sound;
+            }
+        }
+
+        // everything left is playing
+        if (!oldest) {
+            return;
+        }
+
+        m_memory_usage -= oldest->Get_Memory_Size();
+        cObject_Manager<cSound>::Delete(oldest);
+    }
+}
+
+/* *** *** *** *** *** *** cSound_Manager::cPrewarm_Job *** *** *** *** *** *** *** *** *** *** *** */
+
+cSound_Manager::cPrewarm_Job::cPrewarm_Job(cSound_Manager* manager, const fs::path& filename)
+    : cJob("sound prewarm", JOB_PRIORITY_LOW)
+{
+    m_manager = manager;
+    m_filename = filename;
+    m_sound = NULL;
+}
+
+cSound_Manager::cPrewarm_Job::~cPrewarm_Job(void)
+{
+    if (m_sound) {
+        delete m_sound;
+    }
+}
+
+void cSound_Manager::cPrewarm_Job::Run(void)
+{
+    m_sound = new cSound();
+
+    if (!m_sound->Load(m_filename)) {
+        cerr << "Warning: Could not prewarm sound file " << path_to_utf8(m_filename) << endl;
+        delete m_sound;
+        m_sound = NULL;
+    }
+}
+
+void cSound_Manager::cPrewarm_Job::Finish(bool canceled)
+{
+    m_manager->m_prewarm_jobs.erase(m_filename);
+
+    // a decoded sound is used even if canceled while decoding
+    if (!m_sound || m_manager->m_prewarm_discard) {
+        return;
+    }
+
+    // loaded in the meantime
+    if (m_manager->Get_Pointer(m_sound->m_filename)) {
+        return;
+    }
+
+    m_manager->Add(m_sound);
+    m_sound = NULL;
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
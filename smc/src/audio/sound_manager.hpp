@@ -18,6 +18,7 @@
 
 #include "../core/global_basic.hpp"
 #include "../core/obj_manager.hpp"
+#include "../core/job_system.hpp"
 
 namespace SMC {
 
@@ -33,10 +34,19 @@ namespace SMC {
         // Free the data
         void Free(void);
 
+        // Return the decoded sample size in bytes
+        Uint32 Get_Memory_Size(void) const;
+
         // filename
         boost::filesystem::path m_filename;
         // data if loaded else null
         Mix_Chunk* m_chunk;
+        // use stamp of the last access for the least recently used eviction
+        Uint32 m_last_use;
+        // number of channels playing this sound
+        unsigned int m_playing_count;
+        // maximum instances playing at once or 0 to use the audio default
+        unsigned int m_max_instances;
     };
 
     typedef vector<cSound*> SoundList;
@@ -44,6 +54,9 @@ namespace SMC {
     /* *** *** *** *** *** *** cSound_Manager *** *** *** *** *** *** *** *** *** *** *** */
 
     /*  Keeps track of all sounds in memory
+     * Sounds can be decoded with low priority jobs by Prewarm() and are moved into
+     * the cache by the job continuation. If a memory budget is set the least recently
+     * used sounds are freed by Trim().
      *
      * Operators:
      * - cSound_Manager [path]
@@ -74,10 +87,72 @@ namespace SMC {
 
         // Delete all Sounds, but keep object vector entries
         void Delete_Sounds(void);
+        // Delete all Sounds and cancel the background loading
+        virtual void Delete_All(void);
+
+        // Mark the sound as used now
+        void Touch(cSound* sound);
+
+        /* Decode the given sounds in the background
+         * Already cached or queued sounds are ignored.
+         * The filenames must be resolved like in cAudio::Get_Sound_File
+        */
+        void Prewarm(const vector<boost::filesystem::path>& filenames);
+        /* Return the sound if it was decoded in the background
+         * Waits if it is decoding and cancels it if it was not started yet.
+         * Returns NULL if not available
+        */
+        cSound* Take_Prewarmed(const boost::filesystem::path& filename);
+
+        // Set the memory budget in bytes. 0 is unlimited
+        void Set_Memory_Budget(Uint32 bytes);
+        // Returns true if the cached sounds exceed the memory budget
+        bool Is_Over_Budget(void) const;
+        /* Free the least recently used sounds until the memory budget is met
+         * in_use : sounds which are playing and must not be freed
+        */
+        void Trim(const SoundList& in_use);
+
+        // Return the memory used by the cached sounds in bytes
+        Uint32 Get_Memory_Usage(void) const
+        {
+            return m_memory_usage;
+        }
 
     private:
+        // Decodes a sound in a worker thread
+        class cPrewarm_Job : public cJob {
+        public:
+            cPrewarm_Job(cSound_Manager* manager, const boost::filesystem::path& filename);
+            virtual ~cPrewarm_Job(void);
+
+            virtual void Run(void);
+            // move the sound into the cache
+            virtual void Finish(bool canceled);
+
+            cSound_Manager* m_manager;
+            boost::filesystem::path m_filename;
+            // decoded sound or NULL
+            cSound* m_sound;
+        };
+
+        // Cancel the prewarm jobs and delete the sounds they loaded
+        void Prewarm_Cancel(void);
+
         // sounds loaded since initialization
         unsigned int m_load_count;
+
+        // use stamp counter
+        Uint32 m_use_counter;
+        // memory used by the cached sounds
+        Uint32 m_memory_usage;
+        // memory budget or 0 if unlimited
+        Uint32 m_memory_budget;
+
+        // prewarm jobs not yet finished
+        std::map<boost::filesystem::path, Job_ID> m_prewarm_jobs;
+        // delete the sounds of the finished prewarm jobs
+        bool m_prewarm_discard;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
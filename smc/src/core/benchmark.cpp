@@ -0,0 +1,392 @@
+/***************************************************************************
+ * benchmark.cpp  -  Micro-benchmarks for engine hot paths
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/benchmark.hpp"
+#include "../video/resample.hpp"
+#include "../core/math/radix_sort.hpp"
+#include "../scripting/events/touch_event.hpp"
+
+using namespace std;
+
+namespace SMC {
+
+/* *** *** *** *** *** *** *** Benchmark timer *** *** *** *** *** *** *** *** *** *** */
+
+cBenchmark_Timer::cBenchmark_Timer(void)
+{
+    Reset();
+}
+
+void cBenchmark_Timer::Reset(void)
+{
+    m_start = boost::chrono::high_resolution_clock::now();
+}
+
+double cBenchmark_Timer::Get_Elapsed_Ms(void) const
+{
+    return boost::chrono::duration<double, boost::milli>(boost::chrono::high_resolution_clock::now() - m_start).count();
+}
+
+/* *** *** *** *** *** *** *** Image resampling *** *** *** *** *** *** *** *** *** *** */
+
+/* The block downscaler previously used by cVideo::Downscale_Image
+ * function from Jonathan Dummer
+ * from image helper functions
+ * MIT license
+*/
+static void Benchmark_Legacy_Downscale(const unsigned char* const orig, int width, int height, int channels, unsigned char* resampled, int block_size_x, int block_size_y)
+{
+    int mip_width = max(width / block_size_x, 1);
+    int mip_height = max(height / block_size_y, 1);
+
+    for (int j = 0; j < mip_height; ++j) {
+        for (int i = 0; i < mip_width; ++i) {
+            for (int c = 0; c < channels; ++c) {
+                const int index = (j * block_size_y) * width * channels + (i * block_size_x) * channels + c;
+                int u_block = block_size_x;
+                int v_block = block_size_y;
+
+                if (block_size_x * (i + 1) > width) {
+                    u_block = width - i * block_size_y;
+                }
+                if (block_size_y * (j + 1) > height) {
+                    v_block = height - j * block_size_y;
+                }
+
+                const int block_area = u_block * v_block;
+                int sum_value = block_area >> 1;
+
+                for (int v = 0; v < v_block; ++v) {
+                    for (int u = 0; u < u_block; ++u) {
+                        sum_value += orig[index + v * width * channels + u * channels];
+                    }
+                }
+
+                resampled[j * mip_width * channels + i * channels + c] = sum_value / block_area;
+            }
+        }
+    }
+}
+
+static int Benchmark_Resample(void)
+{
+    // source size, target size
+    const int cases[][4] = {
+        {512, 512, 256, 256},
+        {1024, 1024, 512, 512},
+        {2048, 2048, 512, 512},
+        {2048, 1024, 1365, 682}, // non-integer ratio
+        {4096, 4096, 2048, 2048}
+    };
+    const unsigned int case_count = sizeof(cases) / sizeof(cases[0]);
+    const int channels = 4;
+
+    cout << "Resample benchmark (" << channels << " channels, best of 5 runs in ms)" << endl;
+    cout << "Cpu implementation : " << Get_Resample_Impl_Name(Get_Resample_Impl()) << endl;
+    cout << setw(22) << left << "size" << setw(10) << right << "legacy" << setw(10) << "scalar" << setw(10) << "sse2" << setw(10) << "avx2" << setw(10) << "threaded" << endl;
+
+    for (unsigned int c = 0; c < case_count; c++) {
+        const int width = cases[c][0];
+        const int height = cases[c][1];
+        const int new_width = cases[c][2];
+        const int new_height = cases[c][3];
+
+        vector<unsigned char> orig(width * height * channels);
+        vector<unsigned char> resampled(new_width * new_height * channels);
+
+        for (unsigned int i = 0; i < orig.size(); i++) {
+            orig[i] = static_cast<unsigned char>(rand());
+        }
+
+        // legacy, scalar, sse2, avx2, threaded
+        double best[5];
+
+        for (unsigned int i = 0; i < 5; i++) {
+            best[i] = -1;
+        }
+
+        for (unsigned int run = 0; run < 5; run++) {
+            cBenchmark_Timer timer;
+
+            // the legacy block filter only supports whole block sizes
+            if (width % new_width == 0 && height % new_height == 0) {
+                Benchmark_Legacy_Downscale(&orig[0], width, height, channels, &resampled[0], width / new_width, height / new_height);
+
+                double elapsed = timer.Get_Elapsed_Ms();
+                if (best[0] < 0 || elapsed < best[0]) {
+                    best[0] = elapsed;
+                }
+            }
+
+            const Resample_Impl impls[4] = {RESAMPLE_IMPL_SCALAR, RESAMPLE_IMPL_SSE2, RESAMPLE_IMPL_AVX2, RESAMPLE_IMPL_AUTO};
+
+            for (unsigned int i = 0; i < 4; i++) {
+                // skip if not supported by the cpu
+                if (impls[i] != RESAMPLE_IMPL_AUTO && Get_Resample_Impl(impls[i]) != impls[i]) {
+                    continue;
+                }
+
+                timer.Reset();
+                Resample_Image(&orig[0], width, height, channels, &resampled[0], new_width, new_height, impls[i], impls[i] == RESAMPLE_IMPL_AUTO ? 0 : 1);
+
+                double elapsed = timer.Get_Elapsed_Ms();
+                if (best[i + 1] < 0 || elapsed < best[i + 1]) {
+                    best[i + 1] = elapsed;
+                }
+            }
+        }
+
+        stringstream size_str;
+        size_str << width << "x" << height << " -> " << new_width << "x" << new_height;
+        cout << setw(22) << left << size_str.str() << right << fixed << setprecision(2);
+
+        for (unsigned int i = 0; i < 5; i++) {
+            if (best[i] < 0) {
+                cout << setw(10) << "-";
+            }
+            else {
+                cout << setw(10) << best[i];
+            }
+        }
+
+        cout << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* *** *** *** *** *** *** *** Render z sort *** *** *** *** *** *** *** *** *** *** */
+
+// Render request stand-in holding only the sort data
+struct cBenchmark_Z_Request {
+    float m_pos_z;
+};
+
+struct cBenchmark_Zpos_Sort {
+    bool operator()(const cBenchmark_Z_Request* a, const cBenchmark_Z_Request* b) const
+    {
+        return a->m_pos_z < b->m_pos_z;
+    }
+};
+
+static int Benchmark_Zsort(void)
+{
+    const unsigned int counts[] = {1000, 5000, 10000, 20000};
+    const unsigned int count_amount = sizeof(counts) / sizeof(counts[0]);
+    const unsigned int runs = 20;
+    // massive type base z positions
+    const float base_z[] = {0.01f, 0.04f, 0.08f, 0.12f, 0.0799f};
+
+    cout << "Render z sort benchmark (best of " << runs << " frames in ms)" << endl;
+    cout << setw(10) << left << "requests" << setw(12) << right << "std::sort" << setw(12) << "radix" << setw(12) << "sorted" << endl;
+
+    for (unsigned int c = 0; c < count_amount; c++) {
+        const unsigned int count = counts[c];
+
+        // sprites submit in level order with layered z positions like cSprite_Manager::Ensure_Different_Z
+        vector<cBenchmark_Z_Request> requests(count);
+
+        for (unsigned int i = 0; i < count; i++) {
+            requests[i].m_pos_z = base_z[rand() % 5] + static_cast<float>(i) * 0.000001f;
+        }
+
+        vector<cBenchmark_Z_Request*> submitted(count);
+
+        for (unsigned int i = 0; i < count; i++) {
+            submitted[i] = &requests[i];
+        }
+
+        vector<cBenchmark_Z_Request*> render_data;
+        cRadix_Sorter<cBenchmark_Z_Request*> sorter;
+        // std::sort, radix, radix on an already sorted queue
+        double best[3] = {-1, -1, -1};
+
+        for (unsigned int run = 0; run < runs; run++) {
+            render_data = submitted;
+            cBenchmark_Timer timer;
+            std::sort(render_data.begin(), render_data.end(), cBenchmark_Zpos_Sort());
+
+            double elapsed = timer.Get_Elapsed_Ms();
+            if (best[0] < 0 || elapsed < best[0]) {
+                best[0] = elapsed;
+            }
+
+            // the key building is part of the frame cost
+            for (unsigned int pass = 1; pass < 3; pass++) {
+                if (pass == 1) {
+                    render_data = submitted;
+                }
+
+                timer.Reset();
+                sorter.Clear();
+
+                for (vector<cBenchmark_Z_Request*>::const_iterator itr = render_data.begin(); itr != render_data.end(); ++itr) {
+                    sorter.Add_Key(Float_To_Sort_Key((*itr)->m_pos_z));
+                }
+
+                sorter.Sort(render_data);
+
+                elapsed = timer.Get_Elapsed_Ms();
+                if (best[pass] < 0 || elapsed < best[pass]) {
+                    best[pass] = elapsed;
+                }
+            }
+        }
+
+        // verify the order
+        for (unsigned int i = 1; i < count; i++) {
+            if (render_data[i - 1]->m_pos_z > render_data[i]->m_pos_z) {
+                cerr << "Error : radix sort order is wrong" << endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        cout << setw(10) << left << count << right << fixed << setprecision(3) << setw(12) << best[0] << setw(12) << best[1] << setw(12) << best[2] << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* *** *** *** *** *** *** *** Scripting event dispatch *** *** *** *** *** *** *** *** *** *** */
+
+// Scriptable object using the previous string keyed handler table
+class cBenchmark_Legacy_Scriptable {
+public:
+    void register_event_handler(const std::string& evtname, mrb_value callback)
+    {
+        m_callbacks[evtname].push_back(callback);
+    }
+
+    std::map<std::string, std::vector<mrb_value> > m_callbacks;
+};
+
+static int Benchmark_Events(void)
+{
+    const unsigned int sprite_count = 2000;
+    // collisions of each sprite per frame
+    const unsigned int collisions = 4;
+    const unsigned int frames = 50;
+
+    cout << "Scripting event dispatch benchmark (" << sprite_count << " sprites, " << collisions << " collisions each, " << frames << " frames in ms)" << endl;
+    cout << "Only the handler lookup of cEvent::Fire is measured, no mruby code runs." << endl;
+    cout << setw(28) << left << "level" << setw(12) << right << "legacy" << setw(12) << "interned" << endl;
+
+    for (unsigned int scripted = 0; scripted < 2; scripted++) {
+        vector<cBenchmark_Legacy_Scriptable> legacy_objects(sprite_count);
+        vector<Scripting::cScriptable_Object> objects(sprite_count);
+
+        // scripted levels register jump handlers on some and touch handlers on few sprites
+        if (scripted) {
+            for (unsigned int i = 0; i < sprite_count; i++) {
+                const char* evtname = NULL;
+
+                if (i % 100 == 0) {
+                    evtname = "touch";
+                }
+                else if (i % 10 == 0) {
+                    evtname = "jump";
+                }
+
+                if (evtname) {
+                    legacy_objects[i].register_event_handler(evtname, mrb_nil_value());
+                    objects[i].register_event_handler(evtname, mrb_nil_value());
+                }
+            }
+        }
+
+        // handlers found to avoid optimizing the lookups away
+        unsigned int found[2] = {0, 0};
+        cBenchmark_Timer timer;
+
+        for (unsigned int frame = 0; frame < frames; frame++) {
+            for (unsigned int i = 0; i < sprite_count; i++) {
+                for (unsigned int c = 0; c < collisions; c++) {
+                    Scripting::cTouch_Event evt(NULL);
+                    std::string evtname = evt.Event_Name();
+                    std::vector<mrb_value>::iterator start = legacy_objects[i].m_callbacks[evtname].begin();
+                    std::vector<mrb_value>::iterator end = legacy_objects[i].m_callbacks[evtname].end();
+
+                    found[0] += end - start;
+                }
+            }
+        }
+
+        const double legacy_time = timer.Get_Elapsed_Ms();
+        timer.Reset();
+
+        for (unsigned int frame = 0; frame < frames; frame++) {
+            for (unsigned int i = 0; i < sprite_count; i++) {
+                for (unsigned int c = 0; c < collisions; c++) {
+                    Scripting::cTouch_Event evt(NULL);
+                    Scripting::cScriptable_Object& obj = objects[i];
+
+                    if (!obj.has_event_handlers()) {
+                        continue;
+                    }
+
+                    const unsigned int evtid = evt.Event_ID();
+
+                    if (!obj.has_event_handler(evtid)) {
+                        continue;
+                    }
+
+                    found[1] += obj.event_handlers_end(evtid) - obj.event_handlers_begin(evtid);
+                }
+            }
+        }
+
+        const double interned_time = timer.Get_Elapsed_Ms();
+
+        if (found[0] != found[1]) {
+            cerr << "Error : found " << found[0] << " legacy and " << found[1] << " interned handlers" << endl;
+            return EXIT_FAILURE;
+        }
+
+        cout << setw(28) << left << (scripted ? "with scripts" : "without scripts") << right << fixed << setprecision(3) << setw(12) << legacy_time << setw(12) << interned_time << endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* *** *** *** *** *** *** *** Benchmarks *** *** *** *** *** *** *** *** *** *** */
+
+int Run_Benchmark(const std::string& name)
+{
+    if (name == "resample") {
+        return Benchmark_Resample();
+    }
+    else if (name == "zsort") {
+        return Benchmark_Zsort();
+    }
+    else if (name == "events") {
+        return Benchmark_Events();
+    }
+
+    cerr << "Unknown benchmark " << name << endl;
+    Print_Benchmarks();
+    return EXIT_FAILURE;
+}
+
+void Print_Benchmarks(void)
+{
+    cout << "Available benchmarks :" << endl;
+    cout << "resample\tImage downscaling used for textures and the image cache" << endl;
+    cout << "zsort\t\tRender queue z position sorting" << endl;
+    cout << "events\t\tScripting event handler lookup on collisions" << endl;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,53 @@
+/***************************************************************************
+ * benchmark.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_BENCHMARK_HPP
+#define SMC_BENCHMARK_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** Benchmark timer *** *** *** *** *** *** *** *** *** *** */
+
+    // Measures the wall time of a benchmark section
+    class cBenchmark_Timer {
+    public:
+        cBenchmark_Timer(void);
+
+        // restart measuring
+        void Reset(void);
+        // Return the elapsed milliseconds since creation or the last reset
+        double Get_Elapsed_Ms(void) const;
+
+        boost::chrono::high_resolution_clock::time_point m_start;
+    };
+
+    /* *** *** *** *** *** *** *** Benchmarks *** *** *** *** *** *** *** *** *** *** */
+
+    /* Run the benchmark with the given name and print the results to stdout
+     * Benchmarks only use the engine parts they measure and do not need an initialized game.
+     * returns the program exit code
+    */
+    int Run_Benchmark(const std::string& name);
+
+    // Print the available benchmark names
+    void Print_Benchmarks(void);
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -0,0 +1,322 @@
+/***************************************************************************
+ * collision_broad_phase.cpp  -  parallel detection of collision candidates
+ *
+ * Copyright © 2005 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/collision_broad_phase.hpp"
+#include "../core/sprite_manager.hpp"
+#include "../core/math/utilities.hpp"
+
+using namespace std;
+
+namespace SMC {
+
+/* *** *** *** *** *** *** *** cCollision_Broad_Phase *** *** *** *** *** *** *** *** *** *** */
+
+Collision_Detection_Mode cCollision_Broad_Phase::m_mode = COLLISION_DETECTION_THREADED;
+
+// space an object may move without leaving its snapshot rect
+static const float broad_phase_margin = 2.0f;
+// moving sprites detected at once by a thread
+static const unsigned int broad_phase_chunk_size = 16;
+// rect checks below this are detected without the worker threads
+static const unsigned int broad_phase_min_threaded_checks = 20000;
+
+// Return true if the rect is inside the box
+static inline bool Broad_Phase_Contains(const GL_rect& box, const GL_rect& rect)
+{
+    return rect.m_x >= box.m_x && rect.m_y >= box.m_y && rect.m_x + rect.m_w <= box.m_x + box.m_w && rect.m_y + rect.m_h <= box.m_y + box.m_h;
+}
+
+cCollision_Broad_Phase::cCollision_Broad_Phase(void)
+    : m_next_mover(0)
+{
+    m_stamp = 0;
+    m_active = 0;
+    m_objects = NULL;
+    m_change_count = 0;
+
+    m_worker_count = 0;
+    m_work_generation = 0;
+    m_workers_busy = 0;
+    m_workers_quit = 0;
+}
+
+cCollision_Broad_Phase::~cCollision_Broad_Phase(void)
+{
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_workers_quit = 1;
+    }
+
+    m_work_cond.notify_all();
+    m_workers.join_all();
+}
+
+void cCollision_Broad_Phase::Begin(const vector<cSprite*>& objects)
+{
+    m_active = 0;
+
+    if (m_mode == COLLISION_DETECTION_SERIAL || objects.empty()) {
+        return;
+    }
+
+    m_stamp++;
+    m_objects = &objects;
+    m_change_count = cSprite_Manager::m_change_count;
+
+    const unsigned int count = objects.size();
+    m_boxes.resize(count);
+    m_escaped_objects.assign(count, 0);
+    m_escaped.clear();
+    m_movers.clear();
+    m_mover_rects.clear();
+
+    // snapshot
+    for (unsigned int i = 0; i < count; i++) {
+        cSprite* obj = objects[i];
+        GL_rect& box = m_boxes[i];
+
+        obj->m_broad_phase_stamp = m_stamp;
+        obj->m_broad_phase_num = i;
+        obj->m_broad_phase_mover = -1;
+
+        if (obj->Get_Collide_Move_Rect(box)) {
+            obj->m_broad_phase_mover = m_movers.size();
+            m_movers.push_back(i);
+        }
+        else {
+            box = obj->m_col_rect;
+        }
+
+        box.m_x -= broad_phase_margin;
+        box.m_y -= broad_phase_margin;
+        box.m_w += broad_phase_margin * 2.0f;
+        box.m_h += broad_phase_margin * 2.0f;
+
+        if (obj->m_broad_phase_mover >= 0) {
+            m_mover_rects.push_back(box);
+        }
+    }
+
+    if (m_candidates.size() < m_movers.size()) {
+        m_candidates.resize(m_movers.size());
+    }
+
+    m_next_mover = 0;
+
+    // detect
+    if (m_movers.size() * count < broad_phase_min_threaded_checks) {
+        Detect(0, m_movers.size());
+    }
+    else {
+        Start_Workers();
+
+        {
+            boost::lock_guard<boost::mutex> lock(m_mutex);
+            m_workers_busy = m_worker_count;
+            m_work_generation++;
+        }
+
+        m_work_cond.notify_all();
+        // help the workers
+        Detect_Movers();
+
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+
+        while (m_workers_busy) {
+            m_done_cond.wait(lock);
+        }
+    }
+
+    m_active = 1;
+}
+
+void cCollision_Broad_Phase::End(void)
+{
+    m_active = 0;
+    m_objects = NULL;
+}
+
+bool cCollision_Broad_Phase::Get_Colliding_Objects(vector<cSprite*>& col_objects, const GL_rect& rect, const cSprite* sprite) const
+{
+    // objects were added or deleted
+    if (!m_active || m_change_count != cSprite_Manager::m_change_count) {
+        return 0;
+    }
+
+    // not a moving sprite of the snapshot
+    if (!sprite || sprite->m_broad_phase_stamp != m_stamp || sprite->m_broad_phase_mover < 0) {
+        return 0;
+    }
+
+    // moves outside of the predicted rect
+    if (!Broad_Phase_Contains(m_mover_rects[sprite->m_broad_phase_mover], rect)) {
+        return 0;
+    }
+
+    const vector<cSprite*>& objects = *m_objects;
+    const vector<unsigned int>& candidates = m_candidates[sprite->m_broad_phase_mover];
+    const size_t start_size = col_objects.size();
+
+    // merge the candidates and the escaped objects in array order
+    vector<unsigned int>::const_iterator itr = candidates.begin();
+    vector<unsigned int>::const_iterator escaped_itr = m_escaped.begin();
+    unsigned int last_num = objects.size();
+
+    while (itr != candidates.end() || escaped_itr != m_escaped.end()) {
+        unsigned int num;
+
+        if (escaped_itr == m_escaped.end() || (itr != candidates.end() && *itr <= *escaped_itr)) {
+            num = *itr;
+            ++itr;
+        }
+        else {
+            num = *escaped_itr;
+            ++escaped_itr;
+        }
+
+        // also escaped
+        if (num == last_num || num == sprite->m_broad_phase_num) {
+            continue;
+        }
+
+        last_num = num;
+        cSprite* obj = objects[num];
+
+        // if destroyed object or rects don't touch
+        if (obj->m_auto_destroy || !rect.Intersects(obj->m_col_rect)) {
+            continue;
+        }
+
+        col_objects.push_back(obj);
+    }
+
+    if (m_mode == COLLISION_DETECTION_COMPARE) {
+        vector<cSprite*> serial_objects;
+
+        for (vector<cSprite*>::const_iterator obj_itr = objects.begin(); obj_itr != objects.end(); ++obj_itr) {
+            cSprite* obj = (*obj_itr);
+
+            if (obj == sprite || obj->m_auto_destroy || !rect.Intersects(obj->m_col_rect)) {
+                continue;
+            }
+
+            serial_objects.push_back(obj);
+        }
+
+        if (serial_objects.size() != col_objects.size() - start_size || !equal(serial_objects.begin(), serial_objects.end(), col_objects.begin() + start_size)) {
+            cerr << "Warning : Collision candidates of " << sprite->Create_Name() << " differ from the serial check (" << (col_objects.size() - start_size) << " instead of " << serial_objects.size() << ")" << endl;
+
+            col_objects.resize(start_size);
+            col_objects.insert(col_objects.end(), serial_objects.begin(), serial_objects.end());
+        }
+    }
+
+    return 1;
+}
+
+void cCollision_Broad_Phase::Col_Rect_Changed(const cSprite* sprite)
+{
+    const unsigned int num = sprite->m_broad_phase_num;
+
+    if (num >= m_escaped_objects.size() || m_escaped_objects[num] || Broad_Phase_Contains(m_boxes[num], sprite->m_col_rect)) {
+        return;
+    }
+
+    m_escaped_objects[num] = 1;
+    m_escaped.insert(upper_bound(m_escaped.begin(), m_escaped.end(), num), num);
+}
+
+void cCollision_Broad_Phase::Detect_Movers(void)
+{
+    const unsigned int mover_count = m_movers.size();
+
+    while (1) {
+        const unsigned int start = m_next_mover.fetch_add(broad_phase_chunk_size);
+
+        if (start >= mover_count) {
+            break;
+        }
+
+        Detect(start, min(start + broad_phase_chunk_size, mover_count));
+    }
+}
+
+void cCollision_Broad_Phase::Detect(unsigned int mover_start, unsigned int mover_end)
+{
+    const unsigned int count = m_boxes.size();
+
+    for (unsigned int mover = mover_start; mover < mover_end; mover++) {
+        const GL_rect& rect = m_mover_rects[mover];
+        const unsigned int mover_num = m_movers[mover];
+        vector<unsigned int>& candidates = m_candidates[mover];
+        candidates.clear();
+
+        for (unsigned int i = 0; i < count; i++) {
+            if (i != mover_num && rect.Intersects(m_boxes[i])) {
+                candidates.push_back(i);
+            }
+        }
+    }
+}
+
+void cCollision_Broad_Phase::Start_Workers(void)
+{
+    if (m_worker_count) {
+        return;
+    }
+
+    // the calling thread also detects
+    m_worker_count = Clamp<unsigned int>(boost::thread::hardware_concurrency(), 2, 8) - 1;
+
+    for (unsigned int i = 0; i < m_worker_count; i++) {
+        m_workers.add_thread(new boost::thread(&cCollision_Broad_Phase::Worker_Thread, this));
+    }
+}
+
+void cCollision_Broad_Phase::Worker_Thread(void)
+{
+    Uint32 generation = 0;
+
+    while (1) {
+        {
+            boost::unique_lock<boost::mutex> lock(m_mutex);
+
+            while (!m_workers_quit && m_work_generation == generation) {
+                m_work_cond.wait(lock);
+            }
+
+            if (m_workers_quit) {
+                return;
+            }
+
+            generation = m_work_generation;
+        }
+
+        Detect_Movers();
+
+        {
+            boost::lock_guard<boost::mutex> lock(m_mutex);
+            m_workers_busy--;
+
+            if (!m_workers_busy) {
+                m_done_cond.notify_one();
+            }
+        }
+    }
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,132 @@
+/***************************************************************************
+ * collision_broad_phase.h
+ *
+ * Copyright © 2005 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_COLLISION_BROAD_PHASE_HPP
+#define SMC_COLLISION_BROAD_PHASE_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+#include "../core/math/rect.hpp"
+
+#include <boost/atomic.hpp>
+
+namespace SMC {
+
+    class cSprite;
+
+    /* *** *** *** *** *** *** *** Collision detection modes *** *** *** *** *** *** *** *** *** *** */
+
+    enum Collision_Detection_Mode {
+        // check all objects for every move
+        COLLISION_DETECTION_SERIAL = 0,
+        // use the candidates detected by the worker threads
+        COLLISION_DETECTION_THREADED = 1,
+        // use the candidates and warn if they differ from the serial check
+        COLLISION_DETECTION_COMPARE = 2
+    };
+
+    /* *** *** *** *** *** *** *** cCollision_Broad_Phase *** *** *** *** *** *** *** *** *** *** */
+
+    /* Detects the collision candidates of the moving sprites in parallel
+     * Begin() takes a snapshot of the collision rects and the rects the sprites move into
+     * with Collide_Move(). The worker threads then gather the objects each moving sprite
+     * can touch. The collisions are still resolved serially in the same order and
+     * Get_Colliding_Objects() filters the candidates with the current collision rects.
+     * Objects moving out of their snapshot rect and moving sprites leaving their
+     * predicted rect are checked like before which keeps the results identical to the
+     * serial check. Adding or deleting objects ends the use of the candidates.
+    */
+    class cCollision_Broad_Phase {
+    public:
+        cCollision_Broad_Phase(void);
+        ~cCollision_Broad_Phase(void);
+
+        /* Take the snapshot and detect the candidates
+         * objects : the sprite manager objects which must not change until End()
+        */
+        void Begin(const vector<cSprite*>& objects);
+        // Stop using the candidates
+        void End(void);
+
+        /* Add the objects colliding with the rect of the moving sprite in array order
+         * returns false if the candidates are not usable and all objects need to be checked
+        */
+        bool Get_Colliding_Objects(vector<cSprite*>& col_objects, const GL_rect& rect, const cSprite* sprite) const;
+
+        // Check if the changed collision rect of the sprite left its snapshot rect
+        void Col_Rect_Changed(const cSprite* sprite);
+
+        // if the candidates can be used
+        inline bool Is_Active(void) const
+        {
+            return m_active;
+        };
+
+        // the detection mode of all sprite managers
+        static Collision_Detection_Mode m_mode;
+
+        // Begin() count identifying the snapshot of a sprite
+        Uint32 m_stamp;
+
+    private:
+        // Detect the candidates of the moving sprites until all are done
+        void Detect_Movers(void);
+        // Detect the candidates of the given moving sprites
+        void Detect(unsigned int mover_start, unsigned int mover_end);
+        // Start the worker threads if not running
+        void Start_Workers(void);
+        // worker thread
+        void Worker_Thread(void);
+
+        // candidates can be used
+        bool m_active;
+        // objects of the snapshot
+        const vector<cSprite*>* m_objects;
+        // cSprite_Manager::m_change_count of the snapshot
+        Uint32 m_change_count;
+
+        // snapshot collision rect of each object including its predicted movement
+        vector<GL_rect> m_boxes;
+        // object numbers of the moving sprites
+        vector<unsigned int> m_movers;
+        // predicted Col_Move() check rect of each moving sprite
+        vector<GL_rect> m_mover_rects;
+        // object numbers each moving sprite can touch in array order
+        vector<vector<unsigned int> > m_candidates;
+        // sorted object numbers which left their snapshot rect
+        vector<unsigned int> m_escaped;
+        vector<Uint8> m_escaped_objects;
+
+        // next moving sprite to detect
+        boost::atomic<unsigned int> m_next_mover;
+
+        // worker threads
+        boost::thread_group m_workers;
+        unsigned int m_worker_count;
+        boost::mutex m_mutex;
+        boost::condition_variable m_work_cond;
+        boost::condition_variable m_done_cond;
+        // incremented for each detection run
+        Uint32 m_work_generation;
+        // workers still detecting
+        unsigned int m_workers_busy;
+        bool m_workers_quit;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -43,6 +43,9 @@ namespace fs = boost::filesystem;
 
 namespace SMC {
 
+// item images loaded in the background per frame
+static const unsigned int editor_item_background_loads = 2;
+
 /* *** *** *** *** *** *** *** cEditor_Object_Settings_Item *** *** *** *** *** *** *** *** *** *** */
 
 cEditor_Object_Settings_Item::cEditor_Object_Settings_Item(void)
@@ -99,6 +102,8 @@ cEditor_Item_Object::cEditor_Item_Object(const std::string& text, const CEGUI::L
     m_image = NULL;
     sprite_obj = NULL;
     preview_scale = 1;
+    m_loaded = 0;
+    m_sprite_manager = NULL;
 }
 
 cEditor_Item_Object::~cEditor_Item_Object(void)
@@ -118,8 +123,8 @@ cEditor_Item_Object::~cEditor_Item_Object(void)
 
 void cEditor_Item_Object::Init(cSprite* sprite)
 {
-    if (m_image) {
-        cerr << "cEditor_Item_Object::Init: Warning: Image is already set" << endl;
+    if (sprite_obj) {
+        cerr << "cEditor_Item_Object::Init: Warning: Sprite is already set" << endl;
         return;
     }
 
@@ -130,9 +135,47 @@ void cEditor_Item_Object::Init(cSprite* sprite)
 
     // CEGUI settings
     list_text->setTextColours(Get_Massive_Type_Color(sprite_obj->m_massive_type).Get_cegui_Color());
+}
 
-    if (!sprite_obj->m_start_image || !pPreferences->m_editor_show_item_images) {
-        return;
+void cEditor_Item_Object::Init_Image(const fs::path& image_filename, MassiveType massive_type, cSprite_Manager* sprite_manager)
+{
+    m_image_filename = image_filename;
+    m_sprite_manager = sprite_manager;
+
+    // CEGUI settings
+    list_text->setTextColours(Get_Massive_Type_Color(massive_type).Get_cegui_Color());
+}
+
+bool cEditor_Item_Object::Load(void)
+{
+    if (m_loaded) {
+        return sprite_obj != NULL;
+    }
+
+    m_loaded = 1;
+
+    // create sprite from the image
+    if (!sprite_obj && !m_image_filename.empty()) {
+        cGL_Surface* image = pVideo->Get_Surface(m_image_filename);
+
+        if (!image) {
+            cerr << "Warning : Could not load editor sprite image base : " << path_to_utf8(m_image_filename) << endl;
+            return 0;
+        }
+
+        cSprite* new_sprite = new cSprite(m_sprite_manager);
+        new_sprite->Set_Image(image);
+        // default massivetype
+        new_sprite->Set_Massive_Type(static_cast<MassiveType>(image->m_massive_type));
+        Init(new_sprite);
+    }
+
+    if (!sprite_obj) {
+        return 0;
+    }
+
+    if (m_image || !sprite_obj->m_start_image || !pPreferences->m_editor_show_item_images) {
+        return 1;
     }
 
     // get scale
@@ -140,9 +183,13 @@ void cEditor_Item_Object::Init(cSprite* sprite)
 
     // create CEGUI link
     cEditor_CEGUI_Texture* texture = new cEditor_CEGUI_Texture(*pGuiRenderer, sprite_obj->m_start_image->m_image, CEGUI::Size(sprite_obj->m_start_image->m_tex_w, sprite_obj->m_start_image->m_tex_h));
-    CEGUI::String imageset_name = "editor_item " + list_text->getText() + " " + CEGUI::PropertyHelper::uintToString(m_parent->getItemCount());
+    // items are loaded in any order
+    static unsigned int imageset_count = 0;
+    CEGUI::String imageset_name = "editor_item " + list_text->getText() + " " + CEGUI::PropertyHelper::uintToString(imageset_count++);
     m_image = &CEGUI::ImagesetManager::getSingleton().create(imageset_name, *texture);
     m_image->defineImage("default", CEGUI::Point(0, 0), texture->getSize(), CEGUI::Point(0, 0));
+
+    return 1;
 }
 
 CEGUI::Size cEditor_Item_Object::getPixelSize(void) const
@@ -199,6 +246,9 @@ cEditor::cEditor(cSprite_Manager* sprite_manager)
     m_listbox_menu = NULL;
     m_listbox_items = NULL;
     m_tabcontrol_menu = NULL;
+    m_item_load_pos = 0;
+
+    m_journal.Set_Sprite_Manager(sprite_manager);
 }
 
 cEditor::~cEditor(void)
@@ -274,12 +324,8 @@ void cEditor::Unload(void)
 
     m_tagged_item_objects.clear();
 
-    // Tagged Image Settings
-    for (TaggedItemImageSettingsList::iterator itr = m_tagged_item_images.begin(); itr != m_tagged_item_images.end(); ++itr) {
-        delete *itr;
-    }
-
-    m_tagged_item_images.clear();
+    // Tagged Images
+    m_item_index.Clear();
 }
 
 void cEditor::Toggle(void)
@@ -322,6 +368,9 @@ void cEditor::Enable(void)
 
     pActive_Camera->Update_Position();
     m_enabled = 1;
+
+    // rects changed outside of the editor
+    cSprite::m_editor_rect_change_count++;
 }
 
 void cEditor::Disable(bool native_mode /* = 1 */)
@@ -331,6 +380,7 @@ void cEditor::Disable(bool native_mode /* = 1 */)
         return;
     }
 
+    m_journal.Commit();
     Unload();
 
     m_enabled = 0;
@@ -409,6 +459,8 @@ void cEditor::Update(void)
         }
     }
 
+    Update_Item_Images();
+
     pMouseCursor->Editor_Update();
 }
 
@@ -551,10 +603,22 @@ bool cEditor::Key_Down(SDLKey key)
         return 0;
     }
 
+    // every key starts a new journal step
+    m_journal.Commit();
+    Watch_Selected_Objects();
+
     // New level
     if (key == SDLK_n && pKeyboard->Is_Ctrl_Down()) {
         Function_New();
     }
+    // Redo
+    else if ((key == SDLK_z && pKeyboard->Is_Ctrl_Down() && pKeyboard->Is_Shift_Down()) || (key == SDLK_y && pKeyboard->Is_Ctrl_Down())) {
+        Redo();
+    }
+    // Undo
+    else if (key == SDLK_z && pKeyboard->Is_Ctrl_Down()) {
+        Undo();
+    }
     // Save
     else if (key == SDLK_s && pKeyboard->Is_Ctrl_Down()) {
         Function_Save();
@@ -600,6 +664,8 @@ bool cEditor::Key_Down(SDLKey key)
                                "Ctrl + W - Load an Overworld\n"
                                "Ctrl + S - Save the current Level/World\n"
                                "Ctrl + Shift + S - Save the current Level/World under a new name\n"
+                               "Ctrl + Z - Undo the last change\n"
+                               "Ctrl + Y or Ctrl + Shift + Z - Redo the last undone change\n"
                                "Ctrl + D - Toggle debug mode\n"
                                "Ctrl + P - Toggle performance mode\n"
                                " \n"
@@ -810,9 +876,14 @@ bool cEditor::Mouse_Down(Uint8 button)
         return 0;
     }
 
+    // every click starts a new journal step
+    m_journal.Commit();
+
     // left
     if (button == SDL_BUTTON_LEFT) {
         pMouseCursor->Left_Click_Down();
+        // the dragged objects
+        Watch_Selected_Objects();
 
         // auto hide if enabled
         if (pMouseCursor->m_hovering_object->m_obj && pPreferences->m_editor_mouse_auto_hide) {
@@ -863,6 +934,11 @@ bool cEditor::Mouse_Up(Uint8 button)
 
         pMouseCursor->End_Selection();
 
+        // dragging finished
+        m_journal.Commit();
+        // settings of the active object
+        m_journal.Watch(pMouseCursor->m_active_object);
+
         if (pMouseCursor->m_hovering_object->m_obj) {
             for (SelectedObjectList::iterator itr = pMouseCursor->m_selected_objects.begin(); itr != pMouseCursor->m_selected_objects.end(); ++itr) {
                 cSelectedObject* object = (*itr);
@@ -891,6 +967,7 @@ bool cEditor::Mouse_Up(Uint8 button)
 void cEditor::Set_Sprite_Manager(cSprite_Manager* sprite_manager)
 {
     m_sprite_manager = sprite_manager;
+    m_journal.Set_Sprite_Manager(sprite_manager);
 }
 
 void cEditor::Add_Menu_Object(const std::string& name, std::string tags, CEGUI::colour normal_color /* = CEGUI::colour( 1, 1, 1 ) */)
@@ -992,40 +1069,16 @@ bool cEditor::Load_Item_Menu(std::string item_tags)
         item_tags.erase(0, pos + 1);
     }
 
-    unsigned int tag_pos = 0;
-
     // Get all Images with the Tags
-    for (TaggedItemImageSettingsList::const_iterator itr = m_tagged_item_images.begin(); itr != m_tagged_item_images.end(); ++itr) {
-        const cImage_Settings_Data* settings = (*itr);
+    vector<unsigned int> image_items;
+    m_item_index.Query(array_tags, image_items);
 
-        // search
-        while (Is_Tag_Available(settings->m_editor_tags, array_tags[tag_pos])) {
-            tag_pos++;
-
-            // found all tags
-            if (tag_pos >= array_tags.size()) {
-                cGL_Surface* image = pVideo->Get_Surface(settings->m_base);
-
-                if (!image) {
-                    cerr << "Warning : Could not load editor sprite image base : " << settings->m_base.c_str() << endl;
-                    break;
-                }
-
-                // Create sprite
-                cSprite* new_sprite = new cSprite(m_sprite_manager);
-                new_sprite->Set_Image(image);
-                // default massivetype
-                new_sprite->Set_Massive_Type(static_cast<MassiveType>(image->m_massive_type));
-                // Add new Sprite
-                Add_Item_Object(new_sprite);
-
-                break;
-            }
-        }
-
-        tag_pos = 0;
+    for (vector<unsigned int>::const_iterator itr = image_items.begin(); itr != image_items.end(); ++itr) {
+        Add_Image_Item(m_item_index.Get_Item(*itr));
     }
 
+    unsigned int tag_pos = 0;
+
     // Get all Objects with the Tags
     for (TaggedItemObjectsList::const_iterator itr = m_tagged_item_objects.begin(); itr != m_tagged_item_objects.end(); ++itr) {
         cSprite* object = (*itr);
@@ -1060,6 +1113,8 @@ void cEditor::Unload_Item_Menu(void)
     if (m_listbox_items) {
         m_listbox_items->resetList();
     }
+
+    m_item_load_pos = 0;
 }
 
 
@@ -1131,29 +1186,69 @@ void cEditor::Add_Item_Object(cSprite* sprite, std::string new_name /* = "" */,
     m_listbox_items->addItem(new_item);
 }
 
+void cEditor::Add_Image_Item(const cEditor_Item_Index::cItem& item)
+{
+    cEditor_Item_Object* new_item = new cEditor_Item_Object(item.m_name, m_listbox_items);
+    // Initialize
+    new_item->Init_Image(item.m_filename, item.m_massive_type, m_sprite_manager);
+
+    // Add Item
+    m_listbox_items->addItem(new_item);
+}
+
 void cEditor::Load_Image_Items(fs::path dir)
 {
-    vector<fs::path> image_files = Get_Directory_Files(dir, ".settings");
-
-    // load all available objects
-    for (vector<fs::path>::const_iterator itr = image_files.begin(); itr != image_files.end(); ++itr) {
-        // get filename
-        fs::path filename = (*itr);
-
-        // load settings
-        cImage_Settings_Data* settings = pSettingsParser->Get(filename);
-
-        // if settings are available
-        if (settings) {
-            // if required editor tag is available
-            if (settings->m_editor_tags.find(m_editor_item_tag) != std::string::npos) {
-                // set base to the filename
-                settings->m_base = filename;
-                // add real image
-                m_tagged_item_images.push_back(settings);
-            }
+    m_item_index.Build(dir, m_editor_item_tag, pResource_Manager->Get_User_Cache_Directory() / utf8_to_path("editor_items.cache"));
+}
+
+void cEditor::Update_Item_Images(void)
+{
+    if (!pPreferences->m_editor_show_item_images || !m_listbox_items->isVisible(1)) {
+        return;
+    }
+
+    const size_t count = m_listbox_items->getItemCount();
+
+    if (m_item_load_pos >= count) {
+        return;
+    }
+
+    bool loaded = 0;
+
+    // visible area
+    const float top = m_listbox_items->getVertScrollbar()->getScrollPosition();
+    const float bottom = top + m_listbox_items->getListRenderArea().getHeight();
+    float pos = 0.0f;
+
+    for (size_t i = 0; i < count && pos < bottom; i++) {
+        cEditor_Item_Object* item = static_cast<cEditor_Item_Object*>(m_listbox_items->getListboxItemFromIndex(i));
+        const float height = item->getPixelSize().d_height;
+
+        if (pos + height > top && !item->m_loaded) {
+            item->Load();
+            loaded = 1;
+        }
+
+        pos += height;
+    }
+
+    // the others in the background
+    unsigned int background_loads = editor_item_background_loads;
+
+    while (m_item_load_pos < count && background_loads) {
+        cEditor_Item_Object* item = static_cast<cEditor_Item_Object*>(m_listbox_items->getListboxItemFromIndex(m_item_load_pos));
+        m_item_load_pos++;
+
+        if (!item->m_loaded) {
+            item->Load();
+            loaded = 1;
+            background_loads--;
         }
     }
+
+    if (loaded) {
+        m_listbox_items->invalidate();
+    }
 }
 
 void cEditor::Activate_Item(cEditor_Item_Object* entry)
@@ -1162,6 +1257,11 @@ void cEditor::Activate_Item(cEditor_Item_Object* entry)
     if (!entry)
         throw(EditorError("Invalid Editor Item!"));
 
+    // image could not be loaded
+    if (!entry->Load()) {
+        return;
+    }
+
     // create copy from editor item
     cSprite* new_sprite = entry->sprite_obj->Copy();
 
@@ -1180,6 +1280,7 @@ void cEditor::Activate_Item(cEditor_Item_Object* entry)
 
     // add item
     m_sprite_manager->Add(new_sprite);
+    m_journal.Record_Add(new_sprite);
 
     // Set mouse objects
     pMouseCursor->m_left = 1;
@@ -1426,6 +1527,41 @@ void cEditor::Replace_Sprites(void)
     }
 }
 
+void cEditor::Watch_Selected_Objects(void)
+{
+    for (SelectedObjectList::iterator itr = pMouseCursor->m_selected_objects.begin(); itr != pMouseCursor->m_selected_objects.end(); ++itr) {
+        m_journal.Watch((*itr)->m_obj);
+    }
+
+    m_journal.Watch(pMouseCursor->m_active_object);
+}
+
+void cEditor::Undo(void)
+{
+    // the changed objects get replaced
+    pMouseCursor->Reset(0);
+
+    if (!m_journal.Undo()) {
+        pHud_Debug->Set_Text(_("Nothing to undo"));
+        return;
+    }
+
+    pHud_Debug->Set_Text(_("Undone"));
+}
+
+void cEditor::Redo(void)
+{
+    // the changed objects get replaced
+    pMouseCursor->Reset(0);
+
+    if (!m_journal.Redo()) {
+        pHud_Debug->Set_Text(_("Nothing to redo"));
+        return;
+    }
+
+    pHud_Debug->Set_Text(_("Redone"));
+}
+
 bool cEditor::Is_Tag_Available(const std::string& str, const std::string& tag, unsigned int search_pos /* = 0 */)
 {
     // found tag position
@@ -20,6 +20,8 @@
 #include "../../objects/sprite.hpp"
 #include "../../gui/hud.hpp"
 #include "../../video/img_settings.hpp"
+#include "editor_item_index.hpp"
+#include "editor_journal.hpp"
 
 namespace SMC {
 
@@ -56,8 +58,16 @@ namespace SMC {
         cEditor_Item_Object(const std::string& text, const CEGUI::Listbox* parent);
         virtual ~cEditor_Item_Object(void);
 
-        // Initialize
+        // Initialize with the sprite
         void Init(cSprite* sprite);
+        /* Initialize with an image which is loaded on the first Load()
+         * massive_type : text color until loaded
+        */
+        void Init_Image(const boost::filesystem::path& image_filename, MassiveType massive_type, cSprite_Manager* sprite_manager);
+        /* Create the sprite if not yet done and the preview image
+         * returns true if the sprite is available
+        */
+        bool Load(void);
 
         // overridden from base class
         virtual CEGUI::Size getPixelSize(void) const;
@@ -70,10 +80,15 @@ namespace SMC {
         CEGUI::ListboxTextItem* list_text;
         // cegui image
         CEGUI::Imageset* m_image;
-        // sprite
+        // sprite or NULL if not yet loaded
         cSprite* sprite_obj;
         // preview image scale
         float preview_scale;
+        // Load() was called
+        bool m_loaded;
+        // image to create the sprite from
+        boost::filesystem::path m_image_filename;
+        cSprite_Manager* m_sprite_manager;
     };
 
     /* *** *** *** *** *** *** *** *** cEditor_Menu_Object *** *** *** *** *** *** *** *** *** */
@@ -161,8 +176,14 @@ namespace SMC {
          * if image is set the default object image is not used
          */
         void Add_Item_Object(cSprite* sprite, std::string new_name = "", cGL_Surface* image = NULL);
+        // Add an image Item which is loaded when it gets visible
+        void Add_Image_Item(const cEditor_Item_Index::cItem& item);
         // Loads all Image Items
         void Load_Image_Items(boost::filesystem::path dir);
+        /* Load the images of the visible Items
+         * and a few others in the background
+        */
+        void Update_Item_Images(void);
         // Active Item Entry
         virtual void Activate_Item(cEditor_Item_Object* entry);
 
@@ -179,6 +200,12 @@ namespace SMC {
         void Select_Same_Object_Types(const cSprite* obj);
         // Replace the selected basic sprites
         void Replace_Sprites(void);
+        // Watch the selected and active objects for changes
+        void Watch_Selected_Objects(void);
+        // Undo the last change
+        void Undo(void);
+        // Redo the last undone change
+        void Redo(void);
 
         // CEGUI events
         bool Editor_Mouse_Enter(const CEGUI::EventArgs& event);   // Mouse entered Window
@@ -215,9 +242,14 @@ namespace SMC {
         // Timer until the Menu will be minimized
         float m_menu_timer;
 
+        // Images with tags
+        cEditor_Item_Index m_item_index;
+        // next Item to load in the background
+        unsigned int m_item_load_pos;
+        // undo and redo journal
+        cEditor_Journal m_journal;
+
         // Objects with tags
-        typedef vector<cImage_Settings_Data*> TaggedItemImageSettingsList;
-        TaggedItemImageSettingsList m_tagged_item_images;
         typedef vector<cSprite*> TaggedItemObjectsList;
         TaggedItemObjectsList m_tagged_item_objects;
 
@@ -0,0 +1,402 @@
+/***************************************************************************
+ * editor_item_index.cpp  -  tag index of the editor image items
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../../core/editor/editor_item_index.hpp"
+#include "../../core/filesystem/filesystem.hpp"
+#include "../../core/filesystem/binary_file.hpp"
+#include "../../core/property_helper.hpp"
+#include "../../video/img_settings.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace SMC {
+
+static const char* editor_item_cache_magic = "SMCEDITM";
+static const Uint32 editor_item_cache_version = 1;
+
+static std::time_t Get_Item_File_Time(const fs::path& filename)
+{
+    boost::system::error_code ec;
+    std::time_t time = fs::last_write_time(filename, ec);
+
+    if (ec) {
+        return 0;
+    }
+
+    return time;
+}
+
+/* *** *** *** *** *** *** *** cEditor_Item_Index *** *** *** *** *** *** *** *** *** *** */
+
+cEditor_Item_Index::cEditor_Item_Index(void)
+{
+    m_cache_loaded = 0;
+    m_cache_changed = 0;
+}
+
+cEditor_Item_Index::~cEditor_Item_Index(void)
+{
+    Clear();
+}
+
+void cEditor_Item_Index::Build(const fs::path& dir, const std::string& required_tag, const fs::path& cache_filename)
+{
+    Clear();
+
+    if (!m_cache_loaded && !cache_filename.empty()) {
+        m_cache_loaded = 1;
+
+        if (!Load_Cache(cache_filename)) {
+            m_directories.clear();
+            m_cache_changed = 1;
+        }
+    }
+
+    // only keep the still existing directories
+    Directory_Map new_directories;
+    Scan_Directory(dir, new_directories);
+
+    if (new_directories.size() != m_directories.size()) {
+        m_cache_changed = 1;
+    }
+
+    m_directories.swap(new_directories);
+
+    // items in the same order as Get_Directory_Files()
+    vector<std::pair<const vector<cEntry>*, unsigned int> > stack;
+    Directory_Map::const_iterator root = m_directories.find(path_to_utf8(dir));
+
+    if (root != m_directories.end()) {
+        stack.push_back(std::make_pair(&root->second.m_entries, 0U));
+    }
+
+    while (!stack.empty()) {
+        const vector<cEntry>& entries = *stack.back().first;
+        unsigned int& pos = stack.back().second;
+
+        if (pos >= entries.size()) {
+            stack.pop_back();
+            continue;
+        }
+
+        const cEntry& entry = entries[pos];
+        pos++;
+
+        if (!entry.m_directory) {
+            Add_Item(entry, required_tag);
+            continue;
+        }
+
+        Directory_Map::const_iterator sub_itr = m_directories.find(path_to_utf8(entry.m_path));
+
+        if (sub_itr != m_directories.end()) {
+            stack.push_back(std::make_pair(&sub_itr->second.m_entries, 0U));
+        }
+    }
+
+    if (m_cache_changed && !cache_filename.empty()) {
+        if (Save_Cache(cache_filename)) {
+            m_cache_changed = 0;
+        }
+    }
+}
+
+void cEditor_Item_Index::Clear(void)
+{
+    m_items.clear();
+    m_tags.clear();
+}
+
+void cEditor_Item_Index::Scan_Directory(const fs::path& dir, Directory_Map& new_directories)
+{
+    if (!Dir_Exists(dir)) {
+        return;
+    }
+
+    const std::string key = path_to_utf8(dir);
+    const std::time_t dir_time = Get_Item_File_Time(dir);
+
+    cDirectory& directory = new_directories[key];
+    Directory_Map::iterator cached = m_directories.find(key);
+
+    // unchanged directory listing
+    if (cached != m_directories.end() && cached->second.m_time == dir_time) {
+        directory = cached->second;
+    }
+    else {
+        directory.m_time = dir_time;
+        m_cache_changed = 1;
+
+        // reuse the parsed files of the old listing
+        std::map<std::string, const cEntry*> old_entries;
+
+        if (cached != m_directories.end()) {
+            for (vector<cEntry>::const_iterator itr = cached->second.m_entries.begin(); itr != cached->second.m_entries.end(); ++itr) {
+                old_entries[path_to_utf8(itr->m_path)] = &(*itr);
+            }
+        }
+
+        fs::directory_iterator end_iter;
+
+        for (fs::directory_iterator dir_itr(dir); dir_itr != end_iter; ++dir_itr) {
+            try {
+                const fs::path this_path = dir_itr->path();
+                cEntry entry;
+                entry.m_path = this_path;
+                entry.m_time = 0;
+                entry.m_massive_type = MASS_PASSIVE;
+
+                if (fs::is_directory(*dir_itr)) {
+                    // ignore hidden directories and . and ..
+                    if (path_to_utf8(this_path.filename()).find(".") == 0) {
+                        continue;
+                    }
+
+                    entry.m_directory = 1;
+                }
+                else if (this_path.extension() == utf8_to_path(".settings")) {
+                    entry.m_directory = 0;
+
+                    std::map<std::string, const cEntry*>::const_iterator old_itr = old_entries.find(path_to_utf8(this_path));
+
+                    if (old_itr != old_entries.end() && !old_itr->second->m_directory) {
+                        entry = *old_itr->second;
+                    }
+                }
+                else {
+                    continue;
+                }
+
+                directory.m_entries.push_back(entry);
+            }
+            catch (const std::exception& ex) {
+                cerr << dir_itr->path().string().c_str() << " " << ex.what() << endl;
+            }
+        }
+    }
+
+    for (vector<cEntry>::iterator itr = directory.m_entries.begin(); itr != directory.m_entries.end(); ++itr) {
+        cEntry& entry = (*itr);
+
+        if (entry.m_directory) {
+            Scan_Directory(entry.m_path, new_directories);
+            continue;
+        }
+
+        // settings files edited in place do not change the directory time
+        const std::time_t file_time = Get_Item_File_Time(entry.m_path);
+
+        if (file_time != entry.m_time) {
+            Load_Entry(entry, file_time);
+            m_cache_changed = 1;
+        }
+    }
+}
+
+void cEditor_Item_Index::Load_Entry(cEntry& entry, std::time_t time)
+{
+    entry.m_time = time;
+    entry.m_editor_tags.clear();
+    entry.m_name.clear();
+    entry.m_massive_type = MASS_PASSIVE;
+
+    cImage_Settings_Data* settings = pSettingsParser->Get(entry.m_path);
+
+    if (!settings) {
+        return;
+    }
+
+    entry.m_editor_tags = settings->m_editor_tags;
+    entry.m_name = settings->m_name;
+    entry.m_massive_type = settings->m_massive_type;
+
+    delete settings;
+}
+
+void cEditor_Item_Index::Add_Item(const cEntry& entry, const std::string& required_tag)
+{
+    if (entry.m_editor_tags.empty() || entry.m_editor_tags.find(required_tag) == std::string::npos) {
+        return;
+    }
+
+    const unsigned int index = m_items.size();
+
+    cItem item;
+    item.m_filename = entry.m_path;
+    item.m_massive_type = entry.m_massive_type;
+
+    if (!entry.m_name.empty()) {
+        item.m_name = entry.m_name;
+        // replace "_" with " " like the image name
+        string_replace_all(item.m_name, "_", " ");
+    }
+    else {
+        fs::path name = entry.m_path.filename();
+        name.replace_extension();
+        item.m_name = path_to_utf8(name);
+    }
+
+    m_items.push_back(item);
+
+    // add to the tag lists
+    std::string::size_type start = 0;
+
+    while (start <= entry.m_editor_tags.length()) {
+        std::string::size_type end = entry.m_editor_tags.find(';', start);
+
+        if (end == std::string::npos) {
+            end = entry.m_editor_tags.length();
+        }
+
+        if (end > start) {
+            vector<unsigned int>& tag_items = m_tags[entry.m_editor_tags.substr(start, end - start)];
+
+            // tag given twice
+            if (tag_items.empty() || tag_items.back() != index) {
+                tag_items.push_back(index);
+            }
+        }
+
+        start = end + 1;
+    }
+}
+
+void cEditor_Item_Index::Query(const vector<std::string>& tags, vector<unsigned int>& result) const
+{
+    result.clear();
+
+    if (tags.empty()) {
+        return;
+    }
+
+    // start with the smallest list
+    vector<const vector<unsigned int>*> lists;
+
+    for (vector<std::string>::const_iterator itr = tags.begin(); itr != tags.end(); ++itr) {
+        Tag_Map::const_iterator tag_itr = m_tags.find(*itr);
+
+        // no item has this tag
+        if (tag_itr == m_tags.end()) {
+            return;
+        }
+
+        lists.push_back(&tag_itr->second);
+    }
+
+    unsigned int smallest = 0;
+
+    for (unsigned int i = 1; i < lists.size(); i++) {
+        if (lists[i]->size() < lists[smallest]->size()) {
+            smallest = i;
+        }
+    }
+
+    result = *lists[smallest];
+
+    // intersect the sorted lists
+    vector<unsigned int> temp;
+
+    for (unsigned int i = 0; i < lists.size() && !result.empty(); i++) {
+        if (i == smallest) {
+            continue;
+        }
+
+        temp.clear();
+        std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(), std::back_inserter(temp));
+        result.swap(temp);
+    }
+}
+
+bool cEditor_Item_Index::Load_Cache(const fs::path& filename)
+{
+    if (!File_Exists(filename)) {
+        return 0;
+    }
+
+    cBinary_Reader reader(filename, editor_item_cache_magic, editor_item_cache_version);
+
+    // created by another game version
+    if (reader.Read_Uint32() != smc_version) {
+        return 0;
+    }
+
+    Uint32 count = reader.Read_Uint32();
+
+    for (Uint32 i = 0; i < count && reader.Is_Good(); i++) {
+        cDirectory& directory = m_directories[reader.Read_String()];
+        directory.m_time = static_cast<std::time_t>(reader.Read_Uint64());
+
+        Uint32 entry_count = reader.Read_Uint32();
+
+        for (Uint32 j = 0; j < entry_count && reader.Is_Good(); j++) {
+            cEntry entry;
+            entry.m_path = utf8_to_path(reader.Read_String());
+            entry.m_directory = reader.Read_Uint8() != 0;
+            entry.m_time = static_cast<std::time_t>(reader.Read_Uint64());
+            entry.m_editor_tags = reader.Read_String();
+            entry.m_name = reader.Read_String();
+            entry.m_massive_type = static_cast<MassiveType>(reader.Read_Int32());
+
+            directory.m_entries.push_back(entry);
+        }
+    }
+
+    if (!reader.Is_Good()) {
+        cerr << "Warning : Editor item cache " << path_to_utf8(filename) << " is invalid" << endl;
+        return 0;
+    }
+
+    return 1;
+}
+
+bool cEditor_Item_Index::Save_Cache(const fs::path& filename) const
+{
+    cBinary_Writer writer(filename, editor_item_cache_magic, editor_item_cache_version);
+
+    writer.Write_Uint32(smc_version);
+    writer.Write_Uint32(m_directories.size());
+
+    for (Directory_Map::const_iterator itr = m_directories.begin(); itr != m_directories.end(); ++itr) {
+        const cDirectory& directory = itr->second;
+
+        writer.Write_String(itr->first);
+        writer.Write_Uint64(static_cast<Uint64>(directory.m_time));
+        writer.Write_Uint32(directory.m_entries.size());
+
+        for (vector<cEntry>::const_iterator entry_itr = directory.m_entries.begin(); entry_itr != directory.m_entries.end(); ++entry_itr) {
+            const cEntry& entry = (*entry_itr);
+
+            writer.Write_String(path_to_utf8(entry.m_path));
+            writer.Write_Uint8(entry.m_directory);
+            writer.Write_Uint64(static_cast<Uint64>(entry.m_time));
+            writer.Write_String(entry.m_editor_tags);
+            writer.Write_String(entry.m_name);
+            writer.Write_Int32(entry.m_massive_type);
+        }
+    }
+
+    if (!writer.Finish()) {
+        cerr << "Warning : Could not write editor item cache " << path_to_utf8(filename) << endl;
+        return 0;
+    }
+
+    return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,120 @@
+/***************************************************************************
+ * editor_item_index.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_EDITOR_ITEM_INDEX_HPP
+#define SMC_EDITOR_ITEM_INDEX_HPP
+
+#include "../../core/global_basic.hpp"
+#include "../../core/global_game.hpp"
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** cEditor_Item_Index *** *** *** *** *** *** *** *** *** *** */
+
+    /* Index of the image settings files with editor tags
+     * Maps every editor tag to the items having it so an item menu does not need
+     * to check all images. The scanned directories are cached on disk and a
+     * directory is only listed again if its modification time changed. Settings
+     * files are only parsed again if their own modification time changed.
+    */
+    class cEditor_Item_Index {
+    public:
+        cEditor_Item_Index(void);
+        ~cEditor_Item_Index(void);
+
+        struct cItem {
+            // settings filename
+            boost::filesystem::path m_filename;
+            // display name
+            std::string m_name;
+            // default massive type
+            MassiveType m_massive_type;
+        };
+
+        /* Index all settings files in the directory and its sub-directories
+         * required_tag : only add settings whose editor tags contain it
+         * cache_filename : disk cache of the scanned directories or empty to disable it
+        */
+        void Build(const boost::filesystem::path& dir, const std::string& required_tag, const boost::filesystem::path& cache_filename);
+        // Remove all items
+        void Clear(void);
+
+        /* Get the items having all the given tags
+         * Items are returned in directory order.
+        */
+        void Query(const vector<std::string>& tags, vector<unsigned int>& result) const;
+
+        // Get an item by the index returned from Query()
+        const cItem& Get_Item(unsigned int index) const
+        {
+            return m_items[index];
+        };
+        // Get the item count
+        unsigned int Get_Size(void) const
+        {
+            return m_items.size();
+        };
+
+    private:
+        // directory entry
+        struct cEntry {
+            // file or sub-directory path
+            boost::filesystem::path m_path;
+            bool m_directory;
+            // settings file data
+            std::time_t m_time;
+            std::string m_editor_tags;
+            std::string m_name;
+            MassiveType m_massive_type;
+        };
+
+        // scanned directory
+        struct cDirectory {
+            std::time_t m_time;
+            // settings files and sub-directories in directory order
+            vector<cEntry> m_entries;
+        };
+
+        typedef std::map<std::string, cDirectory> Directory_Map;
+
+        // Scan the directory or use the cached entries if it did not change
+        void Scan_Directory(const boost::filesystem::path& dir, Directory_Map& new_directories);
+        // Parse the settings file into the entry
+        void Load_Entry(cEntry& entry, std::time_t time);
+        // Add the entry as item if it has the required tag
+        void Add_Item(const cEntry& entry, const std::string& required_tag);
+
+        bool Load_Cache(const boost::filesystem::path& filename);
+        bool Save_Cache(const boost::filesystem::path& filename) const;
+
+        // items in directory order
+        vector<cItem> m_items;
+        // item indices of every tag in ascending order
+        typedef std::map<std::string, vector<unsigned int> > Tag_Map;
+        Tag_Map m_tags;
+
+        // scanned directories by path
+        Directory_Map m_directories;
+        // directory cache was loaded
+        bool m_cache_loaded;
+        // directories changed since the cache was loaded
+        bool m_cache_changed;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
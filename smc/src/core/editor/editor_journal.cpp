@@ -0,0 +1,711 @@
+/***************************************************************************
+ * editor_journal.cpp  -  undo and redo journal of the editor objects
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../../core/editor/editor_journal.hpp"
+#include "../../core/sprite_manager.hpp"
+#include "../../core/filesystem/filesystem.hpp"
+#include "../../core/filesystem/binary_file.hpp"
+#include "../../core/property_helper.hpp"
+#include "../../level/level_player.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace SMC {
+
+static const char* editor_journal_magic = "SMCJRNL";
+static const Uint32 editor_journal_version = 1;
+// maximum undo steps
+static const unsigned int editor_journal_max_steps = 500;
+
+/* *** *** *** *** *** *** *** cEditor_Journal *** *** *** *** *** *** *** *** *** *** */
+
+cEditor_Journal::cEditor_Journal(void)
+{
+    m_sprite_manager = NULL;
+    m_loader_callback = NULL;
+    m_loader_data = NULL;
+    m_engine_version = 0;
+    m_document = NULL;
+}
+
+cEditor_Journal::~cEditor_Journal(void)
+{
+    Clear();
+
+    if (m_document) {
+        delete m_document;
+        m_document = NULL;
+    }
+}
+
+void cEditor_Journal::Set_Sprite_Manager(cSprite_Manager* sprite_manager)
+{
+    if (m_sprite_manager == sprite_manager) {
+        return;
+    }
+
+    Clear();
+    m_sprite_manager = sprite_manager;
+}
+
+void cEditor_Journal::Set_Loader(Loader_Callback callback, void* data, int engine_version)
+{
+    if (m_loader_callback == callback && m_loader_data == data && m_engine_version == engine_version) {
+        return;
+    }
+
+    Clear();
+    m_loader_callback = callback;
+    m_loader_data = data;
+    m_engine_version = engine_version;
+}
+
+void cEditor_Journal::Watch(cSprite* sprite)
+{
+    if (!Is_Journaled(sprite) || m_watched.find(sprite) != m_watched.end()) {
+        return;
+    }
+
+    // added in this step
+    if (std::find(m_added.begin(), m_added.end(), sprite) != m_added.end()) {
+        return;
+    }
+
+    cState state;
+
+    if (!Get_State(sprite, state)) {
+        return;
+    }
+
+    m_watched[sprite] = state;
+}
+
+void cEditor_Journal::Record_Add(cSprite* sprite)
+{
+    if (!Is_Journaled(sprite)) {
+        return;
+    }
+
+    m_added.push_back(sprite);
+}
+
+void cEditor_Journal::Record_Delete(cSprite* sprite)
+{
+    if (!Is_Journaled(sprite)) {
+        return;
+    }
+
+    // added and deleted in the same step
+    vector<cSprite*>::iterator added_itr = std::find(m_added.begin(), m_added.end(), sprite);
+
+    if (added_itr != m_added.end()) {
+        m_added.erase(added_itr);
+        return;
+    }
+
+    cOperation operation;
+    operation.m_type = JOURNAL_DELETE;
+    operation.m_uid = sprite->m_uid;
+
+    // undoing the step restores the state from its start
+    Watched_Map::iterator watched_itr = m_watched.find(sprite);
+
+    if (watched_itr != m_watched.end()) {
+        operation.m_tag = watched_itr->second.m_tag;
+        operation.m_properties = watched_itr->second.m_properties;
+        m_watched.erase(watched_itr);
+    }
+    else {
+        cState state;
+
+        if (!Get_State(sprite, state)) {
+            return;
+        }
+
+        operation.m_tag = state.m_tag;
+        operation.m_properties = state.m_properties;
+    }
+
+    m_step.push_back(operation);
+}
+
+void cEditor_Journal::Commit(void)
+{
+    // added objects with their final state
+    for (vector<cSprite*>::iterator itr = m_added.begin(); itr != m_added.end(); ++itr) {
+        cSprite* sprite = (*itr);
+
+        // destroyed
+        if (sprite->m_auto_destroy) {
+            continue;
+        }
+
+        cState state;
+
+        if (!Get_State(sprite, state)) {
+            continue;
+        }
+
+        cOperation operation;
+        operation.m_type = JOURNAL_ADD;
+        operation.m_uid = sprite->m_uid;
+        operation.m_tag = state.m_tag;
+        operation.m_properties = state.m_properties;
+
+        m_step.push_back(operation);
+    }
+
+    m_added.clear();
+
+    // changed objects
+    for (Watched_Map::iterator itr = m_watched.begin(); itr != m_watched.end(); ++itr) {
+        cSprite* sprite = itr->first;
+
+        // destroyed
+        if (sprite->m_auto_destroy) {
+            continue;
+        }
+
+        cState state;
+
+        if (!Get_State(sprite, state)) {
+            continue;
+        }
+
+        cOperation operation;
+        operation.m_type = JOURNAL_CHANGE;
+        operation.m_uid = sprite->m_uid;
+        operation.m_tag = state.m_tag;
+        Get_Changes(itr->second, state, operation.m_changes);
+
+        // not changed
+        if (operation.m_changes.empty()) {
+            continue;
+        }
+
+        m_step.push_back(operation);
+    }
+
+    m_watched.clear();
+
+    if (m_step.empty()) {
+        return;
+    }
+
+    m_undo_steps.push_back(cStep());
+    m_undo_steps.back().swap(m_step);
+
+    if (m_undo_steps.size() > editor_journal_max_steps) {
+        m_undo_steps.pop_front();
+    }
+
+    m_redo_steps.clear();
+    m_unwritten_steps.push_back(m_undo_steps.back());
+}
+
+bool cEditor_Journal::Undo(void)
+{
+    Commit();
+
+    if (m_undo_steps.empty()) {
+        return 0;
+    }
+
+    cStep inverse = Get_Inverse(m_undo_steps.back());
+
+    m_redo_steps.push_back(cStep());
+    m_redo_steps.back().swap(m_undo_steps.back());
+    m_undo_steps.pop_back();
+
+    Object_Map objects;
+    Get_Objects(objects);
+
+    Apply_Step(inverse, objects);
+    Update_Links();
+
+    m_unwritten_steps.push_back(cStep());
+    m_unwritten_steps.back().swap(inverse);
+
+    return 1;
+}
+
+bool cEditor_Journal::Redo(void)
+{
+    Commit();
+
+    if (m_redo_steps.empty()) {
+        return 0;
+    }
+
+    m_undo_steps.push_back(cStep());
+    m_undo_steps.back().swap(m_redo_steps.back());
+    m_redo_steps.pop_back();
+
+    Object_Map objects;
+    Get_Objects(objects);
+
+    Apply_Step(m_undo_steps.back(), objects);
+    Update_Links();
+
+    m_unwritten_steps.push_back(m_undo_steps.back());
+
+    return 1;
+}
+
+void cEditor_Journal::Clear(void)
+{
+    m_step.clear();
+    m_added.clear();
+    m_watched.clear();
+    m_undo_steps.clear();
+    m_redo_steps.clear();
+    m_unwritten_steps.clear();
+}
+
+bool cEditor_Journal::Append_File(const fs::path& filename)
+{
+    if (m_unwritten_steps.empty()) {
+        return 1;
+    }
+
+    cBinary_Writer writer(filename, editor_journal_magic, editor_journal_version, 1);
+
+    for (vector<cStep>::const_iterator itr = m_unwritten_steps.begin(); itr != m_unwritten_steps.end(); ++itr) {
+        Write_Step(writer, *itr);
+    }
+
+    if (!writer.Finish()) {
+        cerr << "Warning : Could not write editor journal " << path_to_utf8(filename) << endl;
+        return 0;
+    }
+
+    m_unwritten_steps.clear();
+
+    return 1;
+}
+
+void cEditor_Journal::Clear_Unwritten(void)
+{
+    m_unwritten_steps.clear();
+}
+
+fs::path cEditor_Journal::Get_Filename(const fs::path& filename)
+{
+    fs::path journal_filename = filename;
+    journal_filename += fs::path(".journal");
+
+    return journal_filename;
+}
+
+bool cEditor_Journal::Has_File(const fs::path& filename)
+{
+    const fs::path journal_filename = Get_Filename(filename);
+
+    if (!File_Exists(journal_filename)) {
+        return 0;
+    }
+
+    boost::system::error_code ec;
+
+    // the file was saved after the journal
+    if (fs::last_write_time(journal_filename, ec) < fs::last_write_time(filename, ec)) {
+        fs::remove(journal_filename, ec);
+        return 0;
+    }
+
+    return 1;
+}
+
+unsigned int cEditor_Journal::Replay_File(const fs::path& filename)
+{
+    if (!m_sprite_manager || !m_loader_callback) {
+        return 0;
+    }
+
+    const fs::path journal_filename = Get_Filename(filename);
+    cBinary_Reader reader(journal_filename, editor_journal_magic, editor_journal_version);
+
+    if (!reader.Is_Good()) {
+        cerr << "Warning : Editor journal " << path_to_utf8(journal_filename) << " is invalid" << endl;
+        return 0;
+    }
+
+    Object_Map objects;
+    Get_Objects(objects);
+
+    unsigned int count = 0;
+    cStep step;
+
+    // a truncated last step is ignored
+    while (Read_Step(reader, step)) {
+        Apply_Step(step, objects);
+        count++;
+    }
+
+    if (count) {
+        Update_Links();
+    }
+
+    return count;
+}
+
+bool cEditor_Journal::Is_Journaled(const cSprite* sprite) const
+{
+    if (!sprite || !m_sprite_manager || !m_loader_callback) {
+        return 0;
+    }
+
+    // not saved with the level
+    if (!sprite->Is_Sprite_Managed() || sprite->m_spawned || sprite->m_auto_destroy || sprite->m_disallow_managed_delete) {
+        return 0;
+    }
+
+    return 1;
+}
+
+bool cEditor_Journal::Get_State(cSprite* sprite, cState& state)
+{
+    if (!m_document) {
+        m_document = new xmlpp::Document();
+        m_document->create_root_node("journal");
+    }
+
+    xmlpp::Element* p_root = m_document->get_root_node();
+    xmlpp::Element* p_node = sprite->Save_To_XML_Node(p_root);
+
+    if (!p_node) {
+        return 0;
+    }
+
+    state.m_tag = p_node->get_name();
+    state.m_properties.clear();
+
+    xmlpp::Node::NodeList children = p_node->get_children("property");
+
+    for (xmlpp::Node::NodeList::iterator itr = children.begin(); itr != children.end(); ++itr) {
+        const xmlpp::Element* p_property = dynamic_cast<const xmlpp::Element*>(*itr);
+
+        if (!p_property) {
+            continue;
+        }
+
+        const xmlpp::Attribute* p_name = p_property->get_attribute("name");
+        const xmlpp::Attribute* p_value = p_property->get_attribute("value");
+
+        if (!p_name || !p_value) {
+            continue;
+        }
+
+        state.m_properties[p_name->get_value()] = p_value->get_value();
+    }
+
+    p_root->remove_child(p_node);
+
+    return 1;
+}
+
+void cEditor_Journal::Get_Changes(const cState& old_state, const cState& new_state, vector<cProperty_Change>& changes) const
+{
+    XmlAttributes::const_iterator old_itr = old_state.m_properties.begin();
+    XmlAttributes::const_iterator new_itr = new_state.m_properties.begin();
+
+    // both are sorted by name
+    while (old_itr != old_state.m_properties.end() || new_itr != new_state.m_properties.end()) {
+        cProperty_Change change;
+        change.m_has_old = 0;
+        change.m_has_new = 0;
+
+        if (new_itr == new_state.m_properties.end() || (old_itr != old_state.m_properties.end() && old_itr->first < new_itr->first)) {
+            // removed
+            change.m_name = old_itr->first;
+            change.m_old_value = old_itr->second;
+            change.m_has_old = 1;
+            ++old_itr;
+        }
+        else if (old_itr == old_state.m_properties.end() || new_itr->first < old_itr->first) {
+            // added
+            change.m_name = new_itr->first;
+            change.m_new_value = new_itr->second;
+            change.m_has_new = 1;
+            ++new_itr;
+        }
+        else {
+            // same
+            if (old_itr->second == new_itr->second) {
+                ++old_itr;
+                ++new_itr;
+                continue;
+            }
+
+            change.m_name = old_itr->first;
+            change.m_old_value = old_itr->second;
+            change.m_new_value = new_itr->second;
+            change.m_has_old = 1;
+            change.m_has_new = 1;
+            ++old_itr;
+            ++new_itr;
+        }
+
+        changes.push_back(change);
+    }
+}
+
+cEditor_Journal::cStep cEditor_Journal::Get_Inverse(const cStep& step) const
+{
+    cStep inverse;
+    inverse.reserve(step.size());
+
+    for (cStep::const_reverse_iterator itr = step.rbegin(); itr != step.rend(); ++itr) {
+        inverse.push_back(*itr);
+        cOperation& operation = inverse.back();
+
+        if (operation.m_type == JOURNAL_ADD) {
+            operation.m_type = JOURNAL_DELETE;
+        }
+        else if (operation.m_type == JOURNAL_DELETE) {
+            operation.m_type = JOURNAL_ADD;
+        }
+        else {
+            for (vector<cProperty_Change>::iterator change_itr = operation.m_changes.begin(); change_itr != operation.m_changes.end(); ++change_itr) {
+                cProperty_Change& change = (*change_itr);
+
+                change.m_old_value.swap(change.m_new_value);
+                std::swap(change.m_has_old, change.m_has_new);
+            }
+        }
+    }
+
+    return inverse;
+}
+
+void cEditor_Journal::Get_Objects(Object_Map& objects) const
+{
+    for (cSprite_List::const_iterator itr = m_sprite_manager->objects.begin(); itr != m_sprite_manager->objects.end(); ++itr) {
+        cSprite* sprite = (*itr);
+
+        if (sprite->m_auto_destroy || sprite->m_spawned) {
+            continue;
+        }
+
+        objects[sprite->m_uid] = sprite;
+    }
+}
+
+void cEditor_Journal::Apply_Step(const cStep& step, Object_Map& objects)
+{
+    for (cStep::const_iterator itr = step.begin(); itr != step.end(); ++itr) {
+        const cOperation& operation = (*itr);
+        Object_Map::iterator obj_itr = objects.find(operation.m_uid);
+
+        if (operation.m_type == JOURNAL_ADD) {
+            if (obj_itr != objects.end()) {
+                cerr << "Warning : Editor journal object UID " << operation.m_uid << " already exists" << endl;
+                continue;
+            }
+
+            cSprite* sprite = Create_Object(operation.m_tag, operation.m_properties, operation.m_uid);
+
+            if (sprite) {
+                objects[operation.m_uid] = sprite;
+            }
+
+            continue;
+        }
+
+        if (obj_itr == objects.end()) {
+            cerr << "Warning : Editor journal object UID " << operation.m_uid << " not found" << endl;
+            continue;
+        }
+
+        cSprite* sprite = obj_itr->second;
+
+        if (operation.m_type == JOURNAL_DELETE) {
+            Remove_Object(sprite);
+            objects.erase(obj_itr);
+            continue;
+        }
+
+        // change the current properties
+        cState state;
+
+        if (!Get_State(sprite, state)) {
+            continue;
+        }
+
+        for (vector<cProperty_Change>::const_iterator change_itr = operation.m_changes.begin(); change_itr != operation.m_changes.end(); ++change_itr) {
+            const cProperty_Change& change = (*change_itr);
+
+            if (change.m_has_new) {
+                state.m_properties[change.m_name] = change.m_new_value;
+            }
+            else {
+                state.m_properties.erase(change.m_name);
+            }
+        }
+
+        // replace the object
+        Remove_Object(sprite);
+        objects.erase(obj_itr);
+
+        sprite = Create_Object(state.m_tag, state.m_properties, operation.m_uid);
+
+        if (sprite) {
+            objects[operation.m_uid] = sprite;
+        }
+    }
+}
+
+cSprite* cEditor_Journal::Create_Object(const std::string& tag, const XmlAttributes& properties, int uid)
+{
+    XmlAttributes attributes = properties;
+    std::vector<cSprite*> sprites = m_loader_callback(tag, attributes, m_engine_version, m_sprite_manager, m_loader_data);
+
+    if (sprites.empty()) {
+        cerr << "Warning : Editor journal could not create object " << tag << endl;
+        return NULL;
+    }
+
+    /* destroyed objects release their UID when replaced
+     * which would let the new object share it
+    */
+    cSprite_List destroyed;
+
+    for (cSprite_List::const_iterator itr = m_sprite_manager->objects.begin(); itr != m_sprite_manager->objects.end(); ++itr) {
+        cSprite* obj = (*itr);
+
+        if (obj->m_auto_destroy && obj->m_uid == uid) {
+            destroyed.push_back(obj);
+        }
+    }
+
+    for (cSprite_List::iterator itr = destroyed.begin(); itr != destroyed.end(); ++itr) {
+        m_sprite_manager->Delete(*itr);
+    }
+
+    sprites[0]->m_uid = uid;
+
+    for (std::vector<cSprite*>::iterator itr = sprites.begin(); itr != sprites.end(); ++itr) {
+        m_sprite_manager->Add(*itr);
+    }
+
+    return sprites[0];
+}
+
+void cEditor_Journal::Remove_Object(cSprite* sprite)
+{
+    // remove if current player active item object
+    if (pLevel_Player && pLevel_Player->m_active_object == sprite) {
+        pLevel_Player->m_active_object = NULL;
+    }
+
+    sprite->Destroy();
+}
+
+void cEditor_Journal::Update_Links(void)
+{
+    for (cSprite_List::iterator itr = m_sprite_manager->objects.begin(); itr != m_sprite_manager->objects.end(); ++itr) {
+        cSprite* obj = (*itr);
+
+        if (obj->m_auto_destroy) {
+            continue;
+        }
+
+        obj->Init_Links();
+    }
+}
+
+void cEditor_Journal::Write_Step(cBinary_Writer& writer, const cStep& step)
+{
+    writer.Write_Uint32(step.size());
+
+    for (cStep::const_iterator itr = step.begin(); itr != step.end(); ++itr) {
+        const cOperation& operation = (*itr);
+
+        writer.Write_Uint8(operation.m_type);
+        writer.Write_Int32(operation.m_uid);
+        writer.Write_String(operation.m_tag);
+
+        writer.Write_Uint32(operation.m_properties.size());
+
+        for (XmlAttributes::const_iterator prop_itr = operation.m_properties.begin(); prop_itr != operation.m_properties.end(); ++prop_itr) {
+            writer.Write_String(prop_itr->first);
+            writer.Write_String(prop_itr->second);
+        }
+
+        writer.Write_Uint32(operation.m_changes.size());
+
+        for (vector<cProperty_Change>::const_iterator change_itr = operation.m_changes.begin(); change_itr != operation.m_changes.end(); ++change_itr) {
+            const cProperty_Change& change = (*change_itr);
+
+            writer.Write_String(change.m_name);
+            writer.Write_Uint8(change.m_has_old | (change.m_has_new << 1));
+            writer.Write_String(change.m_old_value);
+            writer.Write_String(change.m_new_value);
+        }
+    }
+}
+
+bool cEditor_Journal::Read_Step(cBinary_Reader& reader, cStep& step)
+{
+    step.clear();
+
+    const Uint32 count = reader.Read_Uint32();
+
+    for (Uint32 i = 0; i < count && reader.Is_Good(); i++) {
+        cOperation operation;
+
+        const Uint8 type = reader.Read_Uint8();
+
+        if (type > JOURNAL_CHANGE) {
+            return 0;
+        }
+
+        operation.m_type = static_cast<Operation_Type>(type);
+        operation.m_uid = reader.Read_Int32();
+        operation.m_tag = reader.Read_String();
+
+        const Uint32 property_count = reader.Read_Uint32();
+
+        for (Uint32 j = 0; j < property_count && reader.Is_Good(); j++) {
+            const std::string name = reader.Read_String();
+            operation.m_properties[name] = reader.Read_String();
+        }
+
+        const Uint32 change_count = reader.Read_Uint32();
+
+        for (Uint32 j = 0; j < change_count && reader.Is_Good(); j++) {
+            cProperty_Change change;
+            change.m_name = reader.Read_String();
+
+            const Uint8 flags = reader.Read_Uint8();
+            change.m_has_old = (flags & 1) != 0;
+            change.m_has_new = (flags & 2) != 0;
+            change.m_old_value = reader.Read_String();
+            change.m_new_value = reader.Read_String();
+
+            operation.m_changes.push_back(change);
+        }
+
+        step.push_back(operation);
+    }
+
+    return reader.Is_Good();
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
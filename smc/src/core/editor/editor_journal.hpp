@@ -0,0 +1,189 @@
+/***************************************************************************
+ * editor_journal.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_EDITOR_JOURNAL_HPP
+#define SMC_EDITOR_JOURNAL_HPP
+
+#include "../../core/global_basic.hpp"
+#include "../../core/xml_attributes.hpp"
+
+#include <deque>
+
+namespace SMC {
+
+    class cBinary_Writer;
+    class cBinary_Reader;
+
+    /* *** *** *** *** *** *** *** cEditor_Journal *** *** *** *** *** *** *** *** *** *** */
+
+    /* Undo and redo journal of the editor objects
+     * Objects are identified by their UID and stored as the properties they save
+     * into the level file. Added and deleted objects keep all their properties,
+     * changed objects only the properties which changed. The operations between
+     * two Commit() calls form one step which is undone or redone together.
+     *
+     * Applied steps are also appended to a journal file. The file only holds
+     * changes which were not saved and is used to recover them in the editor
+     * after the game was not closed properly.
+    */
+    class cEditor_Journal {
+    public:
+        // creates the objects of a level or world tag
+        typedef std::vector<cSprite*> (*Loader_Callback)(const std::string&, XmlAttributes&, int, cSprite_Manager*, void*);
+
+        cEditor_Journal(void);
+        ~cEditor_Journal(void);
+
+        // Set the sprite manager of the objects and clear the journal if it changed
+        void Set_Sprite_Manager(cSprite_Manager* sprite_manager);
+        /* Set the function creating objects from their properties
+         * data : passed to the callback
+         * engine_version : the engine version the properties are saved with
+        */
+        void Set_Loader(Loader_Callback callback, void* data, int engine_version);
+
+        // Remember the object state to record its changes on the next Commit()
+        void Watch(cSprite* sprite);
+        // Record the added object with its state on the next Commit()
+        void Record_Add(cSprite* sprite);
+        // Record the object before it gets destroyed
+        void Record_Delete(cSprite* sprite);
+        /* Record the changes of the watched objects and finish the current step
+         * The objects are not watched anymore afterwards.
+        */
+        void Commit(void);
+
+        /* Undo or redo the last step
+         * The objects of the step are replaced with new ones so no references to
+         * them should be kept.
+         * returns true if a step was applied
+        */
+        bool Undo(void);
+        bool Redo(void);
+
+        // Remove all steps and watched objects
+        void Clear(void);
+
+        // Applied steps not yet written to the journal file
+        unsigned int Get_Unwritten_Count(void) const
+        {
+            return m_unwritten_steps.size();
+        };
+        /* Append the unwritten steps to the journal file
+         * returns true on success
+        */
+        bool Append_File(const boost::filesystem::path& filename);
+        // The unwritten steps are saved elsewhere
+        void Clear_Unwritten(void);
+
+        // Get the journal filename of the level or world file
+        static boost::filesystem::path Get_Filename(const boost::filesystem::path& filename);
+        // Check if the level or world file has a journal file newer than itself
+        static bool Has_File(const boost::filesystem::path& filename);
+        /* Apply the journal file of the loaded level or world file to the objects
+         * The steps are not added to the undo steps.
+         * returns the number of applied steps
+        */
+        unsigned int Replay_File(const boost::filesystem::path& filename);
+
+    private:
+        enum Operation_Type {
+            JOURNAL_ADD = 0,
+            JOURNAL_DELETE = 1,
+            JOURNAL_CHANGE = 2
+        };
+
+        // changed property
+        struct cProperty_Change {
+            std::string m_name;
+            std::string m_old_value;
+            std::string m_new_value;
+            // if the property was saved before and after the change
+            bool m_has_old;
+            bool m_has_new;
+        };
+
+        struct cOperation {
+            Operation_Type m_type;
+            int m_uid;
+            // xml tag name
+            std::string m_tag;
+            // all properties if added or deleted
+            XmlAttributes m_properties;
+            // changed properties if changed
+            vector<cProperty_Change> m_changes;
+        };
+
+        typedef vector<cOperation> cStep;
+        typedef std::map<int, cSprite*> Object_Map;
+
+        // saved object state
+        struct cState {
+            std::string m_tag;
+            XmlAttributes m_properties;
+        };
+
+        // Check if the object can be recorded
+        bool Is_Journaled(const cSprite* sprite) const;
+        // Save the object properties
+        bool Get_State(cSprite* sprite, cState& state);
+        // Add the property changes from the old to the new state
+        void Get_Changes(const cState& old_state, const cState& new_state, vector<cProperty_Change>& changes) const;
+        // Get the step undoing the given step
+        cStep Get_Inverse(const cStep& step) const;
+
+        // Get the objects which can be changed by a step
+        void Get_Objects(Object_Map& objects) const;
+        /* Apply the step to the objects
+         * objects : from Get_Objects() and updated with the changes
+        */
+        void Apply_Step(const cStep& step, Object_Map& objects);
+        // Create the object with the given UID
+        cSprite* Create_Object(const std::string& tag, const XmlAttributes& properties, int uid);
+        // Destroy the object
+        void Remove_Object(cSprite* sprite);
+        // Update the links between the objects after a step was applied
+        void Update_Links(void);
+
+        static void Write_Step(cBinary_Writer& writer, const cStep& step);
+        static bool Read_Step(cBinary_Reader& reader, cStep& step);
+
+        cSprite_Manager* m_sprite_manager;
+        Loader_Callback m_loader_callback;
+        void* m_loader_data;
+        int m_engine_version;
+
+        // document objects are saved into
+        xmlpp::Document* m_document;
+
+        // current step
+        cStep m_step;
+        // objects added in the current step
+        vector<cSprite*> m_added;
+        // watched objects with their state
+        typedef std::map<cSprite*, cState> Watched_Map;
+        Watched_Map m_watched;
+
+        std::deque<cStep> m_undo_steps;
+        vector<cStep> m_redo_steps;
+        // applied steps in applied direction
+        vector<cStep> m_unwritten_steps;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
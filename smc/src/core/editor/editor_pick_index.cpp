@@ -0,0 +1,298 @@
+/***************************************************************************
+ * editor_pick_index.cpp  -  spatial index for editor object picking
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../../core/editor/editor_pick_index.hpp"
+#include "../../core/sprite_manager.hpp"
+
+using namespace std;
+
+namespace SMC {
+
+// default grid cell size
+static const float editor_pick_cell_size = 256.0f;
+// maximum grid cells before the cell size is increased
+static const int editor_pick_max_cells = 65536;
+
+/* *** *** *** *** *** *** *** cEditor_Pick_Index *** *** *** *** *** *** *** *** *** *** */
+
+cEditor_Pick_Index::cEditor_Pick_Index(void)
+{
+    m_sprite_manager = NULL;
+    m_player = NULL;
+    m_manager_change_count = 0;
+    m_rect_change_count = 0;
+    m_valid = 0;
+
+    m_origin_x = 0.0f;
+    m_origin_y = 0.0f;
+    m_cell_size = editor_pick_cell_size;
+    m_cells_x = 0;
+    m_cells_y = 0;
+
+    m_query_stamp = 0;
+}
+
+cEditor_Pick_Index::~cEditor_Pick_Index(void)
+{
+
+}
+
+void cEditor_Pick_Index::Update(cSprite_Manager* sprite_manager, cSprite* player)
+{
+    if (m_valid && m_sprite_manager == sprite_manager && m_player == player && m_manager_change_count == cSprite_Manager::m_change_count && m_rect_change_count == cSprite::m_editor_rect_change_count) {
+        return;
+    }
+
+    m_sprite_manager = sprite_manager;
+    m_player = player;
+    m_manager_change_count = cSprite_Manager::m_change_count;
+    m_rect_change_count = cSprite::m_editor_rect_change_count;
+
+    Build();
+}
+
+void cEditor_Pick_Index::Invalidate(void)
+{
+    m_valid = 0;
+}
+
+void cEditor_Pick_Index::Build(void)
+{
+    m_valid = 1;
+    m_entries.clear();
+    m_cell_start.clear();
+    m_cell_entries.clear();
+    m_cells_x = 0;
+    m_cells_y = 0;
+
+    if (!m_sprite_manager) {
+        return;
+    }
+
+    m_entries.reserve(m_sprite_manager->objects.size() + 1);
+
+    for (cSprite_List::const_iterator itr = m_sprite_manager->objects.begin(); itr != m_sprite_manager->objects.end(); ++itr) {
+        cEntry entry;
+        entry.m_sprite = (*itr);
+        m_entries.push_back(entry);
+    }
+
+    if (m_player) {
+        cEntry entry;
+        entry.m_sprite = m_player;
+        m_entries.push_back(entry);
+    }
+
+    if (m_entries.empty()) {
+        return;
+    }
+
+    float min_x = 0.0f;
+    float min_y = 0.0f;
+    float max_x = 0.0f;
+    float max_y = 0.0f;
+
+    for (unsigned int i = 0; i < m_entries.size(); i++) {
+        cEntry& entry = m_entries[i];
+        const cSprite* sprite = entry.m_sprite;
+
+        // selection uses the current rect and picking the start rect
+        const float x1 = min(sprite->m_start_rect.m_x, sprite->m_rect.m_x);
+        const float y1 = min(sprite->m_start_rect.m_y, sprite->m_rect.m_y);
+        const float x2 = max(sprite->m_start_rect.m_x + sprite->m_start_rect.m_w, sprite->m_rect.m_x + sprite->m_rect.m_w);
+        const float y2 = max(sprite->m_start_rect.m_y + sprite->m_start_rect.m_h, sprite->m_rect.m_y + sprite->m_rect.m_h);
+
+        entry.m_rect = GL_rect(x1, y1, x2 - x1, y2 - y1);
+        entry.m_sort_key = cSprite_Manager::Get_Editor_Zpos_Sort_Key(sprite);
+
+        if (i == 0 || x1 < min_x) {
+            min_x = x1;
+        }
+        if (i == 0 || y1 < min_y) {
+            min_y = y1;
+        }
+        if (i == 0 || x2 > max_x) {
+            max_x = x2;
+        }
+        if (i == 0 || y2 > max_y) {
+            max_y = y2;
+        }
+    }
+
+    // grid size
+    m_origin_x = min_x;
+    m_origin_y = min_y;
+    m_cell_size = editor_pick_cell_size;
+
+    while (1) {
+        m_cells_x = static_cast<int>((max_x - min_x) / m_cell_size) + 1;
+        m_cells_y = static_cast<int>((max_y - min_y) / m_cell_size) + 1;
+
+        if (m_cells_x * m_cells_y <= editor_pick_max_cells) {
+            break;
+        }
+
+        m_cell_size *= 2.0f;
+    }
+
+    // count entries per cell
+    m_cell_start.assign(m_cells_x * m_cells_y + 1, 0);
+
+    for (unsigned int i = 0; i < m_entries.size(); i++) {
+        int x1, y1, x2, y2;
+        Get_Cell_Range(m_entries[i].m_rect, x1, y1, x2, y2);
+
+        for (int y = y1; y <= y2; y++) {
+            for (int x = x1; x <= x2; x++) {
+                m_cell_start[y * m_cells_x + x + 1]++;
+            }
+        }
+    }
+
+    for (unsigned int i = 1; i < m_cell_start.size(); i++) {
+        m_cell_start[i] += m_cell_start[i - 1];
+    }
+
+    // fill cells in entry order
+    m_cell_entries.resize(m_cell_start.back());
+    vector<unsigned int> cell_fill(m_cell_start.begin(), m_cell_start.end() - 1);
+
+    for (unsigned int i = 0; i < m_entries.size(); i++) {
+        int x1, y1, x2, y2;
+        Get_Cell_Range(m_entries[i].m_rect, x1, y1, x2, y2);
+
+        for (int y = y1; y <= y2; y++) {
+            for (int x = x1; x <= x2; x++) {
+                m_cell_entries[cell_fill[y * m_cells_x + x]++] = i;
+            }
+        }
+    }
+
+    m_query_mark.assign(m_entries.size(), 0);
+    m_query_stamp = 0;
+}
+
+bool cEditor_Pick_Index::Get_Cell_Range(const GL_rect& rect, int& x1, int& y1, int& x2, int& y2) const
+{
+    if (!m_cells_x || !m_cells_y) {
+        return 0;
+    }
+
+    x1 = static_cast<int>(floor((rect.m_x - m_origin_x) / m_cell_size));
+    y1 = static_cast<int>(floor((rect.m_y - m_origin_y) / m_cell_size));
+    x2 = static_cast<int>(floor((rect.m_x + rect.m_w - m_origin_x) / m_cell_size));
+    y2 = static_cast<int>(floor((rect.m_y + rect.m_h - m_origin_y) / m_cell_size));
+
+    // outside
+    if (x2 < 0 || y2 < 0 || x1 >= m_cells_x || y1 >= m_cells_y) {
+        return 0;
+    }
+
+    x1 = max(x1, 0);
+    y1 = max(y1, 0);
+    x2 = min(x2, m_cells_x - 1);
+    y2 = min(y2, m_cells_y - 1);
+
+    return 1;
+}
+
+void cEditor_Pick_Index::Query_Entries(const GL_rect& rect)
+{
+    m_query_entries.clear();
+
+    int x1, y1, x2, y2;
+
+    if (!Get_Cell_Range(rect, x1, y1, x2, y2)) {
+        return;
+    }
+
+    // new duplicate detection stamp
+    m_query_stamp++;
+
+    if (!m_query_stamp) {
+        m_query_mark.assign(m_entries.size(), 0);
+        m_query_stamp = 1;
+    }
+
+    for (int y = y1; y <= y2; y++) {
+        for (int x = x1; x <= x2; x++) {
+            const unsigned int cell = y * m_cells_x + x;
+
+            for (unsigned int i = m_cell_start[cell]; i < m_cell_start[cell + 1]; i++) {
+                const unsigned int entry = m_cell_entries[i];
+
+                if (m_query_mark[entry] == m_query_stamp) {
+                    continue;
+                }
+
+                m_query_mark[entry] = m_query_stamp;
+                m_query_entries.push_back(entry);
+            }
+        }
+    }
+
+    // keep the sprite manager order
+    std::sort(m_query_entries.begin(), m_query_entries.end());
+}
+
+void cEditor_Pick_Index::Query(const GL_rect& rect, cSprite_List& result, bool with_player /* = 0 */)
+{
+    result.clear();
+    Query_Entries(rect);
+
+    for (vector<unsigned int>::const_iterator itr = m_query_entries.begin(); itr != m_query_entries.end(); ++itr) {
+        cSprite* sprite = m_entries[*itr].m_sprite;
+
+        if (!with_player && sprite == m_player) {
+            continue;
+        }
+
+        result.push_back(sprite);
+    }
+}
+
+cSprite* cEditor_Pick_Index::Get_Top_Sprite(const GL_rect& rect)
+{
+    Query_Entries(rect);
+
+    cSprite* best_sprite = NULL;
+    Uint32 best_key = 0;
+
+    for (vector<unsigned int>::const_iterator itr = m_query_entries.begin(); itr != m_query_entries.end(); ++itr) {
+        const cEntry& entry = m_entries[*itr];
+        cSprite* sprite = entry.m_sprite;
+
+        // ignore spawned or destroyed objects
+        if (sprite->m_spawned || sprite->m_auto_destroy) {
+            continue;
+        }
+
+        if (!rect.Intersects(sprite->m_start_rect)) {
+            continue;
+        }
+
+        // the later sprite wins on the same z position
+        if (!best_sprite || entry.m_sort_key >= best_key) {
+            best_sprite = sprite;
+            best_key = entry.m_sort_key;
+        }
+    }
+
+    return best_sprite;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,100 @@
+/***************************************************************************
+ * editor_pick_index.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_EDITOR_PICK_INDEX_HPP
+#define SMC_EDITOR_PICK_INDEX_HPP
+
+#include "../../core/global_basic.hpp"
+#include "../../core/global_game.hpp"
+#include "../../objects/sprite.hpp"
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** cEditor_Pick_Index *** *** *** *** *** *** *** *** *** *** */
+
+    /* Uniform grid of the editor rects of a sprite manager
+     * Used for mouse hovering, rectangle selection and snapping so only sprites
+     * near the queried rect are checked. The grid is rebuilt lazily when sprites
+     * were added, removed, reordered or an editor rect or z position changed.
+    */
+    class cEditor_Pick_Index {
+    public:
+        cEditor_Pick_Index(void);
+        ~cEditor_Pick_Index(void);
+
+        // Rebuild the grid if the sprites changed
+        void Update(cSprite_Manager* sprite_manager, cSprite* player);
+        // Force a rebuild on the next update
+        void Invalidate(void);
+
+        /* Get the sprites which may intersect the given rect
+         * Sprites are returned in sprite manager order with the player last.
+         * The caller still needs to check the rects.
+         * with_player : include the player
+        */
+        void Query(const GL_rect& rect, cSprite_List& result, bool with_player = 0);
+
+        /* Return the top-most sprite by editor z position whose start rect intersects the given rect
+         * Spawned and destroyed sprites are ignored. Returns NULL if none.
+        */
+        cSprite* Get_Top_Sprite(const GL_rect& rect);
+
+    private:
+        // Rebuild the grid from the sprites
+        void Build(void);
+        // Get the cell range of the rect clamped to the grid
+        bool Get_Cell_Range(const GL_rect& rect, int& x1, int& y1, int& x2, int& y2) const;
+        // Collect the unique entry indices of the rect in entry order
+        void Query_Entries(const GL_rect& rect);
+
+        struct cEntry {
+            cSprite* m_sprite;
+            // union of start and current rect when indexed
+            GL_rect m_rect;
+            // editor z position sort key
+            Uint32 m_sort_key;
+        };
+
+        // indexed source
+        cSprite_Manager* m_sprite_manager;
+        cSprite* m_player;
+        Uint32 m_manager_change_count;
+        Uint32 m_rect_change_count;
+        bool m_valid;
+
+        // sprites in manager order and the player last
+        vector<cEntry> m_entries;
+
+        // grid origin and size
+        float m_origin_x;
+        float m_origin_y;
+        float m_cell_size;
+        int m_cells_x;
+        int m_cells_y;
+        // entry index range of each cell in m_cell_entries
+        vector<unsigned int> m_cell_start;
+        vector<unsigned int> m_cell_entries;
+
+        // query results and duplicate detection
+        vector<unsigned int> m_query_entries;
+        vector<Uint32> m_query_mark;
+        Uint32 m_query_stamp;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
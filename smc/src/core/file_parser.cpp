@@ -19,6 +19,7 @@
 #include "../core/global_basic.hpp"
 #include "../core/file_parser.hpp"
 #include "../core/game_core.hpp"
+#include "../core/filesystem/package_manager.hpp"
 
 using namespace std;
 
@@ -40,11 +41,25 @@ cFile_parser::~cFile_parser(void)
 
 bool cFile_parser::Parse(const fs::path& filename)
 {
-    fs::ifstream ifs(filename, ios::in);
+    std::string archive_data;
+    std::istringstream archive_stream;
+    fs::ifstream file_stream;
+    std::istream* ifs;
+
+    // from a package archive
+    if (pPackage_Manager && pPackage_Manager->Read_Archive_File(filename, archive_data)) {
+        archive_stream.str(archive_data);
+        ifs = &archive_stream;
+    }
+    else {
+        file_stream.open(filename, ios::in);
+
+        if (!file_stream) {
+            cerr << "Could not load data file : " << path_to_utf8(filename) << endl;
+            return 0;
+        }
 
-    if (!ifs) {
-        cerr << "Could not load data file : " << path_to_utf8(filename) << endl;
-        return 0;
+        ifs = &file_stream;
     }
 
     data_file = filename;
@@ -52,7 +67,7 @@ bool cFile_parser::Parse(const fs::path& filename)
     std::string line;
     unsigned int line_num = 0;
 
-    while (std::getline(ifs, line)) {
+    while (std::getline(*ifs, line)) {
         line_num++;
         Parse_Line(line, line_num);
     }
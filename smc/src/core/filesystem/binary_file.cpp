@@ -0,0 +1,277 @@
+/***************************************************************************
+ * binary_file.cpp  -  Binary cache file reading and writing
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../../core/filesystem/binary_file.hpp"
+#include "../../core/property_helper.hpp"
+
+#include <cstring>
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace SMC {
+
+// maximum string length accepted when reading to protect against corrupted files
+static const Uint32 binary_max_string_length = 16 * 1024 * 1024;
+
+/* *** *** *** *** *** cBinary_Writer *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cBinary_Writer::cBinary_Writer(const fs::path& filename, const std::string& magic, Uint32 version, bool append /* = 0 */)
+{
+    m_filename = filename;
+
+    // append to the existing file
+    if (append && fs::exists(filename)) {
+        m_file.open(filename, ios::out | ios::binary | ios::app);
+
+        if (!m_file.is_open()) {
+            cerr << "Warning: Could not open file " << path_to_utf8(filename) << " for appending" << endl;
+        }
+
+        return;
+    }
+
+    m_temp_filename = filename;
+    m_temp_filename += fs::path(".tmp");
+
+    m_file.open(m_temp_filename, ios::out | ios::binary | ios::trunc);
+
+    if (!m_file.is_open()) {
+        cerr << "Warning: Could not create file " << path_to_utf8(m_temp_filename) << " for writing" << endl;
+        return;
+    }
+
+    Write_Data(magic.c_str(), magic.length());
+    Write_Uint32(version);
+}
+
+cBinary_Writer::~cBinary_Writer(void)
+{
+    // not finished
+    if (m_file.is_open()) {
+        m_file.close();
+
+        // keep the appended file
+        if (m_temp_filename.empty()) {
+            return;
+        }
+
+        boost::system::error_code ec;
+        fs::remove(m_temp_filename, ec);
+    }
+}
+
+void cBinary_Writer::Write_Uint8(Uint8 value)
+{
+    m_file.put(static_cast<char>(value));
+}
+
+void cBinary_Writer::Write_Uint32(Uint32 value)
+{
+    unsigned char bytes[4];
+
+    for (unsigned int i = 0; i < 4; i++) {
+        bytes[i] = static_cast<unsigned char>((value >> (i * 8)) & 0xFF);
+    }
+
+    Write_Data(bytes, 4);
+}
+
+void cBinary_Writer::Write_Int32(Sint32 value)
+{
+    Write_Uint32(static_cast<Uint32>(value));
+}
+
+void cBinary_Writer::Write_Uint64(Uint64 value)
+{
+    Write_Uint32(static_cast<Uint32>(value & 0xFFFFFFFF));
+    Write_Uint32(static_cast<Uint32>(value >> 32));
+}
+
+void cBinary_Writer::Write_Float(float value)
+{
+    Uint32 bits;
+    memcpy(&bits, &value, 4);
+    Write_Uint32(bits);
+}
+
+void cBinary_Writer::Write_String(const std::string& str)
+{
+    Write_Uint32(static_cast<Uint32>(str.length()));
+    Write_Data(str.data(), str.length());
+}
+
+void cBinary_Writer::Write_Data(const void* data, size_t size)
+{
+    if (size) {
+        m_file.write(static_cast<const char*>(data), size);
+    }
+}
+
+bool cBinary_Writer::Finish(void)
+{
+    if (!m_file.is_open()) {
+        return 0;
+    }
+
+    m_file.close();
+
+    // appended
+    if (m_temp_filename.empty()) {
+        if (m_file.fail()) {
+            cerr << "Warning: Could not write file " << path_to_utf8(m_filename) << endl;
+            return 0;
+        }
+
+        return 1;
+    }
+
+    if (m_file.fail()) {
+        cerr << "Warning: Could not write file " << path_to_utf8(m_temp_filename) << endl;
+
+        boost::system::error_code ec;
+        fs::remove(m_temp_filename, ec);
+        return 0;
+    }
+
+    // replace the old file
+    boost::system::error_code ec;
+    fs::rename(m_temp_filename, m_filename, ec);
+
+    if (ec) {
+        cerr << "Warning: Could not replace file " << path_to_utf8(m_filename) << " : " << ec.message() << endl;
+        fs::remove(m_temp_filename, ec);
+        return 0;
+    }
+
+    return 1;
+}
+
+bool cBinary_Writer::Is_Good(void) const
+{
+    return m_file.is_open() && m_file.good();
+}
+
+/* *** *** *** *** *** cBinary_Reader *** *** *** *** *** *** *** *** *** *** *** *** */
+
+cBinary_Reader::cBinary_Reader(const fs::path& filename, const std::string& magic, Uint32 version)
+{
+    m_good = 0;
+
+    m_file.open(filename, ios::in | ios::binary);
+
+    if (!m_file.is_open()) {
+        return;
+    }
+
+    m_good = 1;
+
+    // check file type and version
+    std::string file_magic(magic.length(), '\0');
+
+    if (!Read_Data(&file_magic[0], magic.length()) || file_magic != magic || Read_Uint32() != version) {
+        m_good = 0;
+    }
+}
+
+cBinary_Reader::~cBinary_Reader(void)
+{
+
+}
+
+Uint8 cBinary_Reader::Read_Uint8(void)
+{
+    Uint8 value = 0;
+    Read_Data(&value, 1);
+    return value;
+}
+
+Uint32 cBinary_Reader::Read_Uint32(void)
+{
+    unsigned char bytes[4];
+
+    if (!Read_Data(bytes, 4)) {
+        return 0;
+    }
+
+    return static_cast<Uint32>(bytes[0]) | (static_cast<Uint32>(bytes[1]) << 8) | (static_cast<Uint32>(bytes[2]) << 16) | (static_cast<Uint32>(bytes[3]) << 24);
+}
+
+Sint32 cBinary_Reader::Read_Int32(void)
+{
+    return static_cast<Sint32>(Read_Uint32());
+}
+
+Uint64 cBinary_Reader::Read_Uint64(void)
+{
+    Uint64 low = Read_Uint32();
+    Uint64 high = Read_Uint32();
+    return low | (high << 32);
+}
+
+float cBinary_Reader::Read_Float(void)
+{
+    Uint32 bits = Read_Uint32();
+    float value;
+    memcpy(&value, &bits, 4);
+    return value;
+}
+
+std::string cBinary_Reader::Read_String(void)
+{
+    Uint32 length = Read_Uint32();
+
+    if (!m_good || length == 0) {
+        return "";
+    }
+    if (length > binary_max_string_length) {
+        m_good = 0;
+        return "";
+    }
+
+    std::string str(length, '\0');
+
+    if (!Read_Data(&str[0], length)) {
+        return "";
+    }
+
+    return str;
+}
+
+bool cBinary_Reader::Read_Data(void* data, size_t size)
+{
+    if (!m_good) {
+        return 0;
+    }
+
+    m_file.read(static_cast<char*>(data), size);
+
+    if (static_cast<size_t>(m_file.gcount()) != size) {
+        m_good = 0;
+        return 0;
+    }
+
+    return 1;
+}
+
+bool cBinary_Reader::Is_Good(void) const
+{
+    return m_good;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,96 @@
+/***************************************************************************
+ * binary_file.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_BINARY_FILE_HPP
+#define SMC_BINARY_FILE_HPP
+
+#include "../../core/global_basic.hpp"
+
+namespace SMC {
+
+    /* *** *** *** *** *** cBinary_Writer *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Writes a little-endian binary cache file
+     * The data is written to a temporary file which replaces the target on Finish()
+     * so an interrupted write never leaves a truncated cache behind.
+    */
+    class cBinary_Writer {
+    public:
+        /* magic : file type identifier
+         * version : file format version
+         * append : append to an existing file instead of replacing it
+         * The header is only written if the file is created. Appended data is written
+         * directly to the file so an interrupted append can leave a truncated record.
+        */
+        cBinary_Writer(const boost::filesystem::path& filename, const std::string& magic, Uint32 version, bool append = 0);
+        ~cBinary_Writer(void);
+
+        void Write_Uint8(Uint8 value);
+        void Write_Uint32(Uint32 value);
+        void Write_Int32(Sint32 value);
+        void Write_Uint64(Uint64 value);
+        void Write_Float(float value);
+        void Write_String(const std::string& str);
+        void Write_Data(const void* data, size_t size);
+
+        /* Close and move the file to its final name
+         * In append mode the file is only closed.
+         * returns true on success
+        */
+        bool Finish(void);
+
+        // true if no write error occurred
+        bool Is_Good(void) const;
+
+    private:
+        boost::filesystem::path m_filename;
+        boost::filesystem::path m_temp_filename;
+        boost::filesystem::ofstream m_file;
+    };
+
+    /* *** *** *** *** *** cBinary_Reader *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Reads a file written by cBinary_Writer
+     * After a read error all further reads return empty values and Is_Good() returns false.
+    */
+    class cBinary_Reader {
+    public:
+        /* Open the file and check magic and version
+         * Is_Good() returns false if they do not match
+        */
+        cBinary_Reader(const boost::filesystem::path& filename, const std::string& magic, Uint32 version);
+        ~cBinary_Reader(void);
+
+        Uint8 Read_Uint8(void);
+        Uint32 Read_Uint32(void);
+        Sint32 Read_Int32(void);
+        Uint64 Read_Uint64(void);
+        float Read_Float(void);
+        std::string Read_String(void);
+        bool Read_Data(void* data, size_t size);
+
+        // true if the file is valid and no read error occurred
+        bool Is_Good(void) const;
+
+    private:
+        boost::filesystem::ifstream m_file;
+        bool m_good;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -0,0 +1,561 @@
+/***************************************************************************
+ * package_archive.cpp  -  memory mapped single file packages
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../../core/filesystem/package_archive.hpp"
+#include "../../core/filesystem/binary_file.hpp"
+#include "../../core/filesystem/filesystem.hpp"
+#include "../../core/property_helper.hpp"
+
+#include <cstring>
+#include <zlib.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace SMC {
+
+// archive file type and format version
+static const char* package_archive_magic = "SMCPAKAR";
+static const Uint32 package_archive_version = 1;
+
+// compressed entries must save at least this part of the size
+static const float package_archive_min_compression = 0.1f;
+
+// Return the path with "." and ".." resolved and "/" separators
+static std::string Get_Normalized_Path(const fs::path& path)
+{
+    vector<std::string> parts;
+
+    for (fs::path::const_iterator itr = path.begin(); itr != path.end(); ++itr) {
+        const std::string part = itr->generic_string();
+
+        if (part.empty() || part == ".") {
+            continue;
+        }
+
+        if (part == ".." && !parts.empty() && parts.back() != ".." && parts.back() != "/") {
+            parts.pop_back();
+            continue;
+        }
+
+        parts.push_back(part);
+    }
+
+    std::string result;
+
+    for (vector<std::string>::const_iterator itr = parts.begin(); itr != parts.end(); ++itr) {
+        if (!result.empty() && result[result.length() - 1] != '/') {
+            result += '/';
+        }
+
+        result += (*itr);
+    }
+
+    return result;
+}
+
+// Read little-endian values from the mapped archive
+class cArchive_Data_Reader {
+public:
+    cArchive_Data_Reader(const Uint8* data, size_t size)
+        : m_data(data), m_size(size), m_pos(0), m_good(1)
+    {}
+
+    bool Skip(size_t size)
+    {
+        if (!m_good || size > m_size - m_pos) {
+            m_good = 0;
+            return 0;
+        }
+
+        m_pos += size;
+        return 1;
+    }
+
+    Uint8 Read_Uint8(void)
+    {
+        if (!Skip(1)) {
+            return 0;
+        }
+
+        return m_data[m_pos - 1];
+    }
+
+    Uint32 Read_Uint32(void)
+    {
+        if (!Skip(4)) {
+            return 0;
+        }
+
+        const Uint8* bytes = m_data + m_pos - 4;
+        return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<Uint32>(bytes[3]) << 24);
+    }
+
+    std::string Read_String(void)
+    {
+        const Uint32 length = Read_Uint32();
+
+        if (!Skip(length)) {
+            return std::string();
+        }
+
+        return std::string(reinterpret_cast<const char*>(m_data + m_pos - length), length);
+    }
+
+    const Uint8* m_data;
+    size_t m_size;
+    size_t m_pos;
+    bool m_good;
+};
+
+// entry path order of the table of contents
+struct package_archive_entry_less {
+    bool operator()(const cPackage_Archive::cEntry& a, const cPackage_Archive::cEntry& b) const
+    {
+        return a.m_path < b.m_path;
+    }
+
+    bool operator()(const cPackage_Archive::cEntry& a, const std::string& path) const
+    {
+        return a.m_path < path;
+    }
+};
+
+// Close a read operation of a compressed entry and delete its inflated data
+static int SDLCALL Package_Archive_RW_Close(SDL_RWops* context)
+{
+    if (context) {
+        delete[] context->hidden.mem.base;
+        SDL_FreeRW(context);
+    }
+
+    return 0;
+}
+
+/* *** *** *** *** *** *** *** cPackage_Archive *** *** *** *** *** *** *** *** *** *** */
+
+cPackage_Archive::cPackage_Archive(void)
+{
+    m_data = NULL;
+    m_size = 0;
+#ifdef _WIN32
+    m_file = INVALID_HANDLE_VALUE;
+    m_mapping = NULL;
+#else
+    m_file = -1;
+#endif
+}
+
+cPackage_Archive::~cPackage_Archive(void)
+{
+    Close();
+}
+
+bool cPackage_Archive::Open(const fs::path& filename, const fs::path& mount_dir)
+{
+    Close();
+
+    m_filename = filename;
+    m_mount_dir = mount_dir;
+    m_mount_prefix = Get_Normalized_Path(mount_dir);
+
+    if (m_mount_prefix.empty() || m_mount_prefix[m_mount_prefix.length() - 1] != '/') {
+        m_mount_prefix += '/';
+    }
+
+#ifdef _WIN32
+    m_file = CreateFileW(filename.native().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (m_file == INVALID_HANDLE_VALUE) {
+        cerr << "Warning : Could not open package archive " << path_to_utf8(filename) << endl;
+        return 0;
+    }
+
+    LARGE_INTEGER file_size;
+
+    if (!GetFileSizeEx(m_file, &file_size) || file_size.QuadPart == 0) {
+        cerr << "Warning : Package archive " << path_to_utf8(filename) << " is empty" << endl;
+        Close();
+        return 0;
+    }
+
+    m_size = static_cast<size_t>(file_size.QuadPart);
+    m_mapping = CreateFileMapping(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (m_mapping) {
+        m_data = static_cast<const Uint8*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    m_file = open(filename.c_str(), O_RDONLY);
+
+    if (m_file < 0) {
+        cerr << "Warning : Could not open package archive " << path_to_utf8(filename) << endl;
+        return 0;
+    }
+
+    struct stat file_stat;
+
+    if (fstat(m_file, &file_stat) != 0 || file_stat.st_size == 0) {
+        cerr << "Warning : Package archive " << path_to_utf8(filename) << " is empty" << endl;
+        Close();
+        return 0;
+    }
+
+    m_size = static_cast<size_t>(file_stat.st_size);
+    void* data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+
+    if (data != MAP_FAILED) {
+        m_data = static_cast<const Uint8*>(data);
+    }
+#endif
+
+    if (!m_data) {
+        cerr << "Warning : Could not map package archive " << path_to_utf8(filename) << endl;
+        Close();
+        return 0;
+    }
+
+    // header
+    const size_t magic_length = strlen(package_archive_magic);
+    cArchive_Data_Reader reader(m_data, m_size);
+
+    if (m_size < magic_length || memcmp(m_data, package_archive_magic, magic_length) != 0 || !reader.Skip(magic_length) || reader.Read_Uint32() != package_archive_version) {
+        cerr << "Warning : " << path_to_utf8(filename) << " is not a supported package archive" << endl;
+        Close();
+        return 0;
+    }
+
+    // table of contents
+    const Uint32 count = reader.Read_Uint32();
+
+    for (Uint32 i = 0; i < count && reader.m_good; i++) {
+        cEntry entry;
+        entry.m_path = reader.Read_String();
+        entry.m_offset = reader.Read_Uint32();
+        entry.m_size = reader.Read_Uint32();
+        entry.m_stored_size = reader.Read_Uint32();
+        entry.m_flags = reader.Read_Uint8();
+
+        // outside of the file
+        if (entry.m_offset > m_size || entry.m_stored_size > m_size - entry.m_offset) {
+            reader.m_good = 0;
+            break;
+        }
+
+        // the binary search needs the order
+        if (!m_entries.empty() && !(m_entries.back().m_path < entry.m_path)) {
+            reader.m_good = 0;
+            break;
+        }
+
+        m_entries.push_back(entry);
+    }
+
+    if (!reader.m_good) {
+        cerr << "Warning : Package archive " << path_to_utf8(filename) << " is corrupted" << endl;
+        Close();
+        return 0;
+    }
+
+    return 1;
+}
+
+void cPackage_Archive::Close(void)
+{
+#ifdef _WIN32
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+        m_mapping = NULL;
+    }
+
+    if (m_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (m_data) {
+        munmap(const_cast<Uint8*>(m_data), m_size);
+    }
+
+    if (m_file >= 0) {
+        close(m_file);
+        m_file = -1;
+    }
+#endif
+
+    m_data = NULL;
+    m_size = 0;
+    m_entries.clear();
+}
+
+const cPackage_Archive::cEntry* cPackage_Archive::Find(const fs::path& filename) const
+{
+    std::string entry_path;
+
+    if (!Get_Entry_Path(filename, entry_path)) {
+        return NULL;
+    }
+
+    vector<cEntry>::const_iterator itr = std::lower_bound(m_entries.begin(), m_entries.end(), entry_path, package_archive_entry_less());
+
+    if (itr == m_entries.end() || itr->m_path != entry_path) {
+        return NULL;
+    }
+
+    return &(*itr);
+}
+
+bool cPackage_Archive::Has_Directory(const fs::path& dir) const
+{
+    std::string prefix;
+
+    if (!Get_Entry_Path(dir, prefix)) {
+        return 0;
+    }
+
+    // the mount directory
+    if (prefix.empty()) {
+        return !m_entries.empty();
+    }
+
+    prefix += '/';
+    vector<cEntry>::const_iterator itr = std::lower_bound(m_entries.begin(), m_entries.end(), prefix, package_archive_entry_less());
+
+    return itr != m_entries.end() && itr->m_path.compare(0, prefix.length(), prefix) == 0;
+}
+
+void cPackage_Archive::Get_Files(const fs::path& dir, const std::string& file_type, vector<fs::path>& files) const
+{
+    std::string prefix;
+
+    if (!Get_Entry_Path(dir, prefix)) {
+        return;
+    }
+
+    if (!prefix.empty()) {
+        prefix += '/';
+    }
+
+    // the directory entries follow each other
+    for (vector<cEntry>::const_iterator itr = std::lower_bound(m_entries.begin(), m_entries.end(), prefix, package_archive_entry_less()); itr != m_entries.end(); ++itr) {
+        const std::string& path = itr->m_path;
+
+        if (path.compare(0, prefix.length(), prefix) != 0) {
+            break;
+        }
+
+        // in a sub-directory
+        if (path.find('/', prefix.length()) != std::string::npos) {
+            continue;
+        }
+
+        if (!file_type.empty() && (path.length() < file_type.length() || path.compare(path.length() - file_type.length(), file_type.length(), file_type) != 0)) {
+            continue;
+        }
+
+        files.push_back(dir / utf8_to_path(path.substr(prefix.length())));
+    }
+}
+
+const Uint8* cPackage_Archive::Get_Data(const cEntry* entry, vector<Uint8>& buffer) const
+{
+    const Uint8* data = m_data + entry->m_offset;
+
+    if (!(entry->m_flags & PACKAGE_ARCHIVE_COMPRESSED)) {
+        return data;
+    }
+
+    buffer.resize(entry->m_size + 1);
+    uLongf size = entry->m_size;
+
+    if (uncompress(&buffer[0], &size, data, entry->m_stored_size) != Z_OK || size != entry->m_size) {
+        cerr << "Warning : Could not decompress " << entry->m_path << " of package archive " << path_to_utf8(m_filename) << endl;
+        return NULL;
+    }
+
+    return &buffer[0];
+}
+
+SDL_RWops* cPackage_Archive::Open_RW(const cEntry* entry) const
+{
+    if (!(entry->m_flags & PACKAGE_ARCHIVE_COMPRESSED)) {
+        return SDL_RWFromConstMem(m_data + entry->m_offset, entry->m_size);
+    }
+
+    // owned by the read operation
+    Uint8* data = new Uint8[entry->m_size + 1];
+    uLongf size = entry->m_size;
+
+    if (uncompress(data, &size, m_data + entry->m_offset, entry->m_stored_size) != Z_OK || size != entry->m_size) {
+        cerr << "Warning : Could not decompress " << entry->m_path << " of package archive " << path_to_utf8(m_filename) << endl;
+        delete[] data;
+        return NULL;
+    }
+
+    SDL_RWops* rw = SDL_RWFromConstMem(data, entry->m_size);
+
+    if (!rw) {
+        delete[] data;
+        return NULL;
+    }
+
+    rw->close = Package_Archive_RW_Close;
+    return rw;
+}
+
+bool cPackage_Archive::Create(const fs::path& dir, const fs::path& filename, bool compress /* = 1 */)
+{
+    if (!Dir_Exists(dir)) {
+        cerr << "Error : Package directory " << path_to_utf8(dir) << " not found" << endl;
+        return 0;
+    }
+
+    vector<fs::path> files = Get_Directory_Files(dir);
+    vector<cEntry> entries;
+    vector<vector<Uint8> > entry_data;
+
+    for (vector<fs::path>::const_iterator itr = files.begin(); itr != files.end(); ++itr) {
+        const fs::path& file = (*itr);
+
+        cEntry entry;
+        entry.m_path = fs::relative(dir, file).generic_string();
+        entry.m_offset = 0;
+        entry.m_flags = 0;
+
+        fs::ifstream ifs(file, ios::in | ios::binary);
+
+        if (!ifs.is_open()) {
+            cerr << "Error : Could not read " << path_to_utf8(file) << endl;
+            return 0;
+        }
+
+        vector<Uint8> data((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+
+        // sizes and offsets are stored as 32 bit
+        if (data.size() > 0xFFFFFFFFUL) {
+            cerr << "Error : " << path_to_utf8(file) << " is too large for a package archive" << endl;
+            return 0;
+        }
+
+        entry.m_size = data.size();
+
+        if (compress && !data.empty()) {
+            uLongf size = compressBound(data.size());
+            vector<Uint8> compressed(size);
+
+            if (compress2(&compressed[0], &size, &data[0], data.size(), Z_BEST_COMPRESSION) == Z_OK && size < data.size() * (1.0f - package_archive_min_compression)) {
+                compressed.resize(size);
+                data.swap(compressed);
+                entry.m_flags |= PACKAGE_ARCHIVE_COMPRESSED;
+            }
+        }
+
+        entry.m_stored_size = data.size();
+        entries.push_back(entry);
+        entry_data.push_back(vector<Uint8>());
+        entry_data.back().swap(data);
+    }
+
+    // sort the table of contents
+    vector<std::pair<std::string, unsigned int> > order;
+
+    for (unsigned int i = 0; i < entries.size(); i++) {
+        order.push_back(std::make_pair(entries[i].m_path, i));
+    }
+
+    std::sort(order.begin(), order.end());
+
+    // the data follows the table of contents
+    Uint64 offset = strlen(package_archive_magic) + 4 + 4;
+
+    for (unsigned int i = 0; i < entries.size(); i++) {
+        offset += 4 + entries[i].m_path.length() + 4 + 4 + 4 + 1;
+    }
+
+    for (unsigned int i = 0; i < order.size(); i++) {
+        cEntry& entry = entries[order[i].second];
+        entry.m_offset = static_cast<Uint32>(offset);
+        offset += entry.m_stored_size;
+    }
+
+    // offsets are stored as 32 bit
+    if (offset > 0xFFFFFFFFULL) {
+        cerr << "Error : Package directory " << path_to_utf8(dir) << " is too large for a package archive (4 GB at most)" << endl;
+        return 0;
+    }
+
+    cBinary_Writer writer(filename, package_archive_magic, package_archive_version);
+    writer.Write_Uint32(entries.size());
+
+    for (unsigned int i = 0; i < order.size(); i++) {
+        const cEntry& entry = entries[order[i].second];
+
+        writer.Write_String(entry.m_path);
+        writer.Write_Uint32(entry.m_offset);
+        writer.Write_Uint32(entry.m_size);
+        writer.Write_Uint32(entry.m_stored_size);
+        writer.Write_Uint8(entry.m_flags);
+    }
+
+    for (unsigned int i = 0; i < order.size(); i++) {
+        const vector<Uint8>& data = entry_data[order[i].second];
+
+        if (!data.empty()) {
+            writer.Write_Data(&data[0], data.size());
+        }
+    }
+
+    if (!writer.Finish()) {
+        cerr << "Error : Could not write package archive " << path_to_utf8(filename) << endl;
+        return 0;
+    }
+
+    cout << "Created package archive " << path_to_utf8(filename) << " with " << entries.size() << " files" << endl;
+    return 1;
+}
+
+bool cPackage_Archive::Get_Entry_Path(const fs::path& filename, std::string& entry_path) const
+{
+    const std::string path = Get_Normalized_Path(filename);
+
+    // the mount directory itself
+    if (path.length() + 1 == m_mount_prefix.length() && m_mount_prefix.compare(0, path.length(), path) == 0) {
+        entry_path.clear();
+        return 1;
+    }
+
+    if (path.compare(0, m_mount_prefix.length(), m_mount_prefix) != 0) {
+        return 0;
+    }
+
+    entry_path = path.substr(m_mount_prefix.length());
+    return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
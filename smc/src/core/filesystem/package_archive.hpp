@@ -0,0 +1,129 @@
+/***************************************************************************
+ * package_archive.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_PACKAGE_ARCHIVE_HPP
+#define SMC_PACKAGE_ARCHIVE_HPP
+
+#include "../../core/global_basic.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** Package archive entry flags *** *** *** *** *** *** *** *** *** *** */
+
+    enum Package_Archive_Flag {
+        // the data is zlib compressed
+        PACKAGE_ARCHIVE_COMPRESSED = 1
+    };
+
+    /* *** *** *** *** *** *** *** cPackage_Archive *** *** *** *** *** *** *** *** *** *** */
+
+    /* A package stored in a single memory mapped file
+     * The files of the archive appear below the mount directory. The table of contents
+     * is sorted by the entry path so a file is found with a binary search instead of
+     * probing the disk. Entries are stored uncompressed or zlib compressed.
+     *
+     * File format (little-endian, written with cBinary_Writer):
+     * - magic "SMCPAKAR", format version
+     * - entry count
+     * - entries sorted by path : path string, data offset, size, stored size, flags
+     * - entry data
+    */
+    class cPackage_Archive {
+    public:
+        cPackage_Archive(void);
+        ~cPackage_Archive(void);
+
+        struct cEntry {
+            // path below the mount directory with "/" separators
+            std::string m_path;
+            // data position in the archive file
+            Uint32 m_offset;
+            // uncompressed size
+            Uint32 m_size;
+            // size in the archive file
+            Uint32 m_stored_size;
+            // Package_Archive_Flag
+            Uint8 m_flags;
+        };
+
+        /* Map the archive file
+         * mount_dir : directory the archive files appear in
+         * returns false if it is not a valid archive
+        */
+        bool Open(const boost::filesystem::path& filename, const boost::filesystem::path& mount_dir);
+        // Unmap the archive file
+        void Close(void);
+
+        // Return the entry of the file or NULL if not in the archive
+        const cEntry* Find(const boost::filesystem::path& filename) const;
+        // Return true if the archive has files in the directory
+        bool Has_Directory(const boost::filesystem::path& dir) const;
+        /* Add the files of the directory without sub-directories
+         * file_type : if set only files with this extension (with dot)
+        */
+        void Get_Files(const boost::filesystem::path& dir, const std::string& file_type, vector<boost::filesystem::path>& files) const;
+
+        /* Return the data of the entry
+         * Uncompressed data points into the mapped file. Compressed data is inflated
+         * into the buffer. Returns NULL if the data is corrupted.
+        */
+        const Uint8* Get_Data(const cEntry* entry, vector<Uint8>& buffer) const;
+        /* Open the entry data for SDL loaders
+         * The caller must close it. Returns NULL if the data is corrupted.
+        */
+        SDL_RWops* Open_RW(const cEntry* entry) const;
+
+        /* Create an archive with the files of the directory
+         * compress : compress the entries which get smaller
+         * returns true on success
+        */
+        static bool Create(const boost::filesystem::path& dir, const boost::filesystem::path& filename, bool compress = 1);
+
+        // archive file
+        boost::filesystem::path m_filename;
+        // directory the files appear in
+        boost::filesystem::path m_mount_dir;
+
+    private:
+        /* Get the entry path of the file
+         * returns false if it is not below the mount directory
+        */
+        bool Get_Entry_Path(const boost::filesystem::path& filename, std::string& entry_path) const;
+
+        // normalized mount directory with a trailing separator
+        std::string m_mount_prefix;
+        // sorted by path
+        vector<cEntry> m_entries;
+
+        // mapped archive file
+        const Uint8* m_data;
+        size_t m_size;
+#ifdef _WIN32
+        HANDLE m_file;
+        HANDLE m_mapping;
+#else
+        int m_file;
+#endif
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
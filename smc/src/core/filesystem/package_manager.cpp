@@ -126,6 +126,11 @@ cPackage_Manager :: cPackage_Manager(void)
 
 cPackage_Manager :: ~cPackage_Manager(void)
 {
+    for (std::vector<cPackage_Archive*>::iterator it = m_archives.begin(); it != m_archives.end(); ++it) {
+        delete *it;
+    }
+
+    m_archives.clear();
 }
 
 static bool operator< (const PackageInfo& p1, const PackageInfo& p2)
@@ -225,19 +230,19 @@ fs::path cPackage_Manager :: Get_Menu_Level_Path(void)
         level = level + ".smclvl";
 
         result = Get_User_Level_Path() / level;
-        if (fs::exists(result))
+        if (Resource_Exists(result))
             return result;
 
         result = Get_Game_Level_Path() / level;
-        if (fs::exists(result))
+        if (Resource_Exists(result))
             return result;
 
         result = pResource_Manager->Get_User_Level_Directory() / level;
-        if (fs::exists(result))
+        if (Resource_Exists(result))
             return result;
 
         result = pResource_Manager->Get_Game_Level_Directory() / level;
-        if (fs::exists(result))
+        if (Resource_Exists(result))
             return result;
     }
 
@@ -248,11 +253,11 @@ fs::path cPackage_Manager :: Get_Menu_Level_Path(void)
             level = level + ".smclvl";
 
             result = Get_User_Level_Path() / level;
-            if (fs::exists(result))
+            if (Resource_Exists(result))
                 return result;
 
             result = Get_Game_Level_Path() / level;
-            if (fs::exists(result))
+            if (Resource_Exists(result))
                 return result;
         }
     }
@@ -261,7 +266,7 @@ fs::path cPackage_Manager :: Get_Menu_Level_Path(void)
     level = pPreferences->m_menu_level_default + ".smclvl";
 
     result = pResource_Manager->Get_User_Level_Directory() / level;
-    if (fs::exists(result))
+    if (Resource_Exists(result))
         return result;
 
     return pResource_Manager->Get_Game_Level_Directory() / level;
@@ -366,6 +371,93 @@ fs::path cPackage_Manager :: Get_Relative_Music_Path(fs::path path)
     return Find_Relative_Path("music", path);
 }
 
+bool cPackage_Manager :: Resource_Exists(const fs::path& path) const
+{
+    const cPackage_Archive* archive;
+    if (Find_Archive_Entry(path, &archive))
+        return true;
+
+    return fs::exists(path);
+}
+
+bool cPackage_Manager :: Resource_Dir_Exists(const fs::path& dir) const
+{
+    for (std::vector<cPackage_Archive*>::const_iterator it = m_archives.begin(); it != m_archives.end(); ++it) {
+        if ((*it)->Has_Directory(dir))
+            return true;
+    }
+
+    return Dir_Exists(dir);
+}
+
+vector<fs::path> cPackage_Manager :: Get_Resource_Files(const fs::path& dir, const std::string& file_type /* = "" */) const
+{
+    vector<fs::path> files;
+
+    for (std::vector<cPackage_Archive*>::const_iterator it = m_archives.begin(); it != m_archives.end(); ++it) {
+        (*it)->Get_Files(dir, file_type, files);
+    }
+
+    if (Dir_Exists(dir)) {
+        const vector<fs::path> dir_files = Get_Directory_Files(dir, file_type, false, false);
+
+        // files in an archive are only added once
+        for (vector<fs::path>::const_iterator it = dir_files.begin(); it != dir_files.end(); ++it) {
+            if (!Is_Archived(*it))
+                files.push_back(*it);
+        }
+    }
+
+    return files;
+}
+
+bool cPackage_Manager :: Is_Archived(const fs::path& path) const
+{
+    const cPackage_Archive* archive;
+    return Find_Archive_Entry(path, &archive) != NULL;
+}
+
+std::time_t cPackage_Manager :: Get_Resource_Write_Time(const fs::path& path) const
+{
+    const cPackage_Archive* archive;
+    fs::path filename = path;
+    if (Find_Archive_Entry(path, &archive))
+        filename = archive->m_filename;
+
+    boost::system::error_code ec;
+    std::time_t time = fs::last_write_time(filename, ec);
+    if (ec)
+        return 0;
+
+    return time;
+}
+
+bool cPackage_Manager :: Read_Archive_File(const fs::path& path, std::string& data) const
+{
+    const cPackage_Archive* archive;
+    const cPackage_Archive::cEntry* entry = Find_Archive_Entry(path, &archive);
+    if (!entry)
+        return false;
+
+    vector<Uint8> buffer;
+    const Uint8* entry_data = archive->Get_Data(entry, buffer);
+    if (!entry_data)
+        return false;
+
+    data.assign(reinterpret_cast<const char*>(entry_data), entry->m_size);
+    return true;
+}
+
+SDL_RWops* cPackage_Manager :: Open_Resource_RW(const fs::path& path) const
+{
+    const cPackage_Archive* archive;
+    const cPackage_Archive::cEntry* entry = Find_Archive_Entry(path, &archive);
+    if (entry)
+        return archive->Open_RW(entry);
+
+    return SDL_RWFromFile(path_to_utf8(path).c_str(), "rb");
+}
+
 void cPackage_Manager :: Scan_Packages( fs::path base, fs::path path, bool user_packages )
 {
     fs::path subdir(base / path);
@@ -378,6 +470,9 @@ void cPackage_Manager :: Scan_Packages( fs::path base, fs::path path, bool user_
                 // Determine package name and load info
                 Load_Package_Info(entry, user_packages);
             }
+            else if(entry.extension() == fs::path(".smcpak")) {
+                Mount_Package_Archive(entry, user_packages);
+            }
             else {
                 Scan_Packages( base, path / entry.filename(), user_packages );
             }
@@ -385,17 +480,45 @@ void cPackage_Manager :: Scan_Packages( fs::path base, fs::path path, bool user_
     }
 }
 
+void cPackage_Manager :: Mount_Package_Archive( const fs::path& filename, bool user_package )
+{
+    fs::path dir = filename;
+    dir.replace_extension(".smcpkg");
+
+    /* Loose package directories are used while developing
+     * The directory of a user package archive also holds its user data
+     * like levels and savegames but no package.xml.
+     */
+    if(File_Exists(dir / "package.xml")) {
+        cout << "Warning: package archive ignored as the package directory exists: " << filename << endl;
+        return;
+    }
+
+    cPackage_Archive* archive = new cPackage_Archive();
+    if(!archive->Open(filename, dir)) {
+        delete archive;
+        return;
+    }
+
+    m_archives.push_back(archive);
+    Load_Package_Info(dir, user_package);
+}
+
 void cPackage_Manager :: Load_Package_Info( const fs::path& dir, bool user_package )
 {
     // Read package information
     fs::path file = dir / "package.xml";
-    if(!File_Exists(file)) {
+    if(!Resource_Exists(file)) {
         cout << "Warning: packages without 'package.xml' will be ignored: " << dir << endl;
         return;
     }
 
     cPackage_Loader loader;
-    loader.parse_file(file);
+    std::string data;
+    if(Read_Archive_File(file, data))
+        loader.parse_memory_raw(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    else
+        loader.parse_file(file);
 
     // Examine name and create package if it doesn't exist
     PackageInfo info = loader.Get_Package_Info();
@@ -525,13 +648,13 @@ fs::path cPackage_Manager :: Find_Reading_Path(fs::path dir, fs::path resource,
     fs::path path;
     for (std::vector<fs::path>::const_iterator it = m_search_path.begin(); it != m_search_path.end(); ++it) {
         path = *it / dir / resource;
-        if (fs::exists(path)) {
+        if (Resource_Exists(path)) {
             return path;
         }
         else {
             for (std::vector<std::string>::const_iterator it_ext = extra_ext.begin(); it_ext != extra_ext.end(); ++it_ext) {
                 path.replace_extension(*it_ext);
-                if (fs::exists(path)) {
+                if (Resource_Exists(path)) {
                     return path;
                 }
             }
@@ -568,6 +691,19 @@ fs::path cPackage_Manager :: Find_Relative_Path(fs::path dir, fs::path path)
     return fs::path();
 }
 
+const cPackage_Archive::cEntry* cPackage_Manager :: Find_Archive_Entry(const fs::path& path, const cPackage_Archive** archive) const
+{
+    for (std::vector<cPackage_Archive*>::const_iterator it = m_archives.begin(); it != m_archives.end(); ++it) {
+        const cPackage_Archive::cEntry* entry = (*it)->Find(path);
+        if (entry) {
+            *archive = *it;
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
 //
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -19,6 +19,7 @@
 #include "../../core/global_basic.hpp"
 #include "../../core/global_game.hpp"
 #include "../../core/xml_attributes.hpp"
+#include "../../core/filesystem/package_archive.hpp"
 
 namespace SMC {
 
@@ -114,9 +115,36 @@ namespace SMC {
         boost::filesystem::path Get_Relative_Sound_Path(boost::filesystem::path path);
         boost::filesystem::path Get_Relative_Music_Path(boost::filesystem::path path);
 
+        /* Resources are read from the mounted package archives or the disk
+         * An archive "name.smcpak" appears as the package directory "name.smcpkg" in the
+         * same directory. Loose files in the user data directory still overlay it as the
+         * user directories come first in the search path.
+        */
+        // Returns true if the file is in an archive or on the disk
+        bool Resource_Exists(const boost::filesystem::path& path) const;
+        // Returns true if the directory has files in an archive or is on the disk
+        bool Resource_Dir_Exists(const boost::filesystem::path& dir) const;
+        /* Return the files of the directory in the archives and on the disk
+         * file_type : if set only files with this extension (with dot)
+        */
+        vector<boost::filesystem::path> Get_Resource_Files(const boost::filesystem::path& dir, const std::string& file_type = "") const;
+        // Returns true if the file is in an archive
+        bool Is_Archived(const boost::filesystem::path& path) const;
+        // Return the modification time of the file or its archive or 0 if not found
+        std::time_t Get_Resource_Write_Time(const boost::filesystem::path& path) const;
+        /* Read the file from an archive
+         * returns false if it is not in an archive or corrupted
+        */
+        bool Read_Archive_File(const boost::filesystem::path& path, std::string& data) const;
+        /* Open the file from an archive or the disk for SDL loaders
+         * The caller must close it. Returns NULL on failure.
+        */
+        SDL_RWops* Open_Resource_RW(const boost::filesystem::path& path) const;
+
 
     private:
         void Scan_Packages(boost::filesystem::path base, boost::filesystem::path path, bool user_packages );
+        void Mount_Package_Archive( const boost::filesystem::path& filename, bool user_package );
         void Load_Package_Info( const boost::filesystem::path& dir, bool user_package );
         void Fix_Package_Paths( void );
         void Build_Search_Path( void );
@@ -124,11 +152,15 @@ namespace SMC {
 
         boost::filesystem::path Find_Reading_Path(boost::filesystem::path dir, boost::filesystem::path resource, std::vector<std::string> extra_ext);
         boost::filesystem::path Find_Relative_Path(boost::filesystem::path dir, boost::filesystem::path path);
+        // Return the archive entry of the file or NULL
+        const cPackage_Archive::cEntry* Find_Archive_Entry(const boost::filesystem::path& path, const cPackage_Archive** archive) const;
 
         std::map <std::string, PackageInfo> m_packages;
         std::string m_current_package;
         std::vector<boost::filesystem::path> m_search_path;
         int m_package_start;
+        // mounted package archives
+        std::vector<cPackage_Archive*> m_archives;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
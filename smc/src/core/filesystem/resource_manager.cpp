@@ -144,6 +144,11 @@ fs::path cResource_Manager::Get_User_Imgcache_Directory()
     return m_paths.user_cache_dir / utf8_to_path(USER_IMGCACHE_DIR);
 }
 
+fs::path cResource_Manager::Get_User_Cache_Directory()
+{
+    return m_paths.user_cache_dir;
+}
+
 fs::path cResource_Manager::Get_User_CEGUI_Logfile()
 {
     return m_paths.user_cache_dir / utf8_to_path("cegui.log");
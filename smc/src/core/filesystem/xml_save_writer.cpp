@@ -0,0 +1,143 @@
+/***************************************************************************
+ * xml_save_writer.cpp  -  background writing of save documents
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../../core/filesystem/xml_save_writer.hpp"
+#include "../../core/game_core.hpp"
+#include "../../core/property_helper.hpp"
+#include "../../gui/hud.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace SMC {
+
+/* *** *** *** *** *** *** *** cXml_Save_Writer *** *** *** *** *** *** *** *** *** *** */
+
+cXml_Save_Writer::cXml_Save_Writer(void)
+{
+    m_last_job = 0;
+}
+
+cXml_Save_Writer::~cXml_Save_Writer(void)
+{
+    // never drop a save
+    Wait();
+}
+
+void cXml_Save_Writer::Write(xmlpp::Document* doc, const fs::path& filename, const std::string& done_text, const std::string& error_text, const fs::path& remove_filename /* = fs::path() */)
+{
+    m_last_job = pJob_System->Add(new cSave_Job(doc, filename, done_text, error_text, remove_filename), m_last_job);
+}
+
+void cXml_Save_Writer::Wait(void)
+{
+    // the previous saves ran before
+    pJob_System->Wait(m_last_job);
+    m_last_job = 0;
+}
+
+bool cXml_Save_Writer::Is_Busy(void)
+{
+    return !pJob_System->Is_Finished(m_last_job);
+}
+
+bool cXml_Save_Writer::Write_File(xmlpp::Document* doc, const fs::path& filename, std::string& error)
+{
+    fs::path temp_filename = filename;
+    temp_filename += fs::path(".tmp");
+
+    try {
+        doc->write_to_file_formatted(Glib::filename_from_utf8(path_to_utf8(temp_filename)));
+    }
+    catch (xmlpp::exception& e) {
+        error = e.what();
+
+        boost::system::error_code ec;
+        fs::remove(temp_filename, ec);
+        return 0;
+    }
+
+    // replace the old file
+    boost::system::error_code ec;
+    fs::rename(temp_filename, filename, ec);
+
+    if (ec) {
+        error = ec.message();
+
+        fs::remove(temp_filename, ec);
+        return 0;
+    }
+
+    return 1;
+}
+
+/* *** *** *** *** *** *** *** cXml_Save_Writer::cSave_Job *** *** *** *** *** *** *** *** *** *** */
+
+cXml_Save_Writer::cSave_Job::cSave_Job(xmlpp::Document* doc, const fs::path& filename, const std::string& done_text, const std::string& error_text, const fs::path& remove_filename)
+    : cJob("save", JOB_PRIORITY_HIGH)
+{
+    m_doc = doc;
+    m_filename = filename;
+    m_remove_filename = remove_filename;
+    m_done_text = done_text;
+    m_error_text = error_text;
+    m_written = 0;
+}
+
+cXml_Save_Writer::cSave_Job::~cSave_Job(void)
+{
+    delete m_doc;
+}
+
+void cXml_Save_Writer::cSave_Job::Run(void)
+{
+    m_written = Write_File(m_doc, m_filename, m_error);
+
+    if (m_written && !m_remove_filename.empty()) {
+        boost::system::error_code ec;
+        fs::remove(m_remove_filename, ec);
+    }
+
+    delete m_doc;
+    m_doc = NULL;
+}
+
+void cXml_Save_Writer::cSave_Job::Finish(bool canceled)
+{
+    if (!m_written) {
+        if (m_error.empty()) {
+            m_error = "canceled";
+        }
+
+        cerr << "Error: Couldn't save file " << path_to_utf8(m_filename) << " : " << m_error << endl;
+        cerr << "Is the file read-only?" << endl;
+    }
+    else {
+        debug_print("Wrote file '%s'.\n", path_to_utf8(m_filename).c_str());
+    }
+
+    const std::string& text = m_written ? m_done_text : m_error_text;
+
+    if (pHud_Debug && !text.empty()) {
+        pHud_Debug->Set_Text(text, speedfactor_fps * 5.0f);
+    }
+}
+
+cXml_Save_Writer* pSave_Writer = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,87 @@
+/***************************************************************************
+ * xml_save_writer.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_XML_SAVE_WRITER_HPP
+#define SMC_XML_SAVE_WRITER_HPP
+
+#include "../../core/global_basic.hpp"
+#include "../../core/job_system.hpp"
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** cXml_Save_Writer *** *** *** *** *** *** *** *** *** *** */
+
+    /* Writes save documents with the job system
+     * The document is created on the main thread and only contains copied values so
+     * the game can continue while it is encoded and written. Each save job depends on
+     * the previous one to keep the write order. The file is written to a temporary
+     * file which replaces the target so an interrupted save never leaves a truncated
+     * file behind. The results are shown in the debug hud by the job continuation.
+    */
+    class cXml_Save_Writer {
+    public:
+        cXml_Save_Writer(void);
+        // waits for the queued documents to be written
+        ~cXml_Save_Writer(void);
+
+        /* Write the document in the background
+         * The writer takes ownership of the document.
+         * done_text : hud text shown if written
+         * error_text : hud text shown if writing failed
+         * remove_filename : file removed if written or empty
+        */
+        void Write(xmlpp::Document* doc, const boost::filesystem::path& filename, const std::string& done_text, const std::string& error_text, const boost::filesystem::path& remove_filename = boost::filesystem::path());
+        // Wait until all queued documents are written
+        void Wait(void);
+        // Check if documents are queued or being written
+        bool Is_Busy(void);
+
+        /* Write the document to a temporary file and replace the target with it
+         * returns true on success
+        */
+        static bool Write_File(xmlpp::Document* doc, const boost::filesystem::path& filename, std::string& error);
+
+    private:
+        class cSave_Job : public cJob {
+        public:
+            cSave_Job(xmlpp::Document* doc, const boost::filesystem::path& filename, const std::string& done_text, const std::string& error_text, const boost::filesystem::path& remove_filename);
+            virtual ~cSave_Job(void);
+
+            virtual void Run(void);
+            virtual void Finish(bool canceled);
+
+            xmlpp::Document* m_doc;
+            boost::filesystem::path m_filename;
+            boost::filesystem::path m_remove_filename;
+            std::string m_done_text;
+            std::string m_error_text;
+            // written successfully
+            bool m_written;
+            // error message if writing failed
+            std::string m_error;
+        };
+
+        // the last added save job
+        Job_ID m_last_job;
+    };
+
+    // Save Writer
+    extern cXml_Save_Writer* pSave_Writer;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
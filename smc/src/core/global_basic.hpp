@@ -21,11 +21,6 @@
 #define _WIN32_IE 0x0500
 #endif
 
-/* uncomment to enable experimental rendering in a thread
-* still randomly crashes because gl functions are called while the render thread is active
-*/
-//#define SMC_RENDER_THREAD_TEST
-
 /* *** *** *** *** *** *** *** Debugging *** *** *** *** *** *** *** *** *** *** */
 
 #if defined(_MSC_VER) && defined(_DEBUG)
@@ -74,6 +69,7 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/convenience.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/chrono.hpp>
 #include <boost/system/error_code.hpp>
 #include "filesystem/boost_relative.hpp"
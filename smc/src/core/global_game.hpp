@@ -413,6 +413,7 @@ namespace SMC {
     class cLine_Request;
     class cLevel_Settings;
     class cMenu_Base;
+    class cMovingSprite;
     class cObjectCollisionType;
     class cObjectCollision;
     class cOverworld;
@@ -421,6 +422,7 @@ namespace SMC {
     class cPath;
     class cPath_State;
     class cRect_Request;
+    class cRender_Command_Queue;
     class cSave_Level_Object;
     class cSaved_Texture;
     class cSize_Float;
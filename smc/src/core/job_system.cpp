@@ -0,0 +1,377 @@
+/***************************************************************************
+ * job_system.cpp  -  worker threads running background jobs
+ *
+ * Copyright © 2005 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/job_system.hpp"
+#include "../core/math/utilities.hpp"
+
+using namespace std;
+
+namespace SMC {
+
+typedef boost::chrono::high_resolution_clock Job_Clock;
+
+// Return the milliseconds between the time points
+static inline double Get_Job_Ms(const Job_Clock::time_point& start, const Job_Clock::time_point& end)
+{
+    return boost::chrono::duration<double, boost::milli>(end - start).count();
+}
+
+/* *** *** *** *** *** *** *** cJob *** *** *** *** *** *** *** *** *** *** */
+
+cJob::cJob(const std::string& name, Job_Priority priority /* = JOB_PRIORITY_NORMAL */)
+    : m_canceled(0)
+{
+    m_name = name;
+    m_priority = priority;
+
+    m_id = 0;
+    m_state = JOB_WAITING;
+    m_dependency_count = 0;
+}
+
+cJob::~cJob(void)
+{
+    //
+}
+
+/* *** *** *** *** *** *** *** cJob_System *** *** *** *** *** *** *** *** *** *** */
+
+cJob_System::cJob_System(unsigned int worker_count /* = 0 */)
+{
+    m_quit = 0;
+    m_last_id = 0;
+
+    if (!worker_count) {
+        worker_count = Clamp<unsigned int>(boost::thread::hardware_concurrency(), 2, 9) - 1;
+    }
+
+    m_worker_count = worker_count;
+
+    for (unsigned int i = 0; i < m_worker_count; i++) {
+        m_workers.add_thread(new boost::thread(&cJob_System::Worker_Thread, this));
+    }
+}
+
+cJob_System::~cJob_System(void)
+{
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_quit = 1;
+
+        for (unsigned int i = 0; i < JOB_PRIORITY_SIZE; i++) {
+            m_queues[i].clear();
+        }
+    }
+
+    m_queue_cond.notify_all();
+    m_workers.join_all();
+
+    for (Job_Map::iterator itr = m_jobs.begin(); itr != m_jobs.end(); ++itr) {
+        delete itr->second;
+    }
+
+    m_jobs.clear();
+    m_done.clear();
+}
+
+Job_ID cJob_System::Add(cJob* job, Job_ID dependency /* = 0 */)
+{
+    vector<Job_ID> dependencies;
+
+    if (dependency) {
+        dependencies.push_back(dependency);
+    }
+
+    return Add(job, dependencies);
+}
+
+Job_ID cJob_System::Add(cJob* job, const vector<Job_ID>& dependencies)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    m_last_id++;
+
+    // skip no job
+    if (!m_last_id) {
+        m_last_id++;
+    }
+
+    job->m_id = m_last_id;
+    job->m_state = JOB_WAITING;
+    job->m_dependency_count = 0;
+    job->m_add_time = Job_Clock::now();
+
+    for (vector<Job_ID>::const_iterator itr = dependencies.begin(); itr != dependencies.end(); ++itr) {
+        Job_Map::iterator dep_itr = m_jobs.find(*itr);
+
+        // already finished
+        if (dep_itr == m_jobs.end()) {
+            continue;
+        }
+
+        cJob* dependency = dep_itr->second;
+
+        if (dependency->m_state != JOB_DONE) {
+            dependency->m_dependents.push_back(job->m_id);
+            job->m_dependency_count++;
+        }
+        // it did not provide its results
+        else if (dependency->m_canceled) {
+            job->m_canceled = 1;
+        }
+    }
+
+    m_jobs[job->m_id] = job;
+
+    if (job->m_canceled) {
+        Done_Locked(job);
+    }
+    else {
+        Queue_Locked(job);
+    }
+
+    return job->m_id;
+}
+
+void cJob_System::Cancel(Job_ID id)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    Job_Map::iterator itr = m_jobs.find(id);
+
+    if (itr == m_jobs.end()) {
+        return;
+    }
+
+    Cancel_Locked(itr->second);
+}
+
+void cJob_System::Wait(Job_ID id)
+{
+    cJob* job = NULL;
+
+    {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+
+        Job_Map::iterator itr = m_jobs.find(id);
+
+        if (itr == m_jobs.end()) {
+            return;
+        }
+
+        job = itr->second;
+
+        while (job->m_state != JOB_DONE) {
+            m_done_cond.wait(lock);
+        }
+
+        m_jobs.erase(itr);
+        m_done.erase(std::find(m_done.begin(), m_done.end(), id));
+    }
+
+    Finish_Job(job);
+}
+
+void cJob_System::Wait(const vector<Job_ID>& ids)
+{
+    for (vector<Job_ID>::const_iterator itr = ids.begin(); itr != ids.end(); ++itr) {
+        Wait(*itr);
+    }
+}
+
+bool cJob_System::Is_Finished(Job_ID id)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    return m_jobs.find(id) == m_jobs.end();
+}
+
+void cJob_System::Update(void)
+{
+    // one at a time as continuations may wait for or add jobs
+    while (1) {
+        cJob* job = NULL;
+
+        {
+            boost::lock_guard<boost::mutex> lock(m_mutex);
+
+            if (m_done.empty()) {
+                return;
+            }
+
+            const Job_ID id = m_done.front();
+            m_done.erase(m_done.begin());
+
+            Job_Map::iterator itr = m_jobs.find(id);
+            job = itr->second;
+            m_jobs.erase(itr);
+        }
+
+        Finish_Job(job);
+    }
+}
+
+unsigned int cJob_System::Get_Job_Count(void)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    return m_jobs.size();
+}
+
+void cJob_System::Get_Timings(vector<cJob_Timing>& timings)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    timings.clear();
+    timings.reserve(m_timings.size());
+
+    for (std::map<std::string, cJob_Timing>::const_iterator itr = m_timings.begin(); itr != m_timings.end(); ++itr) {
+        timings.push_back(itr->second);
+    }
+}
+
+void cJob_System::Worker_Thread(void)
+{
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+
+    while (1) {
+        cJob* job = NULL;
+
+        while (!m_quit) {
+            // highest priority first
+            for (int i = JOB_PRIORITY_SIZE - 1; i >= 0; i--) {
+                if (!m_queues[i].empty()) {
+                    job = m_queues[i].front();
+                    m_queues[i].pop_front();
+                    break;
+                }
+            }
+
+            if (job) {
+                break;
+            }
+
+            m_queue_cond.wait(lock);
+        }
+
+        if (m_quit) {
+            return;
+        }
+
+        job->m_state = JOB_RUNNING;
+
+        // run without blocking the other workers
+        lock.unlock();
+
+        const Job_Clock::time_point start = Job_Clock::now();
+        const bool run = !job->m_canceled;
+
+        if (run) {
+            job->Run();
+        }
+
+        const Job_Clock::time_point end = Job_Clock::now();
+
+        lock.lock();
+
+        if (run) {
+            cJob_Timing& timing = m_timings[job->m_name];
+
+            if (!timing.m_count) {
+                timing.m_name = job->m_name;
+                timing.m_max_ms = 0.0;
+                timing.m_total_ms = 0.0;
+            }
+
+            timing.m_count++;
+            timing.m_last_ms = Get_Job_Ms(start, end);
+            timing.m_max_ms = max(timing.m_max_ms, timing.m_last_ms);
+            timing.m_total_ms += timing.m_last_ms;
+            timing.m_wait_ms = Get_Job_Ms(job->m_add_time, start);
+        }
+
+        Done_Locked(job);
+    }
+}
+
+void cJob_System::Queue_Locked(cJob* job)
+{
+    if (job->m_state != JOB_WAITING || job->m_dependency_count) {
+        return;
+    }
+
+    job->m_state = JOB_QUEUED;
+    m_queues[job->m_priority].push_back(job);
+    m_queue_cond.notify_one();
+}
+
+void cJob_System::Cancel_Locked(cJob* job)
+{
+    job->m_canceled = 1;
+
+    if (job->m_state == JOB_QUEUED) {
+        Job_Queue& queue = m_queues[job->m_priority];
+        queue.erase(std::find(queue.begin(), queue.end(), job));
+        Done_Locked(job);
+    }
+    else if (job->m_state == JOB_WAITING) {
+        Done_Locked(job);
+    }
+    // running jobs release their dependents when done
+}
+
+void cJob_System::Done_Locked(cJob* job)
+{
+    job->m_state = JOB_DONE;
+    m_done.push_back(job->m_id);
+
+    for (vector<Job_ID>::const_iterator itr = job->m_dependents.begin(); itr != job->m_dependents.end(); ++itr) {
+        Job_Map::iterator dep_itr = m_jobs.find(*itr);
+
+        // already canceled and finished
+        if (dep_itr == m_jobs.end()) {
+            continue;
+        }
+
+        cJob* dependent = dep_itr->second;
+
+        if (dependent->m_state != JOB_WAITING) {
+            continue;
+        }
+
+        if (job->m_canceled) {
+            Cancel_Locked(dependent);
+        }
+        else {
+            dependent->m_dependency_count--;
+            Queue_Locked(dependent);
+        }
+    }
+
+    job->m_dependents.clear();
+    m_done_cond.notify_all();
+}
+
+void cJob_System::Finish_Job(cJob* job)
+{
+    job->Finish(job->m_canceled);
+    delete job;
+}
+
+cJob_System* pJob_System = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,207 @@
+/***************************************************************************
+ * job_system.h
+ *
+ * Copyright © 2005 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_JOB_SYSTEM_HPP
+#define SMC_JOB_SYSTEM_HPP
+
+#include "../core/global_basic.hpp"
+
+#include <deque>
+#include <boost/atomic.hpp>
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** Job priorities *** *** *** *** *** *** *** *** *** *** */
+
+    enum Job_Priority {
+        // work which may be needed later like prewarming
+        JOB_PRIORITY_LOW = 0,
+        JOB_PRIORITY_NORMAL = 1,
+        // work the game waits for like saves and loading
+        JOB_PRIORITY_HIGH = 2,
+        JOB_PRIORITY_SIZE = 3
+    };
+
+    /* *** *** *** *** *** *** *** Job states *** *** *** *** *** *** *** *** *** *** */
+
+    enum Job_State {
+        // waits for its dependencies
+        JOB_WAITING = 0,
+        // waits for a worker
+        JOB_QUEUED = 1,
+        JOB_RUNNING = 2,
+        // waits for its continuation in the main thread
+        JOB_DONE = 3
+    };
+
+    // identifies an added job, 0 is no job
+    typedef Uint32 Job_ID;
+
+    /* *** *** *** *** *** *** *** cJob *** *** *** *** *** *** *** *** *** *** */
+
+    /* Work run by the job system
+     * Run() is called in a worker thread and must only use data owned by the job or
+     * not changed until the job is finished. Finish() is called in the main thread
+     * afterwards to hand over the results.
+    */
+    class cJob {
+    public:
+        cJob(const std::string& name, Job_Priority priority = JOB_PRIORITY_NORMAL);
+        virtual ~cJob(void);
+
+        // Do the work in a worker thread
+        virtual void Run(void) = 0;
+        /* Continue in the main thread after Run()
+         * canceled : if the job was canceled before or while running
+        */
+        virtual void Finish(bool canceled) {};
+
+        // Returns true if canceled. Long running jobs should check it and stop early.
+        inline bool Is_Canceled(void) const
+        {
+            return m_canceled;
+        };
+
+        // name of the job timings
+        std::string m_name;
+        Job_Priority m_priority;
+
+    private:
+        friend class cJob_System;
+
+        Job_ID m_id;
+        Job_State m_state;
+        boost::atomic<bool> m_canceled;
+        // dependencies not yet run
+        unsigned int m_dependency_count;
+        // jobs waiting for this job
+        vector<Job_ID> m_dependents;
+        // time added to the job system
+        boost::chrono::high_resolution_clock::time_point m_add_time;
+    };
+
+    /* *** *** *** *** *** *** *** cJob_Timing *** *** *** *** *** *** *** *** *** *** */
+
+    // Run times of the jobs with the same name
+    struct cJob_Timing {
+        std::string m_name;
+        // jobs run
+        unsigned int m_count;
+        // milliseconds
+        double m_last_ms;
+        double m_max_ms;
+        double m_total_ms;
+        // milliseconds the last job waited for a worker
+        double m_wait_ms;
+    };
+
+    /* *** *** *** *** *** *** *** cJob_System *** *** *** *** *** *** *** *** *** *** */
+
+    /* Runs jobs in a pool of worker threads
+     * The workers take the queued jobs with the highest priority first. A job runs after
+     * all its dependencies ran and jobs depending on a canceled job are canceled too.
+     * Finish() of a job is called from Update() or Wait() in the main thread and the
+     * job is deleted afterwards. The run times of the jobs are kept by job name for the
+     * performance debug display.
+    */
+    class cJob_System {
+    public:
+        /* worker_count : number of worker threads
+         * 0 uses one less than the processor cores to keep one for the main thread
+        */
+        cJob_System(unsigned int worker_count = 0);
+        // cancels the not yet started jobs and deletes all jobs without continuation
+        ~cJob_System(void);
+
+        /* Add a job
+         * The job system takes the ownership of the job.
+         * dependency : job which must run before or 0
+         * returns the job id
+        */
+        Job_ID Add(cJob* job, Job_ID dependency = 0);
+        Job_ID Add(cJob* job, const vector<Job_ID>& dependencies);
+
+        /* Cancel the job and the jobs depending on it
+         * Not yet started jobs are not run. Running jobs see Is_Canceled().
+         * Finish() is still called.
+        */
+        void Cancel(Job_ID id);
+
+        /* Wait until the job ran and call its continuation
+         * Must only be called from the main thread.
+        */
+        void Wait(Job_ID id);
+        void Wait(const vector<Job_ID>& ids);
+
+        // Returns true if the job is finished or unknown
+        bool Is_Finished(Job_ID id);
+
+        // Call the continuations of the jobs which ran
+        void Update(void);
+
+        // Return the number of worker threads
+        inline unsigned int Get_Worker_Count(void) const
+        {
+            return m_worker_count;
+        };
+        // Return the number of jobs not yet finished
+        unsigned int Get_Job_Count(void);
+        // Get the job timings sorted by name
+        void Get_Timings(vector<cJob_Timing>& timings);
+
+    private:
+        typedef std::map<Job_ID, cJob*> Job_Map;
+        typedef std::deque<cJob*> Job_Queue;
+
+        // Worker thread
+        void Worker_Thread(void);
+        // Queue the job for the workers if no dependencies are left
+        void Queue_Locked(cJob* job);
+        // Cancel the job and its dependents
+        void Cancel_Locked(cJob* job);
+        // Set the job done and release its dependents
+        void Done_Locked(cJob* job);
+        // Remove the job and call its continuation
+        void Finish_Job(cJob* job);
+
+        boost::thread_group m_workers;
+        unsigned int m_worker_count;
+        boost::mutex m_mutex;
+        // signaled if a job was queued
+        boost::condition_variable m_queue_cond;
+        // signaled if a job is done
+        boost::condition_variable m_done_cond;
+        bool m_quit;
+
+        Job_ID m_last_id;
+        // all jobs not yet finished
+        Job_Map m_jobs;
+        // queued jobs for each priority
+        Job_Queue m_queues[JOB_PRIORITY_SIZE];
+        // done jobs in the order they ran
+        vector<Job_ID> m_done;
+
+        // timings by job name
+        std::map<std::string, cJob_Timing> m_timings;
+    };
+
+    // Job System
+    extern cJob_System* pJob_System;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -19,9 +19,11 @@
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/package_manager.hpp"
 #include "../core/filesystem/filesystem.hpp"
+#include "../core/filesystem/xml_save_writer.hpp"
 #include "../level/level.hpp"
 #include "../gui/menu.hpp"
 #include "../core/framerate.hpp"
+#include "../core/perf_counters.hpp"
 #include "../video/font.hpp"
 #include "../user/preferences.hpp"
 #include "../audio/sound_manager.hpp"
@@ -38,6 +40,12 @@
 #include "../video/renderer.hpp"
 #include "../core/i18n.hpp"
 #include "../gui/generic.hpp"
+#include "../core/benchmark.hpp"
+#include "../core/collision_broad_phase.hpp"
+#include "../core/job_system.hpp"
+#include "../objects/animated_sprite.hpp"
+#include "../scripting/bytecode_cache.hpp"
+#include "../level/level_library.hpp"
 
 using namespace std;
 
@@ -111,6 +119,9 @@ int main(int argc, char** argv)
                 cout << "-l, --level\tLoad the given level" << endl;
                 cout << "-w, --world\tLoad the given world" << endl;
                 cout << "-p, --package\tLoad the given package" << endl;
+                cout << "-b, --benchmark\tRun the given benchmark and exit" << endl;
+                cout << "-c, --collision\tSet the collision detection mode : serial threaded compare" << endl;
+                cout << "-a, --archive\tCreate a package archive of the given package directory and exit" << endl;
                 return EXIT_SUCCESS;
             }
             // version
@@ -156,6 +167,60 @@ int main(int argc, char** argv)
                 if (i + 1 < arguments.size())
                     g_cmdline_package = arguments[i + 1];
             }
+            // benchmark
+            else if (arguments[i] == "--benchmark" || arguments[i] == "-b") {
+                // no value
+                if (i + 1 >= arguments.size()) {
+                    cerr << arguments[i] << " requires a value" << endl;
+                    Print_Benchmarks();
+                    return EXIT_FAILURE;
+                }
+
+                return Run_Benchmark(arguments[i + 1]);
+            }
+            // collision detection mode
+            else if (arguments[i] == "--collision" || arguments[i] == "-c") {
+                // no value
+                if (i + 1 >= arguments.size()) {
+                    cerr << arguments[i] << " requires a value" << endl;
+                    return EXIT_FAILURE;
+                }
+
+                const std::string& mode = arguments[++i];
+
+                if (mode == "serial") {
+                    cCollision_Broad_Phase::m_mode = COLLISION_DETECTION_SERIAL;
+                }
+                else if (mode == "threaded") {
+                    cCollision_Broad_Phase::m_mode = COLLISION_DETECTION_THREADED;
+                }
+                else if (mode == "compare") {
+                    cCollision_Broad_Phase::m_mode = COLLISION_DETECTION_COMPARE;
+                }
+                else {
+                    cerr << "Unknown collision detection mode " << mode << endl;
+                    return EXIT_FAILURE;
+                }
+            }
+            // package archive
+            else if (arguments[i] == "--archive" || arguments[i] == "-a") {
+                // no value
+                if (i + 1 >= arguments.size()) {
+                    cerr << arguments[i] << " requires a value" << endl;
+                    return EXIT_FAILURE;
+                }
+
+                boost::filesystem::path dir = utf8_to_path(arguments[i + 1]);
+
+                // trailing separator
+                if (dir.filename() == boost::filesystem::path("."))
+                    dir.remove_filename();
+
+                boost::filesystem::path filename = dir;
+                filename.replace_extension(".smcpak");
+
+                return cPackage_Archive::Create(dir, filename) ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
             // level loading is handled later
             else if (arguments[i] == "--level" || arguments[i] == "-l") {
                 // skip
@@ -205,14 +270,12 @@ int main(int argc, char** argv)
         Draw_Game();
 
         // render
-#ifdef SMC_RENDER_THREAD_TEST
-        pVideo->Render(1);
-#else
-        pVideo->Render();
-#endif
+        pVideo->Render(pPreferences->m_video_render_thread);
 
         // update speedfactor
         pFramerate->Update();
+        // finish the frame counters
+        pPerf_Counters->End_Frame(pFramerate->m_elapsed_ticks);
     }
 
     Exit_Game();
@@ -229,17 +292,22 @@ void Init_Game(void)
 
     // Init Stage 1 - core classes
     debug_print("Initializing resource manager and core classes\n");
+    pJob_System = new cJob_System();
     pResource_Manager = new cResource_Manager();
     pPackage_Manager = new cPackage_Manager();
     pVideo = new cVideo();
     pAudio = new cAudio();
     pFont = new cFont_Manager();
     pFramerate = new cFramerate();
+    pPerf_Counters = new cPerf_Counters();
     pRenderer = new cRenderQueue(200);
     pRenderer_current = new cRenderQueue(200);
     pImage_Manager = new cImage_Manager();
+    pAnimation_Definition_Manager = new cAnimation_Definition_Manager();
     pSound_Manager = new cSound_Manager();
     pSettingsParser = new cImage_Settings_Parser();
+    Scripting::pMRuby_Bytecode_Cache = new Scripting::cMRuby_Bytecode_Cache();
+    pSave_Writer = new cXml_Save_Writer();
 
     // Init Stage 2 - set preferences and init audio and the video screen
 
@@ -253,6 +321,14 @@ void Init_Game(void)
     I18N_Init();
     // init user dir directory
     pResource_Manager->Init_User_Directory();
+    // load the compiled image settings
+    if (pPreferences->m_image_cache_enabled) {
+        pSettingsParser->Load_Cache(pResource_Manager->Get_User_Cache_Directory() / utf8_to_path("image_settings.cache"));
+    }
+    // compiled level and game scripts
+    if (pPreferences->m_script_cache_enabled) {
+        Scripting::pMRuby_Bytecode_Cache->Set_Directory(pResource_Manager->Get_User_Cache_Directory() / utf8_to_path("scripts"));
+    }
     // init pacakge from command line or preferences
     if (!g_cmdline_package.empty())
         pPackage_Manager->Set_Current_Package(g_cmdline_package);
@@ -280,6 +356,7 @@ void Init_Game(void)
 
     debug_print("Loading levels\n");
     pLevel_Manager = new cLevel_Manager();
+    pLevel_Library = new cLevel_Library();
     // set the first animation manager available
     pActive_Animation_Manager = pActive_Level->m_animation_manager;
     // set the first active sprite manager available
@@ -327,8 +404,18 @@ void Init_Game(void)
 
 void Exit_Game(void)
 {
+    // the render thread may still use the renderer and textures
+    if (pVideo) {
+        pVideo->Render_Finish();
+    }
+
     if (pPreferences) {
         pPreferences->Save();
+
+        // save the compiled image settings for the next start
+        if (pPreferences->m_image_cache_enabled && pSettingsParser) {
+            pSettingsParser->Save_Cache(pResource_Manager->Get_User_Cache_Directory() / utf8_to_path("image_settings.cache"));
+        }
     }
 
     pLevel_Manager->Unload();
@@ -369,6 +456,12 @@ void Exit_Game(void)
         pPreferences = NULL;
     }
 
+    // writes the remaining saves
+    if (pSave_Writer) {
+        delete pSave_Writer;
+        pSave_Writer = NULL;
+    }
+
     if (pSavegame) {
         delete pSavegame;
         pSavegame = NULL;
@@ -404,6 +497,11 @@ void Exit_Game(void)
         pOverworld_Player = NULL;
     }
 
+    if (pLevel_Library) {
+        delete pLevel_Library;
+        pLevel_Library = NULL;
+    }
+
     if (pLevel_Manager) {
         delete pLevel_Manager;
         pLevel_Manager = NULL;
@@ -443,6 +541,11 @@ void Exit_Game(void)
         pVideo = NULL;
     }
 
+    if (pAnimation_Definition_Manager) {
+        delete pAnimation_Definition_Manager;
+        pAnimation_Definition_Manager = NULL;
+    }
+
     if (pImage_Manager) {
         delete pImage_Manager;
         pImage_Manager = NULL;
@@ -453,6 +556,11 @@ void Exit_Game(void)
         pSettingsParser = NULL;
     }
 
+    if (Scripting::pMRuby_Bytecode_Cache) {
+        delete Scripting::pMRuby_Bytecode_Cache;
+        Scripting::pMRuby_Bytecode_Cache = NULL;
+    }
+
     if (pFont) {
         delete pFont;
         pFont = NULL;
@@ -468,6 +576,17 @@ void Exit_Game(void)
         pResource_Manager = NULL;
     }
 
+    if (pPerf_Counters) {
+        delete pPerf_Counters;
+        pPerf_Counters = NULL;
+    }
+
+    // the owners of the jobs already waited for them
+    if (pJob_System) {
+        delete pJob_System;
+        pJob_System = NULL;
+    }
+
     char* last_sdl_error = SDL_GetError();
     if (strlen(last_sdl_error) > 0) {
         cerr << "Last known SDL Error : " << last_sdl_error << endl;
@@ -609,6 +728,9 @@ void Update_Game(void)
 
     pMouseCursor->Update();
 
+    // ## continuations of the background jobs
+    pJob_System->Update();
+
     // ## audio
     pAudio->Resume_Music();
     pAudio->Update();
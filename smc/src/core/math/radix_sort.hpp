@@ -0,0 +1,177 @@
+/***************************************************************************
+ * radix_sort.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_RADIX_SORT_HPP
+#define SMC_RADIX_SORT_HPP
+
+#include "../../core/global_basic.hpp"
+
+#include <cstring>
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** *** Sort keys *** *** *** *** *** *** *** *** *** */
+
+    /* Convert a float to an unsigned key with the same order
+     * Negative and positive zero get the same key.
+    */
+    inline Uint32 Float_To_Sort_Key(float value)
+    {
+        if (value == 0.0f) {
+            return 0x80000000;
+        }
+
+        Uint32 bits;
+        memcpy(&bits, &value, 4);
+
+        // negative values are stored as magnitude
+        if (bits & 0x80000000) {
+            return ~bits;
+        }
+
+        return bits | 0x80000000;
+    }
+
+    /* *** *** *** *** *** *** *** *** cRadix_Sorter *** *** *** *** *** *** *** *** *** */
+
+    /* Stable ascending sort of items by 32 bit keys
+     * Items with the same key keep their order. Runs in linear time and returns
+     * early if the items are already sorted. The buffers are kept between sorts.
+    */
+    template<class T> class cRadix_Sorter {
+    public:
+        // Remove the keys of the last sort
+        void Clear(void)
+        {
+            m_keys.clear();
+        }
+
+        // Add the key of the next item
+        void Add_Key(Uint32 key)
+        {
+            m_keys.push_back(key);
+        }
+
+        /* Sort the items by the added keys
+         * There must be one key per item in the same order.
+         * returns true if the order changed
+        */
+        bool Sort(vector<T>& items);
+
+    private:
+        // insertion sort for short lists
+        void Insertion_Sort(vector<T>& items);
+
+        vector<Uint32> m_keys;
+        vector<Uint32> m_keys_temp;
+        vector<T> m_items_temp;
+    };
+
+    template<class T> bool cRadix_Sorter<T>::Sort(vector<T>& items)
+    {
+        const size_t count = items.size();
+
+        if (count != m_keys.size()) {
+            std::cerr << "Warning : Radix sort key count " << m_keys.size() << " does not match item count " << count << std::endl;
+            return 0;
+        }
+
+        // check if already sorted
+        size_t first_unsorted = 1;
+
+        while (first_unsorted < count && m_keys[first_unsorted - 1] <= m_keys[first_unsorted]) {
+            first_unsorted++;
+        }
+
+        if (first_unsorted >= count) {
+            return 0;
+        }
+
+        if (count <= 32) {
+            Insertion_Sort(items);
+            return 1;
+        }
+
+        // histogram of every byte
+        size_t histogram[4][256];
+        memset(histogram, 0, sizeof(histogram));
+
+        for (size_t i = 0; i < count; i++) {
+            const Uint32 key = m_keys[i];
+
+            histogram[0][key & 0xFF]++;
+            histogram[1][(key >> 8) & 0xFF]++;
+            histogram[2][(key >> 16) & 0xFF]++;
+            histogram[3][key >> 24]++;
+        }
+
+        m_keys_temp.resize(count);
+        m_items_temp.resize(count);
+
+        for (unsigned int pass = 0; pass < 4; pass++) {
+            const unsigned int shift = pass * 8;
+            size_t* pass_histogram = histogram[pass];
+
+            // skip if all keys have the same byte
+            if (pass_histogram[(m_keys[0] >> shift) & 0xFF] == count) {
+                continue;
+            }
+
+            // bucket start offsets
+            size_t offset = 0;
+
+            for (unsigned int i = 0; i < 256; i++) {
+                const size_t bucket_count = pass_histogram[i];
+                pass_histogram[i] = offset;
+                offset += bucket_count;
+            }
+
+            for (size_t i = 0; i < count; i++) {
+                const size_t target = pass_histogram[(m_keys[i] >> shift) & 0xFF]++;
+
+                m_keys_temp[target] = m_keys[i];
+                m_items_temp[target] = items[i];
+            }
+
+            m_keys.swap(m_keys_temp);
+            items.swap(m_items_temp);
+        }
+
+        return 1;
+    }
+
+    template<class T> void cRadix_Sorter<T>::Insertion_Sort(vector<T>& items)
+    {
+        for (size_t i = 1; i < items.size(); i++) {
+            const Uint32 key = m_keys[i];
+            T item = items[i];
+            size_t j = i;
+
+            while (j > 0 && m_keys[j - 1] > key) {
+                m_keys[j] = m_keys[j - 1];
+                items[j] = items[j - 1];
+                j--;
+            }
+
+            m_keys[j] = key;
+            items[j] = item;
+        }
+    }
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -0,0 +1,170 @@
+/***************************************************************************
+ * perf_counters.cpp  -  per frame performance counters
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../core/perf_counters.hpp"
+#include "../core/property_helper.hpp"
+#include "../core/filesystem/filesystem.hpp"
+#include "../core/filesystem/resource_manager.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace SMC {
+
+/* *** *** *** *** *** *** *** cPerf_Counters *** *** *** *** *** *** *** *** *** *** */
+
+cPerf_Counters::cPerf_Counters(void)
+{
+    m_graph_type = PERF_COUNT_SPRITES_UPDATED;
+    m_history_pos = 0;
+    m_frame = 0;
+
+    for (unsigned int i = 0; i < PERF_COUNT_SIZE; i++) {
+        m_counters[i].store(0, boost::memory_order_relaxed);
+
+        for (unsigned int j = 0; j < m_history_size; j++) {
+            m_history[i][j] = 0;
+        }
+    }
+}
+
+cPerf_Counters::~cPerf_Counters(void)
+{
+    Stop_Dump();
+}
+
+void cPerf_Counters::End_Frame(Uint32 ms)
+{
+    m_history_pos = (m_history_pos + 1) % m_history_size;
+    m_frame++;
+
+    for (unsigned int i = 0; i < PERF_COUNT_SIZE; i++) {
+        m_history[i][m_history_pos] = m_counters[i].exchange(0, boost::memory_order_relaxed);
+    }
+
+    if (!m_dump_file.is_open()) {
+        return;
+    }
+
+    m_dump_file << m_frame << "," << ms;
+
+    for (unsigned int i = 0; i < PERF_COUNT_SIZE; i++) {
+        m_dump_file << "," << m_history[i][m_history_pos];
+    }
+
+    m_dump_file << "\n";
+}
+
+Uint32 cPerf_Counters::Get_History(Perf_Counter_Type type, unsigned int age) const
+{
+    if (age >= m_history_size) {
+        return 0;
+    }
+
+    return m_history[type][(m_history_pos + m_history_size - age) % m_history_size];
+}
+
+Uint32 cPerf_Counters::Get_History_Max(Perf_Counter_Type type) const
+{
+    Uint32 max = 0;
+
+    for (unsigned int i = 0; i < m_history_size; i++) {
+        if (m_history[type][i] > max) {
+            max = m_history[type][i];
+        }
+    }
+
+    return max;
+}
+
+std::string cPerf_Counters::Get_Name(Perf_Counter_Type type)
+{
+    switch (type) {
+    case PERF_COUNT_SPRITES_UPDATED:
+        return "sprites_updated";
+    case PERF_COUNT_SPRITES_DRAWN:
+        return "sprites_drawn";
+    case PERF_COUNT_COLLISION_CANDIDATES:
+        return "collision_candidates";
+    case PERF_COUNT_COLLISION_CHECKS:
+        return "collision_checks";
+    case PERF_COUNT_COLLISION_OBJECTS:
+        return "collision_objects";
+    case PERF_COUNT_RENDER_REQUESTS:
+        return "render_requests";
+    case PERF_COUNT_TEXTURE_BINDS:
+        return "texture_binds";
+    case PERF_COUNT_RENDER_TEXT:
+        return "render_text";
+    case PERF_COUNT_SCRIPT_CALLBACKS:
+        return "script_callbacks";
+    case PERF_COUNT_SOUNDS_PLAYED:
+        return "sounds_played";
+    case PERF_COUNT_SOUNDS_SKIPPED:
+        return "sounds_skipped";
+    case PERF_COUNT_SPRITE_QUADS_BUILT:
+        return "sprite_quads_built";
+    default:
+        break;
+    }
+
+    return "";
+}
+
+fs::path cPerf_Counters::Start_Dump(void)
+{
+    Stop_Dump();
+
+    fs::path filename;
+
+    for (unsigned int i = 1; i < 1000; i++) {
+        filename = pResource_Manager->Get_User_Data_Directory() / utf8_to_path("counters_" + int_to_string(i) + ".csv");
+
+        if (!File_Exists(filename)) {
+            break;
+        }
+    }
+
+    m_dump_file.open(filename, ios::out | ios::trunc);
+
+    if (!m_dump_file.is_open()) {
+        cerr << "Warning : Could not create counters file " << path_to_utf8(filename) << endl;
+        return fs::path();
+    }
+
+    m_dump_file << "frame,ms";
+
+    for (unsigned int i = 0; i < PERF_COUNT_SIZE; i++) {
+        m_dump_file << "," << Get_Name(static_cast<Perf_Counter_Type>(i));
+    }
+
+    m_dump_file << "\n";
+
+    return filename;
+}
+
+void cPerf_Counters::Stop_Dump(void)
+{
+    if (m_dump_file.is_open()) {
+        m_dump_file.close();
+    }
+}
+
+cPerf_Counters* pPerf_Counters = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
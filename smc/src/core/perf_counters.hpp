@@ -0,0 +1,134 @@
+/***************************************************************************
+ * perf_counters.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_PERF_COUNTERS_HPP
+#define SMC_PERF_COUNTERS_HPP
+
+#include "../core/global_basic.hpp"
+
+#include <boost/atomic.hpp>
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** Performance counter types *** *** *** *** *** *** *** *** *** *** */
+
+    enum Perf_Counter_Type {
+        // sprites with a valid update
+        PERF_COUNT_SPRITES_UPDATED = 0,
+        // sprite images drawn
+        PERF_COUNT_SPRITES_DRAWN = 1,
+        // objects given to a collision check
+        PERF_COUNT_COLLISION_CANDIDATES = 2,
+        // objects touching the checked rect and validated
+        PERF_COUNT_COLLISION_CHECKS = 3,
+        // created cObjectCollision objects
+        PERF_COUNT_COLLISION_OBJECTS = 4,
+        // render requests added
+        PERF_COUNT_RENDER_REQUESTS = 5,
+        // textures bound by the render requests
+        PERF_COUNT_TEXTURE_BINDS = 6,
+        // rendered font texts
+        PERF_COUNT_RENDER_TEXT = 7,
+        // mruby event handlers and timer callbacks called
+        PERF_COUNT_SCRIPT_CALLBACKS = 8,
+        // sounds started
+        PERF_COUNT_SOUNDS_PLAYED = 9,
+        // sounds dropped, stolen or culled
+        PERF_COUNT_SOUNDS_SKIPPED = 10,
+        // sprite image quads rebuilt after a change
+        PERF_COUNT_SPRITE_QUADS_BUILT = 11,
+        PERF_COUNT_SIZE = 12
+    };
+
+    /* *** *** *** *** *** *** *** cPerf_Counters *** *** *** *** *** *** *** *** *** *** */
+
+    /* Counts the work done in a frame
+     * Counting is a relaxed atomic add and can be done from any thread. End_Frame()
+     * moves the counts of the frame into a history of the last frames which is shown
+     * in the debug mode and can be dumped into a CSV file.
+    */
+    class cPerf_Counters {
+    public:
+        cPerf_Counters(void);
+        ~cPerf_Counters(void);
+
+        // Count for the current frame
+        inline void Add(Perf_Counter_Type type, Uint32 count = 1)
+        {
+            m_counters[type].fetch_add(count, boost::memory_order_relaxed);
+        };
+
+        /* Finish the current frame
+         * ms : frame time in milliseconds
+        */
+        void End_Frame(Uint32 ms);
+
+        // Return the count of the last finished frame
+        Uint32 Get_Last(Perf_Counter_Type type) const
+        {
+            return m_history[type][m_history_pos];
+        };
+        /* Return the count of a finished frame
+         * age : 0 is the last finished frame
+        */
+        Uint32 Get_History(Perf_Counter_Type type, unsigned int age) const;
+        // Return the highest count in the history
+        Uint32 Get_History_Max(Perf_Counter_Type type) const;
+
+        // Return the display and CSV column name
+        static std::string Get_Name(Perf_Counter_Type type);
+
+        /* Start writing every finished frame into a new CSV file in the user data directory
+         * returns the filename or an empty path on failure
+        */
+        boost::filesystem::path Start_Dump(void);
+        // Stop writing the CSV file
+        void Stop_Dump(void);
+        // Return true if a CSV file is written
+        bool Is_Dumping(void) const
+        {
+            return m_dump_file.is_open();
+        };
+
+        // frames in the history
+        static const unsigned int m_history_size = 120;
+
+        // counter shown in the graph
+        Perf_Counter_Type m_graph_type;
+
+    private:
+        // counts of the current frame
+        boost::atomic<Uint32> m_counters[PERF_COUNT_SIZE];
+        // counts of the finished frames
+        Uint32 m_history[PERF_COUNT_SIZE][m_history_size];
+        // position of the last finished frame in the history
+        unsigned int m_history_pos;
+
+        // finished frames
+        Uint32 m_frame;
+        // CSV file
+        boost::filesystem::ofstream m_dump_file;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    // Performance counters
+    extern cPerf_Counters* pPerf_Counters;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
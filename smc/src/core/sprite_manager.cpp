@@ -19,6 +19,7 @@
 #include "../input/mouse.hpp"
 #include "../overworld/world_player.hpp"
 #include "../enemies/enemy.hpp"
+#include "../core/framerate.hpp"
 #include "../core/global_basic.hpp"
 
 using namespace std;
@@ -27,6 +28,8 @@ namespace SMC {
 
 /* *** *** *** *** *** *** cSprite_Manager *** *** *** *** *** *** *** *** *** *** *** */
 
+Uint32 cSprite_Manager::m_change_count = 0;
+
 cSprite_Manager::cSprite_Manager(unsigned int reserve_items /* = 2000 */, unsigned int zpos_items /* = 100 */)
     : cObject_Manager<cSprite>()
 {
@@ -35,6 +38,12 @@ cSprite_Manager::cSprite_Manager(unsigned int reserve_items /* = 2000 */, unsign
     m_max_uid_mark = 1; // UID 0 is reserved for the player
     m_z_pos_data.assign(zpos_items, 0.0f);
     m_z_pos_data_editor.assign(zpos_items,0.0f);
+    m_collide_move_stamp = 0;
+
+    m_update_buckets_valid = 0;
+    m_update_buckets_stamp = 0;
+    m_update_buckets_size = 0;
+    m_update_frame = 0;
 }
 
 cSprite_Manager::~cSprite_Manager(void)
@@ -49,6 +58,8 @@ void cSprite_Manager::Add(cSprite* sprite)
         return;
     }
 
+    m_change_count++;
+
     // Ensure sprites of the same layer get slightly different Z
     // coordinates. See method docs in sprite_manager.hpp for more
     //information.
@@ -100,6 +111,18 @@ void cSprite_Manager::Add(cSprite* sprite)
     cObject_Manager<cSprite>::Add(sprite);
 }
 
+bool cSprite_Manager::Delete(size_t array_num, bool delete_data /* = 1 */)
+{
+    m_change_count++;
+    return cObject_Manager<cSprite>::Delete(array_num, delete_data);
+}
+
+bool cSprite_Manager::Delete(cSprite* sprite, bool delete_data /* = 1 */)
+{
+    m_change_count++;
+    return cObject_Manager<cSprite>::Delete(sprite, delete_data);
+}
+
 cSprite* cSprite_Manager::Copy(unsigned int identifier)
 {
     if (identifier >= objects.size()) {
@@ -173,6 +196,8 @@ void cSprite_Manager::Move_To_Front(cSprite* sprite)
         return;
     }
 
+    m_change_count++;
+
     objects.erase(itr);
     objects.front() = sprite;
     objects.insert(objects.begin() + 1, first);
@@ -204,6 +229,8 @@ void cSprite_Manager::Move_To_Back(cSprite* sprite)
         return;
     }
 
+    m_change_count++;
+
     objects.erase(itr);
     objects.back() = sprite;
     objects.insert(objects.end() - 1, last);
@@ -214,6 +241,8 @@ void cSprite_Manager::Move_To_Back(cSprite* sprite)
 
 void cSprite_Manager::Delete_All(bool delayed /* = 0 */)
 {
+    m_change_count++;
+
     // delayed
     if (delayed) {
         for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
@@ -334,34 +363,43 @@ void cSprite_Manager::Get_Objects_sorted(cSprite_List& new_objects, bool editor_
     }
 
     // z position sort
-    if (!editor_sort) {
-        // default
-        std::sort(new_objects.begin(), new_objects.end(), zpos_sort());
-    }
-    else {
-        // editor
-        std::sort(new_objects.begin(), new_objects.end(), editor_zpos_sort());
+    m_zpos_sorter.Clear();
+
+    for (cSprite_List::const_iterator itr = new_objects.begin(); itr != new_objects.end(); ++itr) {
+        if (!editor_sort) {
+            // default
+            m_zpos_sorter.Add_Key(Get_Zpos_Sort_Key(*itr));
+        }
+        else {
+            // editor
+            m_zpos_sorter.Add_Key(Get_Editor_Zpos_Sort_Key(*itr));
+        }
     }
+
+    m_zpos_sorter.Sort(new_objects);
 }
 
 void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_rect& rect, bool with_player /* = 0 */, const cSprite* exclude_sprite /* = NULL */) const
 {
-    // Check objects
-    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-        // get object pointer
-        cSprite* obj = (*itr);
+    // moving sprites only check their candidates
+    if (!m_broad_phase.Is_Active() || !m_broad_phase.Get_Colliding_Objects(col_objects, rect, exclude_sprite)) {
+        // Check objects
+        for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+            // get object pointer
+            cSprite* obj = (*itr);
 
-        // if destroyed object
-        if (obj == exclude_sprite || obj->m_auto_destroy) {
-            continue;
-        }
+            // if destroyed object
+            if (obj == exclude_sprite || obj->m_auto_destroy) {
+                continue;
+            }
 
-        // if rects don't touch
-        if (!rect.Intersects(obj->m_col_rect)) {
-            continue;
-        }
+            // if rects don't touch
+            if (!rect.Intersects(obj->m_col_rect)) {
+                continue;
+            }
 
-        col_objects.push_back(obj);
+            col_objects.push_back(obj);
+        }
     }
 
     if (with_player && pActive_Player != exclude_sprite) {
@@ -398,26 +436,268 @@ void cSprite_Manager::Get_Colliding_Objects(cSprite_List& col_objects, const GL_
     }
 }
 
-void cSprite_Manager::Handle_Collision_Items(void)
+void cSprite_Manager::Update_Items(void)
 {
-    for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
+    if (!m_update_buckets_valid || m_update_buckets_stamp != m_change_count || m_update_buckets_size != objects.size()) {
+        Build_Update_Buckets();
+    }
+
+    m_update_frame++;
+    Uint32 updated = 0;
+
+    /* the buckets are iterated by index and not changed while updating
+     * sprites added by an update are handled at the end
+    */
+    for (unsigned int i = 0; i < m_update_always.size(); i++) {
+        cSprite* obj = m_update_always[i];
+
+        if (obj->m_valid_update) {
+            updated++;
+        }
+
+        obj->Update();
+    }
+
+    for (unsigned int i = 0; i < m_update_interval.size(); i++) {
+        cSprite* obj = m_update_interval[i];
+
+        // spread the sprites over the frames
+        if ((m_update_frame + i) % obj->m_update_interval != 0) {
+            obj->m_update_skipped_speed_factor += pFramerate->m_speed_factor;
+            obj->m_update_skipped_ticks += pFramerate->m_elapsed_ticks;
+            continue;
+        }
+
+        if (obj->m_valid_update) {
+            updated++;
+        }
+
+        Update_Interval_Item(obj);
+    }
+
+    for (unsigned int i = 0; i < m_update_in_range.size(); i++) {
+        cSprite* obj = m_update_in_range[i];
+
+        // a not valid update is still called to finish dying or freezing
+        if (obj->m_valid_update && !obj->Is_In_Range()) {
+            continue;
+        }
+
+        if (obj->m_valid_update) {
+            updated++;
+        }
+
+        obj->Update();
+    }
+
+    for (unsigned int i = 0; i < m_update_sleeping.size(); i++) {
+        cSprite* obj = m_update_sleeping[i];
+
+        if (!obj->m_sleeping || !Check_Wake_Up(obj)) {
+            continue;
+        }
+
+        obj->Wake_Up();
+
+        if (obj->m_valid_update) {
+            updated++;
+        }
+
+        obj->Update();
+    }
+
+    // added while updating
+    for (size_t i = m_update_buckets_size; i < objects.size(); i++) {
+        cSprite* obj = objects[i];
+
+        if (obj->m_update_policy == UPDATE_POLICY_SLEEP && obj->m_sleeping) {
+            continue;
+        }
+
+        if (obj->m_update_policy == UPDATE_POLICY_IN_RANGE && obj->m_valid_update && !obj->Is_In_Range()) {
+            continue;
+        }
+
+        if (obj->m_valid_update) {
+            updated++;
+        }
+
+        obj->Update();
+    }
+
+    pPerf_Counters->Add(PERF_COUNT_SPRITES_UPDATED, updated);
+}
+
+void cSprite_Manager::Build_Update_Buckets(void)
+{
+    m_update_always.clear();
+    m_update_interval.clear();
+    m_update_in_range.clear();
+    m_update_sleeping.clear();
+
+    for (cSprite_List::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
         cSprite* obj = (*itr);
 
-        // invalid
-        if (obj->m_auto_destroy) {
-            if (obj->m_collisions.size()) {
-                debug_print("Collision with a destroyed object (%s)\n", obj->Create_Name().c_str());
-                obj->Clear_Collisions();
+        switch (obj->m_update_policy) {
+        case UPDATE_POLICY_INTERVAL:
+            if (obj->m_update_interval > 1) {
+                m_update_interval.push_back(obj);
+            }
+            else {
+                m_update_always.push_back(obj);
+            }
+            break;
+        case UPDATE_POLICY_IN_RANGE:
+            m_update_in_range.push_back(obj);
+            break;
+        case UPDATE_POLICY_SLEEP:
+            if (!obj->m_sleeping) {
+                m_update_always.push_back(obj);
+            }
+            // only woken up by a touch or Wake_Up()
+            else if (obj->m_sleep_time > 0.0f || obj->m_sleep_player_distance > 0.0f) {
+                m_update_sleeping.push_back(obj);
+            }
+            break;
+        default:
+            m_update_always.push_back(obj);
+            break;
+        }
+    }
+
+    m_update_buckets_valid = 1;
+    m_update_buckets_stamp = m_change_count;
+    m_update_buckets_size = objects.size();
+}
+
+void cSprite_Manager::Update_Interval_Item(cSprite* obj)
+{
+    const float speed_factor = pFramerate->m_speed_factor;
+    const Uint32 elapsed_ticks = pFramerate->m_elapsed_ticks;
+
+    // as if the skipped frames were one long frame
+    pFramerate->m_speed_factor += obj->m_update_skipped_speed_factor;
+    pFramerate->m_elapsed_ticks += obj->m_update_skipped_ticks;
+    obj->m_update_skipped_speed_factor = 0.0f;
+    obj->m_update_skipped_ticks = 0;
+
+    obj->Update();
+
+    pFramerate->m_speed_factor = speed_factor;
+    pFramerate->m_elapsed_ticks = elapsed_ticks;
+}
+
+bool cSprite_Manager::Check_Wake_Up(cSprite* obj) const
+{
+    if (obj->m_sleep_time > 0.0f) {
+        obj->m_sleep_time -= pFramerate->m_speed_factor;
+
+        if (obj->m_sleep_time <= 0.0f) {
+            obj->m_sleep_time = 0.0f;
+            return 1;
+        }
+    }
+
+    if (obj->m_sleep_player_distance > 0.0f && pActive_Player) {
+        const float dist_x = (obj->m_col_rect.m_x + obj->m_col_rect.m_w * 0.5f) - (pActive_Player->m_col_rect.m_x + pActive_Player->m_col_rect.m_w * 0.5f);
+        const float dist_y = (obj->m_col_rect.m_y + obj->m_col_rect.m_h * 0.5f) - (pActive_Player->m_col_rect.m_y + pActive_Player->m_col_rect.m_h * 0.5f);
+
+        if (dist_x * dist_x + dist_y * dist_y < obj->m_sleep_player_distance * obj->m_sleep_player_distance) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void cSprite_Manager::Handle_Collision_Items(void)
+{
+    // detect the candidates before resolving the collisions serially
+    m_broad_phase.Begin(objects);
+
+    m_collide_move_stamp += 2;
+    // standing on an object of this manager
+    const Uint32 rider_stamp = m_collide_move_stamp;
+    const Uint32 handled_stamp = m_collide_move_stamp + 1;
+
+    for (unsigned int i = 0; i < objects.size(); i++) {
+        const vector<cMovingSprite*>& riders = objects[i]->m_riders;
+
+        for (vector<cMovingSprite*>::const_iterator itr = riders.begin(); itr != riders.end(); ++itr) {
+            (*itr)->m_collide_move_stamp = rider_stamp;
+        }
+    }
+
+    // start with the objects not standing on others and continue with their riders
+    for (unsigned int i = 0; i < objects.size(); i++) {
+        cSprite* obj = objects[i];
+
+        if (obj->m_collide_move_stamp == rider_stamp || obj->m_collide_move_stamp == handled_stamp) {
+            continue;
+        }
+
+        m_collide_move_stack.push_back(obj);
+
+        while (!m_collide_move_stack.empty()) {
+            cSprite* current = m_collide_move_stack.back();
+            m_collide_move_stack.pop_back();
+
+            if (current->m_collide_move_stamp == handled_stamp) {
+                continue;
             }
 
+            current->m_collide_move_stamp = handled_stamp;
+            Handle_Collision_Item(current);
+
+            // the riders after their ground moved ( the player is handled by the level manager )
+            const vector<cMovingSprite*>& riders = current->m_riders;
+
+            for (vector<cMovingSprite*>::const_reverse_iterator itr = riders.rbegin(); itr != riders.rend(); ++itr) {
+                cSprite* rider = (*itr);
+
+                if (rider->m_sprite_manager == this && rider->m_sprite_array != ARRAY_PLAYER) {
+                    m_collide_move_stack.push_back(rider);
+                }
+            }
+        }
+    }
+
+    // riders which lost their ground or stand on each other
+    for (unsigned int i = 0; i < objects.size(); i++) {
+        cSprite* obj = objects[i];
+
+        if (obj->m_collide_move_stamp == handled_stamp) {
             continue;
         }
 
-        // collision and movement handling
-        obj->Collide_Move();
-        // handle found collisions
-        obj->Handle_Collisions();
+        obj->m_collide_move_stamp = handled_stamp;
+        Handle_Collision_Item(obj);
+    }
+
+    m_broad_phase.End();
+}
+
+void cSprite_Manager::Handle_Collision_Item(cSprite* obj)
+{
+    // invalid
+    if (obj->m_auto_destroy) {
+        if (obj->m_collisions.size()) {
+            debug_print("Collision with a destroyed object (%s)\n", obj->Create_Name().c_str());
+            obj->Clear_Collisions();
+        }
+
+        return;
+    }
+
+    // a touched sleeper is updated from the next frame
+    if (obj->m_sleeping && obj->m_sleep_wake_on_touch && !obj->m_collisions.empty()) {
+        obj->Wake_Up();
     }
+
+    // collision and movement handling
+    obj->Collide_Move();
+    // handle found collisions
+    obj->Handle_Collisions();
 }
 
 unsigned int cSprite_Manager::Get_Size_Array(const ArrayType sprite_array)
@@ -19,6 +19,9 @@
 #include "../core/global_game.hpp"
 #include "../core/obj_manager.hpp"
 #include "../objects/movingsprite.hpp"
+#include "../core/math/radix_sort.hpp"
+#include "../core/perf_counters.hpp"
+#include "../core/collision_broad_phase.hpp"
 
 namespace SMC {
 
@@ -34,6 +37,10 @@ namespace SMC {
          * it will not be touched, otherwise it is assigned a free UID.
          */
         virtual void Add(cSprite* sprite);
+        // Delete the sprite from the given array number
+        virtual bool Delete(size_t array_num, bool delete_data = 1);
+        // Delete the given sprite
+        virtual bool Delete(cSprite* sprite, bool delete_data = 1);
 
         // Return a sprite copy
         cSprite* Copy(unsigned int identifier);
@@ -88,13 +95,16 @@ namespace SMC {
                 (*itr)->Update_Valid_Draw();
             }
         }
-        // Update items
-        inline void Update_Items(void)
+        /* Update items with their update policy
+         * The items are kept in a bucket for each policy which is rebuilt if items are
+         * added, removed or reordered or an update policy or sleep changes.
+        */
+        void Update_Items(void);
+        // Rebuild the update buckets on the next Update_Items()
+        inline void Invalidate_Update_Buckets(void)
         {
-            for (cSprite_List::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
-                (*itr)->Update();
-            }
-        }
+            m_update_buckets_valid = 0;
+        };
         // Update_Late items
         inline void Update_Items_Late(void)
         {
@@ -110,7 +120,10 @@ namespace SMC {
             }
         }
 
-        // Create Collision data and Handle the collisions
+        /* Create Collision data and Handle the collisions
+         * Ground objects are handled before the objects standing on them.
+         * The collision candidates of the moving sprites are detected first by m_broad_phase.
+        */
         void Handle_Collision_Items(void);
 
 
@@ -148,38 +161,33 @@ namespace SMC {
         // non-yet allocated UID.
         int m_max_uid_mark;
 
-        // Z position sort
-        struct zpos_sort {
-            bool operator()(const cSprite* a, const cSprite* b) const
-            {
-                return a->m_pos_z > b->m_pos_z;
-            }
-        };
+        // collision candidates of the moving sprites while handling the collisions
+        cCollision_Broad_Phase m_broad_phase;
+
+        /* Incremented when sprites are added, removed or reordered in any sprite manager
+         * Used by cEditor_Pick_Index to detect changes.
+        */
+        static Uint32 m_change_count;
 
-        // Editor Z position sort
-        struct editor_zpos_sort {
-            bool operator()(const cSprite* a, const cSprite* b) const
-            {
-                // check if the editor zpos is available
-                if (!a->m_editor_pos_z) {
-                    if (!b->m_editor_pos_z) {
-                        return a->m_pos_z < b->m_pos_z;
-                    }
-
-                    return a->m_pos_z < b->m_editor_pos_z;
-                }
-                if (!b->m_editor_pos_z) {
-                    if (!a->m_editor_pos_z) {
-                        return a->m_pos_z < b->m_pos_z;
-                    }
-
-                    return a->m_editor_pos_z < b->m_pos_z;
-                }
-
-                // both objects have an editor z pos
-                return a->m_editor_pos_z < b->m_editor_pos_z;
+        /* Z position sort key
+         * higher z positions are sorted first
+        */
+        static Uint32 Get_Zpos_Sort_Key(const cSprite* sprite)
+        {
+            return ~Float_To_Sort_Key(sprite->m_pos_z);
+        }
+
+        /* Editor Z position sort key
+         * uses the editor z position if available
+        */
+        static Uint32 Get_Editor_Zpos_Sort_Key(const cSprite* sprite)
+        {
+            if (sprite->m_editor_pos_z) {
+                return Float_To_Sort_Key(sprite->m_editor_pos_z);
             }
-        };
+
+            return Float_To_Sort_Key(sprite->m_pos_z);
+        }
 
     private:
         /* When multiple sprites of the same massivity are placed
@@ -193,6 +201,40 @@ namespace SMC {
          * are ensured to be placed in front of older ones.
          */
         void Ensure_Different_Z(cSprite* sprite);
+
+        // Create Collision data and Handle the collisions of the object
+        void Handle_Collision_Item(cSprite* obj);
+
+        // Sort the objects into the update buckets
+        void Build_Update_Buckets(void);
+        // Update with the speed factor of the frames skipped by UPDATE_POLICY_INTERVAL
+        void Update_Interval_Item(cSprite* obj);
+        // Return true if the sleeping sprite wakes up in this frame
+        bool Check_Wake_Up(cSprite* obj) const;
+
+        // sprites updated every frame including awake sleepers
+        cSprite_List m_update_always;
+        // sprites with UPDATE_POLICY_INTERVAL
+        cSprite_List m_update_interval;
+        // sprites with UPDATE_POLICY_IN_RANGE
+        cSprite_List m_update_in_range;
+        // sleeping sprites with a wake up time or player distance
+        cSprite_List m_update_sleeping;
+        // buckets are up to date
+        bool m_update_buckets_valid;
+        // m_change_count and object count when the buckets were built
+        Uint32 m_update_buckets_stamp;
+        size_t m_update_buckets_size;
+        // frames updated to spread the interval updates
+        Uint32 m_update_frame;
+
+        // stamp of the last Handle_Collision_Items()
+        Uint32 m_collide_move_stamp;
+        // objects waiting for their collision handling
+        cSprite_List m_collide_move_stack;
+
+        // reused sort buffers of Get_Objects_sorted
+        mutable cRadix_Sorter<cSprite*> m_zpos_sorter;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
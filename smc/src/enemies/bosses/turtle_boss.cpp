@@ -120,6 +120,16 @@ std::string cTurtleBoss::Get_XML_Type_Name()
     return "turtleboss";
 }
 
+void cTurtleBoss::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    cEnemy::Get_Sound_Files(sound_files);
+    sound_files.push_back("enemy/boss/turtle/big_hit.ogg");
+    sound_files.push_back("enemy/boss/turtle/hit.ogg");
+    sound_files.push_back("enemy/boss/turtle/power_up.ogg");
+    sound_files.push_back("enemy/boss/turtle/shell_attack.ogg");
+    sound_files.push_back("enemy/turtle/shell/hit.ogg");
+}
+
 xmlpp::Element* cTurtleBoss::Save_To_XML_Node(xmlpp::Element* p_element)
 {
     xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
@@ -267,7 +277,7 @@ void cTurtleBoss::DownGrade(bool force /* = 0 */)
         Set_Dead(1);
 
         if (m_turtle_state == TURTLEBOSS_WALK) {
-            Move(0.0f, m_images[0].m_image->m_h - m_images[5].m_image->m_h, 1);
+            Move(0.0f, Get_Image(0)->m_h - Get_Image(5)->m_h, 1);
         }
     }
 
@@ -536,7 +546,7 @@ void cTurtleBoss::Update(void)
             pAudio->Play_Sound("enemy/boss/turtle/shell_attack.ogg");
 
             Set_Turtle_Moving_State(TURTLEBOSS_SHELL_RUN);
-            Col_Move(0.0f, m_images[0].m_image->m_col_h - m_images[5].m_image->m_col_h, 1, 1);
+            Col_Move(0.0f, Get_Image(0)->m_col_h - Get_Image(5)->m_col_h, 1, 1);
 
             if (m_direction == DIR_RIGHT) {
                 m_velx = m_velx_max;
@@ -558,7 +568,7 @@ void cTurtleBoss::Stand_Up(void)
     }
 
     // get space needed to stand up
-    float move_y = m_image->m_col_h - m_images[0].m_image->m_col_h;
+    float move_y = m_image->m_col_h - Get_Image(0)->m_col_h;
 
     cObjectCollisionType* col_list = Collision_Check_Relative(0.0f, move_y, 0.0f, 0.0f, COLLIDE_ONLY_BLOCKING);
 
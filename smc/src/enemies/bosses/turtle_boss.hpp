@@ -152,6 +152,9 @@ namespace SMC {
         bool Get_Level_Ends_If_Killed();
         virtual std::string Create_Name(void) const;
 
+        // Add the sound files this enemy can play
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+
     protected:
 
         // times downgraded
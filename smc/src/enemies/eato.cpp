@@ -118,11 +118,25 @@ void cEato::Set_Image_Dir(fs::path dir)
 
     // clear images
     Clear_Images();
-    // set images
-    Add_Image(pVideo->Get_Package_Surface(m_img_dir / utf8_to_path("1.png")));
-    Add_Image(pVideo->Get_Package_Surface(m_img_dir / utf8_to_path("2.png")));
-    Add_Image(pVideo->Get_Package_Surface(m_img_dir / utf8_to_path("3.png")));
-    Add_Image(pVideo->Get_Package_Surface(m_img_dir / utf8_to_path("2.png")));
+
+    // images are shared by all eatos with this image directory
+    const std::string animation_key = "eato/" + path_to_utf8(m_img_dir);
+    const cAnimation_Definition* animation = pAnimation_Definition_Manager->Get(animation_key);
+
+    if (!animation) {
+        cAnimation_Definition* new_animation = pAnimation_Definition_Manager->Create(animation_key);
+
+        // set images
+        new_animation->Add_Image(pVideo->Get_Package_Surface(m_img_dir / utf8_to_path("1.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(m_img_dir / utf8_to_path("2.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(m_img_dir / utf8_to_path("3.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(m_img_dir / utf8_to_path("2.png")));
+
+        animation = new_animation;
+    }
+
+    Set_Animation_Definition(animation);
+
     // set start image
     Set_Image_Num(0, 1);
 
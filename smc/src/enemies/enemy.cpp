@@ -37,6 +37,8 @@ cEnemy::cEnemy(cSprite_Manager* sprite_manager)
     m_type = TYPE_ENEMY;
 
     m_camera_range = 1500;
+    // the enemies do nothing out of range
+    Set_Update_Policy(UPDATE_POLICY_IN_RANGE);
 
     m_massive_type = MASS_MASSIVE;
     m_state = STA_FALL;
@@ -357,7 +359,7 @@ void cEnemy::Handle_Ball_Hit(const cBall& ball, const cObjectCollision* p_collis
     Ball_Destroy_Animation(ball);
 
     // play enemy kill sound
-    pAudio->Play_Sound(m_kill_sound);
+    pAudio->Play_Sound_At(m_kill_sound, m_pos_x, m_pos_y);
 
     if (ball.m_ball_type == FIREBALL_DEFAULT) {
         // get points
@@ -389,6 +391,13 @@ std::string cEnemy::Create_Name() const
     return ss.str();
 }
 
+void cEnemy::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    if (!m_kill_sound.empty()) {
+        sound_files.push_back(m_kill_sound);
+    }
+}
+
 bool cEnemy::Is_Update_Valid()
 {
     if (m_dead || m_freeze_counter)
@@ -87,6 +87,9 @@ namespace SMC {
 
         virtual std::string Create_Name() const;
 
+        // Add the sound files this enemy can play
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+
         // if dead
         bool m_dead;
 
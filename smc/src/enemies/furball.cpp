@@ -105,6 +105,16 @@ std::string cFurball::Get_XML_Type_Name()
     return "furball";
 }
 
+void cFurball::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    cEnemy::Get_Sound_Files(sound_files);
+
+    if (m_type == TYPE_FURBALL_BOSS) {
+        sound_files.push_back("enemy/boss/furball/hit.wav");
+        sound_files.push_back("enemy/boss/furball/hit_failed.wav");
+    }
+}
+
 xmlpp::Element* cFurball::Save_To_XML_Node(xmlpp::Element* p_element)
 {
     xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
@@ -198,25 +208,33 @@ void cFurball::Set_Color(const DefaultColor& col)
 
     Update_Velocity_Max();
 
-    Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/walk_1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/walk_2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/walk_3.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/walk_4.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/walk_5.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/walk_6.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/walk_7.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/walk_8.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/turn.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/dead.png"));
-
-    // boss has hit image
-    if (m_type == TYPE_FURBALL_BOSS) {
-        Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/hit.png"));
-    }
-    else {
-        Add_Image(NULL);
+    // images are shared by all furballs of this color
+    const std::string animation_key = "furball/" + filename_dir;
+    const cAnimation_Definition* animation = pAnimation_Definition_Manager->Get(animation_key);
+
+    if (!animation) {
+        cAnimation_Definition* new_animation = pAnimation_Definition_Manager->Create(animation_key);
+
+        for (unsigned int i = 1; i <= 8; i++) {
+            new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/walk_" + int_to_string(i) + ".png"));
+        }
+
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/turn.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/dead.png"));
+
+        // boss has hit image
+        if (m_type == TYPE_FURBALL_BOSS) {
+            new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/furball/" + filename_dir + "/hit.png"));
+        }
+        else {
+            new_animation->Add_Image(NULL);
+        }
+
+        animation = new_animation;
     }
 
+    Set_Animation_Definition(animation);
+
     Set_Image_Num(0, 1);
 }
 
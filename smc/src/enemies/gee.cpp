@@ -220,16 +220,28 @@ void cGee::Set_Color(DefaultColor col)
         m_fire_resistant = 0;
     }
 
-    Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/3.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/4.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/5.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/6.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/7.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/8.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/9.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/10.png"));
+    // images are shared by all gees of this color
+    const std::string animation_key = "gee/" + filename_dir;
+    const cAnimation_Definition* animation = pAnimation_Definition_Manager->Get(animation_key);
+
+    if (!animation) {
+        cAnimation_Definition* new_animation = pAnimation_Definition_Manager->Create(animation_key);
+
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/1.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/2.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/3.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/4.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/5.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/6.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/7.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/8.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/9.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/gee/" + filename_dir + "/10.png"));
+
+        animation = new_animation;
+    }
+
+    Set_Animation_Definition(animation);
 
     Set_Image_Num(0, 1);
 
@@ -59,14 +59,26 @@ void cKrush::Init(void)
     m_pos_z = 0.093f;
     m_gravity_max = 27.0f;
 
-    Add_Image(pVideo->Get_Package_Surface("enemy/krush/big_1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/krush/big_2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/krush/big_3.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/krush/big_4.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/krush/small_1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/krush/small_2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/krush/small_3.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/krush/small_4.png"));
+    // images are shared by all krushs
+    const std::string animation_key = "krush";
+    const cAnimation_Definition* animation = pAnimation_Definition_Manager->Get(animation_key);
+
+    if (!animation) {
+        cAnimation_Definition* new_animation = pAnimation_Definition_Manager->Create(animation_key);
+
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/krush/big_1.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/krush/big_2.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/krush/big_3.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/krush/big_4.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/krush/small_1.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/krush/small_2.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/krush/small_3.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/krush/small_4.png"));
+
+        animation = new_animation;
+    }
+
+    Set_Animation_Definition(animation);
 
     m_state = STA_FALL;
     Set_Moving_State(STA_WALK);
@@ -144,7 +156,7 @@ void cKrush::DownGrade(bool force /* = 0 */)
         if (m_state == STA_WALK) {
             Set_Moving_State(STA_RUN);
 
-            Col_Move(0.0f, m_images[3].m_image->m_col_h - m_images[4].m_image->m_col_h, 1, 1);
+            Col_Move(0.0f, Get_Image(3)->m_col_h - Get_Image(4)->m_col_h, 1, 1);
 
             // animation
             cParticle_Emitter* anim = new cParticle_Emitter(m_sprite_manager);
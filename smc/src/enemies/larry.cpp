@@ -59,17 +59,29 @@ void cLarry::Init()
     m_explosion_counter = 0.0f;
     m_kill_sound = "ambient/thunder_1.ogg";
 
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/plain_walk_1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/plain_walk_2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/plain_walk_3.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/plain_walk_4.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/plain_turn.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/active_walk_1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/active_walk_2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/active_walk_3.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/active_walk_4.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/active_turn.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/action.png"));
+    // images are shared by all larrys
+    const std::string animation_key = "larry";
+    const cAnimation_Definition* animation = pAnimation_Definition_Manager->Get(animation_key);
+
+    if (!animation) {
+        cAnimation_Definition* new_animation = pAnimation_Definition_Manager->Create(animation_key);
+
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/plain_walk_1.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/plain_walk_2.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/plain_walk_3.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/plain_walk_4.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/plain_turn.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/active_walk_1.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/active_walk_2.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/active_walk_3.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/active_walk_4.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/active_turn.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/larry/grey/action.png"));
+
+        animation = new_animation;
+    }
+
+    Set_Animation_Definition(animation);
 
     Set_Moving_State(STA_WALK);
     Set_Direction(DIR_RIGHT);
@@ -61,20 +61,32 @@ void cPip::Init()
     m_pos_z = 0.093f;
     m_gravity_max = 13.0f;
 
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_1.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_2.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_3.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_4.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_5.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_6.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_7.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_8.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_9.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_10.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/small_1.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/small_2.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/small_3.png")));
-    Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/small_4.png")));
+    // images are shared by all pips
+    const std::string animation_key = "pip";
+    const cAnimation_Definition* animation = pAnimation_Definition_Manager->Get(animation_key);
+
+    if (!animation) {
+        cAnimation_Definition* new_animation = pAnimation_Definition_Manager->Create(animation_key);
+
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_1.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_2.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_3.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_4.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_5.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_6.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_7.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_8.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_9.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/big_10.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/small_1.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/small_2.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/small_3.png")));
+        new_animation->Add_Image(pVideo->Get_Package_Surface(utf8_to_path("enemy/pip/small_4.png")));
+
+        animation = new_animation;
+    }
+
+    Set_Animation_Definition(animation);
 
     m_state = STA_FALL;
     Set_Moving_State(STA_WALK);
@@ -97,6 +109,13 @@ std::string cPip::Get_XML_Type_Name()
     return "pip";
 }
 
+void cPip::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    cEnemy::Get_Sound_Files(sound_files);
+    sound_files.push_back("player/jump_big_power.ogg");
+    sound_files.push_back("wall_hit.wav");
+}
+
 xmlpp::Element* cPip::Save_To_XML_Node(xmlpp::Element* p_element)
 {
     xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
@@ -150,7 +169,7 @@ void cPip::DownGrade(bool force /* = false */)
     else {
         if (m_state == STA_WALK) { // Split big up into two small ones
             Set_Moving_State(STA_RUN);
-            Col_Move(m_images[10].m_image->m_col_w - m_images[0].m_image->m_col_w, 0.0f, true, true);
+            Col_Move(Get_Image(10)->m_col_w - Get_Image(0)->m_col_w, 0.0f, true, true);
 
             // Spawn a second pip so it looks as if cut in twice
             cPip* p_newpip = Copy();
@@ -70,6 +70,9 @@ namespace SMC {
         // Save to XML node
         virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_elemet);
 
+        // Add the sound files this enemy can play
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+
     protected:
         virtual std::string Get_XML_Type_Name();
     };
@@ -88,12 +88,25 @@ void cRokko::Init(void)
     m_kill_sound = "enemy/rokko/hit.wav";
     m_kill_points = 250;
 
-    Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/fly_1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/fly_2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/fly_3.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/break_1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/break_2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/break_3.png"));
+    // images are shared by all rokkos
+    const std::string animation_key = "rokko";
+    const cAnimation_Definition* animation = pAnimation_Definition_Manager->Get(animation_key);
+
+    if (!animation) {
+        cAnimation_Definition* new_animation = pAnimation_Definition_Manager->Create(animation_key);
+
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/fly_1.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/fly_2.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/fly_3.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/break_1.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/break_2.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/rokko/yellow/break_3.png"));
+
+        animation = new_animation;
+    }
+
+    Set_Animation_Definition(animation);
+
     Set_Image_Num(0, true);
     Set_Animation(true);
     Set_Animation_Image_Range(0, 2);
@@ -114,6 +127,12 @@ std::string cRokko::Get_XML_Type_Name()
     return "rokko";
 }
 
+void cRokko::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    cEnemy::Get_Sound_Files(sound_files);
+    sound_files.push_back("enemy/rokko/activate.wav");
+}
+
 xmlpp::Element* cRokko::Save_To_XML_Node(xmlpp::Element* p_element)
 {
     xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
@@ -207,7 +226,7 @@ void cRokko::Set_Max_Distance_Sides(float distance)
 void cRokko::Activate(bool with_sound /* = 1 */)
 {
     if (with_sound) {
-        pAudio->Play_Sound("enemy/rokko/activate.wav");
+        pAudio->Play_Sound_At("enemy/rokko/activate.wav", m_pos_x, m_pos_y);
     }
 
     m_state = STA_FLY;
@@ -122,6 +122,9 @@ namespace SMC {
         // Save to XML node
         virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
 
+        // Add the sound files this enemy can play
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+
     protected:
 
         virtual std::string Get_XML_Type_Name();
@@ -83,6 +83,12 @@ std::string cSpika::Get_XML_Type_Name()
     return "spika";
 }
 
+void cSpika::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    cEnemy::Get_Sound_Files(sound_files);
+    sound_files.push_back("enemy/spika/move.ogg");
+}
+
 xmlpp::Element* cSpika::Save_To_XML_Node(xmlpp::Element* p_element)
 {
     xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
@@ -230,7 +236,7 @@ void cSpika::Update(void)
 
     // play walking sound based on speed
     if (m_walk_count < m_rot_z - 30.0f || m_walk_count > m_rot_z + 30.0f) {
-        pAudio->Play_Sound("enemy/spika/move.ogg");
+        pAudio->Play_Sound_At("enemy/spika/move.ogg", m_pos_x, m_pos_y, -1, -1, 0, SOUND_PRIORITY_LOW);
 
         m_walk_count = m_rot_z;
     }
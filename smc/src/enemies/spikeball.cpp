@@ -145,16 +145,28 @@ void cSpikeball::Set_Color(const DefaultColor& col)
 
     Update_Velocity_Max();
 
-    Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_3.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_4.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_5.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_6.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_7.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_8.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/turn.png"));
-    //Add_Image( pVideo->Get_Package_Surface( "enemy/spikeball/" + filename_dir + "/dead.png" ) );
+    // images are shared by all spikeballs of this color
+    const std::string animation_key = "spikeball/" + filename_dir;
+    const cAnimation_Definition* animation = pAnimation_Definition_Manager->Get(animation_key);
+
+    if (!animation) {
+        cAnimation_Definition* new_animation = pAnimation_Definition_Manager->Create(animation_key);
+
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_1.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_2.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_3.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_4.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_5.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_6.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_7.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/walk_8.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/spikeball/" + filename_dir + "/turn.png"));
+        //Add_Image( pVideo->Get_Package_Surface( "enemy/spikeball/" + filename_dir + "/dead.png" ) );
+
+        animation = new_animation;
+    }
+
+    Set_Animation_Definition(animation);
 
     Set_Image_Num(0, 1);
 }
@@ -109,6 +109,12 @@ std::string cThromp::Get_XML_Type_Name()
     return "thromp";
 }
 
+void cThromp::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    cEnemy::Get_Sound_Files(sound_files);
+    sound_files.push_back("enemy/thromp/hit.ogg");
+}
+
 xmlpp::Element* cThromp::Save_To_XML_Node(xmlpp::Element* p_element)
 {
     xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
@@ -637,7 +643,7 @@ void cThromp::Handle_Collision_Massive(cObjectCollision* collision)
     }
 
     if (Move_Back()) {
-        pAudio->Play_Sound("enemy/thromp/hit.ogg");
+        pAudio->Play_Sound_At("enemy/thromp/hit.ogg", m_pos_x, m_pos_y);
         Generate_Smoke();
     }
 }
@@ -645,7 +651,7 @@ void cThromp::Handle_Collision_Massive(cObjectCollision* collision)
 void cThromp::Handle_out_of_Level(ObjectDirection dir)
 {
     if (Move_Back()) {
-        pAudio->Play_Sound("enemy/thromp/hit.ogg");
+        pAudio->Play_Sound_At("enemy/thromp/hit.ogg", m_pos_x, m_pos_y);
         Generate_Smoke();
     }
 }
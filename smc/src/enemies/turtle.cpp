@@ -91,6 +91,14 @@ std::string cTurtle::Get_XML_Type_Name()
     return "turtle";
 }
 
+void cTurtle::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    cEnemy::Get_Sound_Files(sound_files);
+    sound_files.push_back("enemy/turtle/hit.ogg");
+    sound_files.push_back("enemy/turtle/shell/hit.ogg");
+    sound_files.push_back("enemy/turtle/stand_up.wav");
+}
+
 xmlpp::Element* cTurtle::Save_To_XML_Node(xmlpp::Element* p_element)
 {
     xmlpp::Element* p_node = cEnemy::Save_To_XML_Node(p_element);
@@ -116,7 +124,7 @@ void cTurtle::Load_From_Savegame(cSave_Level_Object* save_object)
         if (m_state != STA_OBJ_LINKED && (mov_state == TURTLE_SHELL_STAND || mov_state == TURTLE_SHELL_RUN)) {
             Set_Turtle_Moving_State(mov_state);
             // set shell image without position changes
-            cSprite::Set_Image(m_images[5 + 5].m_image);
+            cSprite::Set_Image(Get_Image(5 + 5));
         }
     }
 
@@ -177,28 +185,38 @@ void cTurtle::Set_Color(DefaultColor col)
 
     Update_Velocity_Max();
 
-    Clear_Images();
-
-    // FIXME: Red armadillo currently has not enough images!
-    // Hence many images are duplicate for the red armadillo.
-    // Walk
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_3.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_4.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_5.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_6.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_7.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_8.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_9.png"));
-    // Walk Turn
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/turn.png"));
-    // Shell
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/shell.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/shell_look_1.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/shell_look_2.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/shell_look_3.png"));
-    Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/roll.png"));
+    // images are shared by all turtles of this color
+    const std::string animation_key = "turtle/" + filename_dir;
+    const cAnimation_Definition* animation = pAnimation_Definition_Manager->Get(animation_key);
+
+    if (!animation) {
+        cAnimation_Definition* new_animation = pAnimation_Definition_Manager->Create(animation_key);
+
+        // FIXME: Red armadillo currently has not enough images!
+        // Hence many images are duplicate for the red armadillo.
+        // Walk
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_1.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_2.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_3.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_4.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_5.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_6.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_7.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_8.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/walk_9.png"));
+        // Walk Turn
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/turn.png"));
+        // Shell
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/shell.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/shell_look_1.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/shell_look_2.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/shell_look_3.png"));
+        new_animation->Add_Image(pVideo->Get_Package_Surface("enemy/turtle/" + filename_dir + "/roll.png"));
+
+        animation = new_animation;
+    }
+
+    Set_Animation_Definition(animation);
 
     Set_Image_Num(0, 1);
 }
@@ -226,7 +244,7 @@ void cTurtle::DownGrade(bool force /* = 0 */)
         // normal walking
         if (m_turtle_state == TURTLE_WALK) {
             Set_Turtle_Moving_State(TURTLE_SHELL_STAND);
-            Col_Move(0, m_images[0].m_image->m_col_h - m_images[5].m_image->m_col_h, 1, 1);
+            Col_Move(0, Get_Image(0)->m_col_h - Get_Image(5)->m_col_h, 1, 1);
             m_counter = 0.0f;
         }
         // staying
@@ -248,7 +266,7 @@ void cTurtle::DownGrade(bool force /* = 0 */)
         m_vely = 0.0f;
 
         if (m_turtle_state == TURTLE_WALK) {
-            Move(0.0f, m_images[0].m_image->m_h - m_images[5].m_image->m_h, 1);
+            Move(0.0f, Get_Image(0)->m_h - Get_Image(5)->m_h, 1);
         }
 
         Set_Image_Num(5 + 5);
@@ -433,7 +451,7 @@ void cTurtle::Stand_Up(void)
     }
 
     // get space needed to stand up
-    float move_y = m_image->m_col_h - m_images[0].m_image->m_col_h;
+    float move_y = m_image->m_col_h - Get_Image(0)->m_col_h;
 
     cObjectCollisionType* col_list = Collision_Check_Relative(0.0f, move_y, 0.0f, 0.0f, COLLIDE_ONLY_BLOCKING);
 
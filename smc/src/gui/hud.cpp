@@ -19,6 +19,8 @@
 #include "../audio/audio.hpp"
 #include "../video/font.hpp"
 #include "../core/framerate.hpp"
+#include "../core/perf_counters.hpp"
+#include "../core/job_system.hpp"
 #include "../level/level.hpp"
 #include "../core/sprite_manager.hpp"
 #include "../objects/bonusbox.hpp"
@@ -41,6 +43,7 @@ cHudSprite::cHudSprite(cSprite_Manager* sprite_manager)
     m_pos_z = 0.13f;
 
     Set_Ignore_Camera(1);
+    Set_Update_Policy(UPDATE_POLICY_ALWAYS);
 }
 
 cHudSprite::~cHudSprite(void)
@@ -1208,6 +1211,9 @@ void cDebugDisplay::Draw_Debug_Mode(void)
     for (HudSpriteList::iterator itr = m_sprites.begin(); itr != m_sprites.end(); ++itr) {
         (*itr)->Draw();
     }
+
+    // frame counters
+    Draw_Counters();
 }
 
 void cDebugDisplay::Draw_Performance_Debug_Mode(void)
@@ -1362,6 +1368,134 @@ void cDebugDisplay::Draw_Performance_Debug_Mode(void)
 
         pos++;
     }
+
+    // background jobs
+    Draw_Jobs();
+}
+
+void cDebugDisplay::Draw_Jobs(void)
+{
+    vector<cJob_Timing> timings;
+    pJob_System->Get_Timings(timings);
+
+    const float width = 330.0f;
+    const float xpos = static_cast<float>(game_res_w) - width - 20.0f;
+    float ypos = static_cast<float>(game_res_h) * 0.08f;
+
+    // black background
+    Color color = blackalpha128;
+    pVideo->Draw_Rect(xpos - 5, ypos, width + 10, (timings.size() * 12) + 18, m_pos_z - 0.00001f, &color);
+
+    vector<std::string> text_strings;
+    text_strings.push_back(_("Jobs : ") + int_to_string(pJob_System->Get_Job_Count()) + _(" pending, ") + int_to_string(pJob_System->Get_Worker_Count()) + _(" workers"));
+
+    // count, last, average and maximum run time and the last wait for a worker
+    for (vector<cJob_Timing>::const_iterator itr = timings.begin(); itr != timings.end(); ++itr) {
+        const cJob_Timing& timing = (*itr);
+
+        text_strings.push_back(timing.m_name + " : " + int_to_string(timing.m_count) + "x " + float_to_string(timing.m_last_ms, 2) + " / " + float_to_string(timing.m_total_ms / timing.m_count, 2) + " / " + float_to_string(timing.m_max_ms, 2) + _(" ms wait ") + float_to_string(timing.m_wait_ms, 2));
+    }
+
+    unsigned int pos = 0;
+
+    for (vector<std::string>::const_iterator itr = text_strings.begin(); itr != text_strings.end(); ++itr) {
+        ypos += 12;
+
+        cGL_Surface* surface_temp = pFont->Render_Text(pFont->m_font_very_small, *itr, white);
+
+        // create request
+        cSurface_Request* request = new cSurface_Request();
+        surface_temp->Blit(xpos + (pos ? 10 : 0), ypos, m_pos_z, request);
+        request->m_delete_texture = 1;
+
+        // add request
+        pRenderer->Add(request);
+
+        surface_temp->m_auto_del_img = 0;
+        delete surface_temp;
+
+        pos++;
+    }
+}
+
+void cDebugDisplay::Draw_Counters(void)
+{
+    const float width = 300.0f;
+    const float graph_height = 50.0f;
+    const float xpos = (static_cast<float>(game_res_w) * 0.5f) - (width * 0.5f);
+    float ypos = static_cast<float>(game_res_h) * 0.08f;
+
+    // black background
+    Color color = blackalpha128;
+    pVideo->Draw_Rect(xpos - 5, ypos, width + 10, (PERF_COUNT_SIZE * 12) + graph_height + 36, m_pos_z - 0.00001f, &color);
+
+    vector<std::string> text_strings;
+
+    if (pPerf_Counters->Is_Dumping()) {
+        text_strings.push_back(_("Counters (writing CSV)"));
+    }
+    else {
+        text_strings.push_back(_("Counters"));
+    }
+
+    for (unsigned int i = 0; i < PERF_COUNT_SIZE; i++) {
+        const Perf_Counter_Type type = static_cast<Perf_Counter_Type>(i);
+        text_strings.push_back(cPerf_Counters::Get_Name(type) + " : " + int_to_string(pPerf_Counters->Get_Last(type)));
+    }
+
+    unsigned int pos = 0;
+
+    for (vector<std::string>::const_iterator itr = text_strings.begin(); itr != text_strings.end(); ++itr) {
+        ypos += 12;
+
+        // the graphed counter is highlighted
+        const Color text_color = (pos == static_cast<unsigned int>(pPerf_Counters->m_graph_type) + 1) ? yellow : white;
+        cGL_Surface* surface_temp = pFont->Render_Text(pFont->m_font_very_small, *itr, text_color);
+
+        // create request
+        cSurface_Request* request = new cSurface_Request();
+        surface_temp->Blit(xpos + (pos ? 10 : 0), ypos, m_pos_z, request);
+        request->m_delete_texture = 1;
+
+        // add request
+        pRenderer->Add(request);
+
+        surface_temp->m_auto_del_img = 0;
+        delete surface_temp;
+
+        pos++;
+    }
+
+    // rolling graph with the newest frame on the right
+    ypos += 20.0f + graph_height;
+
+    const Uint32 max = pPerf_Counters->Get_History_Max(pPerf_Counters->m_graph_type);
+    const float bar_width = width / cPerf_Counters::m_history_size;
+
+    if (!max) {
+        return;
+    }
+
+    for (unsigned int age = 0; age < cPerf_Counters::m_history_size; age++) {
+        const float height = graph_height * pPerf_Counters->Get_History(pPerf_Counters->m_graph_type, age) / max;
+
+        if (height < 1.0f) {
+            continue;
+        }
+
+        pVideo->Draw_Rect(xpos + width - ((age + 1) * bar_width), ypos - height, bar_width, height, m_pos_z, &lightgreen);
+    }
+
+    // maximum
+    cGL_Surface* surface_temp = pFont->Render_Text(pFont->m_font_very_small, _("max ") + int_to_string(max), white);
+
+    cSurface_Request* request = new cSurface_Request();
+    surface_temp->Blit(xpos, ypos - graph_height - 12, m_pos_z + 0.00001f, request);
+    request->m_delete_texture = 1;
+    pRenderer->Add(request);
+
+    surface_temp->m_auto_del_img = 0;
+    delete surface_temp;
 }
 
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -256,6 +256,10 @@ namespace SMC {
         void Draw_Debug_Mode(void);
         // draw the performance debug mode info
         void Draw_Performance_Debug_Mode(void);
+        // draw the run times of the background jobs
+        void Draw_Jobs(void);
+        // draw the frame counters with a graph of the selected counter
+        void Draw_Counters(void);
 
         // set the debug text to display
         void Set_Text(const std::string& ntext, float display_time = speedfactor_fps * 2.0f);
@@ -503,6 +503,7 @@ void cMenuCore::Load(const MenuID menu /* = MENU_MAIN */, const GameMode exit_ga
     pMouseCursor->Double_Click(0);
 
     // default background color to white
+    pVideo->Render_Finish();
     glClearColor(1, 1, 1, 1);
 
     // Set ID
@@ -27,16 +27,20 @@
 #include "../core/framerate.hpp"
 #include "../user/savegame.hpp"
 #include "../video/renderer.hpp"
+#include "../video/gl_surface.hpp"
 #include "../level/level.hpp"
 #include "../input/keyboard.hpp"
 #include "../level/level_editor.hpp"
 #include "../core/math/utilities.hpp"
+#include "../core/property_helper.hpp"
 #include "../core/i18n.hpp"
 #include "../core/math/size.hpp"
 #include "../core/filesystem/filesystem.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/package_manager.hpp"
 #include "../core/main.hpp"
+#include "../level/level_library.hpp"
+#include "../core/editor/editor.hpp"
 
 using namespace std;
 
@@ -317,12 +321,13 @@ void cMenu_Main::Draw(void)
 cMenu_Start::cMenu_Start(void)
     : cMenu_Base()
 {
-
+    m_level_thumbnail = NULL;
+    m_level_thumbnail_imageset = NULL;
 }
 
 cMenu_Start::~cMenu_Start(void)
 {
-
+    Set_Level_Thumbnail("");
 }
 
 void cMenu_Start::Init(void)
@@ -420,7 +425,8 @@ void cMenu_Start::Init_GUI(void)
 
     // ### Level ###
     CEGUI::Listbox* listbox_levels = static_cast<CEGUI::Listbox*>(CEGUI::WindowManager::getSingleton().getWindow("listbox_levels"));
-    listbox_levels->setSortingEnabled(1);
+    // sorted by the level library
+    listbox_levels->setSortingEnabled(0);
 
     // events
     listbox_levels->subscribeEvent(CEGUI::Listbox::EventSelectionChanged, CEGUI::Event::Subscriber(&cMenu_Start::Level_Select, this));
@@ -428,6 +434,26 @@ void cMenu_Start::Init_GUI(void)
     listbox_levels->subscribeEvent(CEGUI::Window::EventKeyDown, CEGUI::Event::Subscriber(&cMenu_Start::Listbox_Keydown, this));
     listbox_levels->subscribeEvent(CEGUI::Window::EventCharacterKey, CEGUI::Event::Subscriber(&cMenu_Start::Listbox_Character_Key, this));
 
+    // Level filter
+    CEGUI::Editbox* editbox_filter = static_cast<CEGUI::Editbox*>(CEGUI::WindowManager::getSingleton().getWindow("editbox_level_filter"));
+    editbox_filter->subscribeEvent(CEGUI::Editbox::EventTextChanged, CEGUI::Event::Subscriber(&cMenu_Start::Level_Filter_Changed, this));
+
+    // Level sort
+    CEGUI::Combobox* combo_sort = static_cast<CEGUI::Combobox*>(CEGUI::WindowManager::getSingleton().getWindow("combo_level_sort"));
+
+    CEGUI::ListboxTextItem* sort_item = new CEGUI::ListboxTextItem(UTF8_("Name"), LEVEL_LIBRARY_SORT_NAME);
+    combo_sort->addItem(sort_item);
+    sort_item = new CEGUI::ListboxTextItem(UTF8_("Author"), LEVEL_LIBRARY_SORT_AUTHOR);
+    combo_sort->addItem(sort_item);
+    sort_item = new CEGUI::ListboxTextItem(UTF8_("Difficulty"), LEVEL_LIBRARY_SORT_DIFFICULTY);
+    combo_sort->addItem(sort_item);
+    sort_item = new CEGUI::ListboxTextItem(UTF8_("Objects"), LEVEL_LIBRARY_SORT_OBJECTS);
+    combo_sort->addItem(sort_item);
+
+    combo_sort->setItemSelectState(static_cast<size_t>(0), 1);
+    combo_sort->setText(UTF8_("Name"));
+    combo_sort->subscribeEvent(CEGUI::Combobox::EventListSelectionAccepted, CEGUI::Event::Subscriber(&cMenu_Start::Level_Sort_Select, this));
+
     // Level Buttons
     CEGUI::PushButton* button_new = static_cast<CEGUI::PushButton*>(CEGUI::WindowManager::getSingleton().getWindow("button_level_new"));
     button_new->subscribeEvent(CEGUI::PushButton::EventClicked, CEGUI::Event::Subscriber(&cMenu_Start::Button_Level_New_Clicked, this));
@@ -491,38 +517,45 @@ void cMenu_Start::Draw(void)
     Draw_End();
 }
 
-void cMenu_Start::Get_Levels(fs::path dir, CEGUI::colour color)
+void cMenu_Start::Get_Levels(void)
 {
     // Level Listbox
     CEGUI::Listbox* listbox_levels = static_cast<CEGUI::Listbox*>(CEGUI::WindowManager::getSingleton().getWindow("listbox_levels"));
+    listbox_levels->resetList();
 
-    // get all files
-    vector<fs::path> lvl_files = Get_Directory_Files(dir, ".smclvl", false, false);
+    // filter and sort
+    CEGUI::Editbox* editbox_filter = static_cast<CEGUI::Editbox*>(CEGUI::WindowManager::getSingleton().getWindow("editbox_level_filter"));
+    CEGUI::Combobox* combo_sort = static_cast<CEGUI::Combobox*>(CEGUI::WindowManager::getSingleton().getWindow("combo_level_sort"));
+    CEGUI::ListboxItem* sort_item = combo_sort->getSelectedItem();
+    Level_Library_Sort sort = LEVEL_LIBRARY_SORT_NAME;
 
-    // list all available levels
-    for (vector<fs::path>::iterator itr = lvl_files.begin(); itr != lvl_files.end(); ++itr) {
-        // get filename without base directory
-        fs::path lvl_path = (*itr).filename();
+    if (sort_item) {
+        sort = static_cast<Level_Library_Sort>(sort_item->getID());
+    }
 
-        // erase file extension only if smclvl
-        if (lvl_path.extension() == fs::path(".smclvl"))
-            lvl_path = lvl_path.stem();
+    vector<const cLevel_Library::cLevel_Info*> levels;
+    pLevel_Library->Query(editbox_filter->getText().c_str(), sort, levels);
 
-        // create listbox item
-        std::string lvl_name = path_to_utf8(lvl_path);
-        CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem(reinterpret_cast<const CEGUI::utf8*>(lvl_name.c_str()));
-        item->setTextColours(color);
+    const CEGUI::colour color_game(1, 0.8f, 0.6f);
+    const CEGUI::colour color_user(0.8f, 1, 0.6f);
 
-        // check if item with the same name already exists
-        CEGUI::ListboxTextItem* item_old = static_cast<CEGUI::ListboxTextItem*>(listbox_levels->findItemWithText(lvl_name, NULL));
+    // list all available levels
+    for (vector<const cLevel_Library::cLevel_Info*>::const_iterator itr = levels.begin(); itr != levels.end(); ++itr) {
+        const cLevel_Library::cLevel_Info* info = (*itr);
 
-        if (item_old) {
-            // mix colors
-            item->setTextColours(item->getTextColours().d_top_left, item->getTextColours().d_top_right, item_old->getTextColours().d_bottom_left, item_old->getTextColours().d_bottom_right);
-            // remove old item
-            listbox_levels->removeItem(item_old);
-        }
+        // create listbox item
+        CEGUI::ListboxTextItem* item = new CEGUI::ListboxTextItem(reinterpret_cast<const CEGUI::utf8*>(info->m_name.c_str()));
 
+        // mix colors
+        if (info->m_user && info->m_game) {
+            item->setTextColours(color_user, color_user, color_game, color_game);
+        }
+        else if (info->m_user) {
+            item->setTextColours(color_user);
+        }
+        else {
+            item->setTextColours(color_game);
+        }
 
         item->setSelectionColours(CEGUI::colour(0.33f, 0.33f, 0.33f));
         item->setSelectionBrushImage("TaharezLook", "ListboxSelectionBrush");
@@ -530,6 +563,50 @@ void cMenu_Start::Get_Levels(fs::path dir, CEGUI::colour color)
     }
 }
 
+void cMenu_Start::Set_Level_Thumbnail(const std::string& lvl_name)
+{
+    CEGUI::WindowManager& wmgr = CEGUI::WindowManager::getSingleton();
+
+    if (m_level_thumbnail_imageset) {
+        if (wmgr.isWindowPresent("image_level_thumbnail")) {
+            wmgr.getWindow("image_level_thumbnail")->setProperty("Image", "");
+        }
+
+        delete m_level_thumbnail_imageset->getTexture();
+        CEGUI::ImagesetManager::getSingleton().destroy(*m_level_thumbnail_imageset);
+        m_level_thumbnail_imageset = NULL;
+    }
+
+    if (m_level_thumbnail) {
+        delete m_level_thumbnail;
+        m_level_thumbnail = NULL;
+    }
+
+    if (lvl_name.empty()) {
+        return;
+    }
+
+    const fs::path filename = cLevel_Library::Get_Thumbnail_Filename(lvl_name);
+
+    // only created when saved in the editor
+    if (!File_Exists(filename)) {
+        return;
+    }
+
+    m_level_thumbnail = pVideo->Load_GL_Surface(filename, 0, 0);
+
+    if (!m_level_thumbnail) {
+        return;
+    }
+
+    // create CEGUI link
+    cEditor_CEGUI_Texture* texture = new cEditor_CEGUI_Texture(*pGuiRenderer, m_level_thumbnail->m_image, CEGUI::Size(m_level_thumbnail->m_tex_w, m_level_thumbnail->m_tex_h));
+    m_level_thumbnail_imageset = &CEGUI::ImagesetManager::getSingleton().create("level_thumbnail", *texture);
+    m_level_thumbnail_imageset->defineImage("default", CEGUI::Point(0, 0), texture->getSize(), CEGUI::Point(0, 0));
+
+    wmgr.getWindow("image_level_thumbnail")->setProperty("Image", "set:level_thumbnail image:default");
+}
+
 bool cMenu_Start::Highlight_Level(std::string lvl_name)
 {
     if (lvl_name.empty()) {
@@ -780,13 +857,8 @@ void cMenu_Start::Update_Lists(void)
     }
 
     // ### Level ###
-    CEGUI::Listbox* listbox_levels = static_cast<CEGUI::Listbox*>(CEGUI::WindowManager::getSingleton().getWindow("listbox_levels"));
-    listbox_levels->resetList();
-
-    // get game level
-    Get_Levels(pPackage_Manager->Get_Game_Level_Path(), CEGUI::colour(1, 0.8f, 0.6f));
-    // get user level
-    Get_Levels(pPackage_Manager->Get_User_Level_Path(), CEGUI::colour(0.8f, 1, 0.6f));
+    pLevel_Library->Update();
+    Get_Levels();
 }
 
 bool cMenu_Start::TabControl_Selection_Changed(const CEGUI::EventArgs& e)
@@ -1099,13 +1171,30 @@ bool cMenu_Start::Level_Select(const CEGUI::EventArgs& event)
     const CEGUI::WindowEventArgs& windowEventArgs = static_cast<const CEGUI::WindowEventArgs&>(event);
     CEGUI::ListboxItem* item = static_cast<CEGUI::Listbox*>(windowEventArgs.window)->getFirstSelectedItem();
 
-    // set level something
+    CEGUI::Window* text_details = CEGUI::WindowManager::getSingleton().getWindow("text_level_details");
+
+    // show level details
     if (item) {
-        // todo : needs level manager
+        const cLevel_Library::cLevel_Info* info = pLevel_Library->Get_Level(item->getText().c_str());
+
+        if (info) {
+            std::string details = _("Author : ") + info->m_author + "\n";
+            details += _("Difficulty : ") + (info->m_difficulty ? int_to_string(info->m_difficulty) : _("Unknown")) + "\n";
+            details += _("Land Type : ") + Get_Level_Land_Type_Name(info->m_land_type) + "\n";
+            details += _("Objects : ") + int_to_string(info->m_object_count);
+
+            text_details->setText(reinterpret_cast<const CEGUI::utf8*>(details.c_str()));
+            Set_Level_Thumbnail(info->m_name);
+        }
+        else {
+            text_details->setText("");
+            Set_Level_Thumbnail("");
+        }
     }
     // clear
     else {
-        // todo : needs level manager
+        text_details->setText("");
+        Set_Level_Thumbnail("");
     }
 
     return 1;
@@ -1124,6 +1213,17 @@ bool cMenu_Start::Level_Select_Final_List(const CEGUI::EventArgs& event)
     return 1;
 }
 
+bool cMenu_Start::Level_Filter_Changed(const CEGUI::EventArgs& event)
+{
+    Get_Levels();
+    return 1;
+}
+
+bool cMenu_Start::Level_Sort_Select(const CEGUI::EventArgs& event)
+{
+    Get_Levels();
+    return 1;
+}
 
 bool cMenu_Start::Button_Level_New_Clicked(const CEGUI::EventArgs& event)
 {
@@ -3196,6 +3296,7 @@ void cMenu_Credits::Init_GUI(void)
 void cMenu_Credits::Enter(const GameMode old_mode /* = MODE_NOTHING */)
 {
     // black background because of fade alpha
+    pVideo->Render_Finish();
     glClearColor(0, 0, 0, 1);
 
     if (old_mode == MODE_MENU) {
@@ -3211,6 +3312,7 @@ void cMenu_Credits::Leave(const GameMode next_mode /* = MODE_NOTHING */)
         Menu_Fade(0);
 
         // white background
+        pVideo->Render_Finish();
         glClearColor(1, 1, 1, 1);
     }
 
@@ -93,8 +93,10 @@ namespace SMC {
         virtual void Update(void);
         virtual void Draw(void);
 
-        // Get all levels from the given directory
-        void Get_Levels(boost::filesystem::path dir, CEGUI::colour color);
+        // Fill the level listbox from the level library with the current filter and sort
+        void Get_Levels(void);
+        // Show the thumbnail of the level or clear it if empty
+        void Set_Level_Thumbnail(const std::string& lvl_name);
 
         /* Highlight the given level
          * and activates level tab if needed
@@ -153,6 +155,10 @@ namespace SMC {
         bool Level_Select(const CEGUI::EventArgs& event);
         // level selected for entering event
         bool Level_Select_Final_List(const CEGUI::EventArgs& event);
+        // level filter text changed event
+        bool Level_Filter_Changed(const CEGUI::EventArgs& event);
+        // level sort selected event
+        bool Level_Sort_Select(const CEGUI::EventArgs& event);
 
         // level new button event
         bool Button_Level_New_Clicked(const CEGUI::EventArgs& event);
@@ -169,6 +175,11 @@ namespace SMC {
         CEGUI::String m_listbox_search_buffer;
         // counter until buffer is cleared
         float m_listbox_search_buffer_counter;
+
+    private:
+        // thumbnail of the selected level
+        cGL_Surface* m_level_thumbnail;
+        CEGUI::Imageset* m_level_thumbnail_imageset;
     };
 
     /* *** *** *** *** *** *** *** cMenu_Options *** *** *** *** *** *** *** *** *** *** */
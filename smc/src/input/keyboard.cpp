@@ -22,6 +22,7 @@
 #include "../gui/menu.hpp"
 #include "../overworld/overworld.hpp"
 #include "../core/framerate.hpp"
+#include "../core/perf_counters.hpp"
 #include "../audio/audio.hpp"
 #include "../level/level.hpp"
 #include "../user/preferences.hpp"
@@ -255,6 +256,24 @@ bool cKeyboard::Key_Down(SDLKey key)
 
         game_debug_performance = !game_debug_performance;
     }
+    // write the frame counters into a CSV file
+    else if (key == SDLK_F7 && pKeyboard->Is_Ctrl_Down()) {
+        if (pPerf_Counters->Is_Dumping()) {
+            pPerf_Counters->Stop_Dump();
+            pHud_Debug->Set_Text("Counters CSV closed");
+        }
+        else {
+            boost::filesystem::path filename = pPerf_Counters->Start_Dump();
+
+            if (!filename.empty()) {
+                pHud_Debug->Set_Text("Writing counters to " + path_to_utf8(filename.filename()), speedfactor_fps * 5.0f);
+            }
+        }
+    }
+    // graph the next frame counter
+    else if (key == SDLK_F7 && game_debug) {
+        pPerf_Counters->m_graph_type = static_cast<Perf_Counter_Type>((pPerf_Counters->m_graph_type + 1) % PERF_COUNT_SIZE);
+    }
 
     return 0;
 }
@@ -36,6 +36,19 @@ using namespace std;
 
 namespace SMC {
 
+// Get the journal of the active editor or NULL
+static cEditor_Journal* Get_Editor_Journal(void)
+{
+    if (Game_Mode == MODE_LEVEL && pLevel_Editor) {
+        return &pLevel_Editor->m_journal;
+    }
+    else if (Game_Mode == MODE_OVERWORLD && pWorld_Editor) {
+        return &pWorld_Editor->m_journal;
+    }
+
+    return NULL;
+}
+
 /* *** *** *** *** *** cSelectedObject *** *** *** *** *** *** *** *** *** *** *** *** */
 
 cSelectedObject::cSelectedObject(void)
@@ -328,21 +341,13 @@ cObjectCollision* cMouseCursor::Get_First_Editor_Collsion(float px /* = 0.0f */,
 
 cObjectCollision* cMouseCursor::Get_First_Mouse_Collision(const GL_rect& mouse_rect)
 {
-    cSprite_List sprite_objects;
-    m_sprite_manager->Get_Objects_sorted(sprite_objects, 1, 1);
+    m_pick_index.Update(m_sprite_manager, pActive_Player);
 
-    // check objects
-    for (cSprite_List::reverse_iterator itr = sprite_objects.rbegin(); itr != sprite_objects.rend(); ++itr) {
-        cSprite* obj = (*itr);
+    // top-most object by editor z position
+    cSprite* obj = m_pick_index.Get_Top_Sprite(mouse_rect);
 
-        // ignore spawned or destroyed objects
-        if (obj->m_spawned || obj->m_auto_destroy) {
-            continue;
-        }
-
-        if (mouse_rect.Intersects(obj->m_start_rect)) {
-            return Create_Collision_Object(this, obj, COL_VTYPE_INTERNAL);
-        }
+    if (obj) {
+        return Create_Collision_Object(this, obj, COL_VTYPE_INTERNAL);
     }
 
     return NULL;
@@ -898,8 +903,13 @@ bool cMouseCursor::Get_Snap_Pos(GL_point& new_pos, int snap, cSelectedObject* sr
     int num_snap_obj = 0;
     cSprite* snap_obj = NULL;
 
+    // objects near the snap rect
+    cSprite_List sprite_objects;
+    m_pick_index.Update(m_sprite_manager, pActive_Player);
+    m_pick_index.Query(full_snap_rect, sprite_objects);
+
     // check objects for overlap
-    for (cSprite_List::iterator itr = m_sprite_manager->objects.begin(); itr != m_sprite_manager->objects.end(); ++itr) {
+    for (cSprite_List::iterator itr = sprite_objects.begin(); itr != sprite_objects.end(); ++itr) {
         cSprite* obj = (*itr);
 
         // don't check selected objects
@@ -1155,6 +1165,12 @@ cSprite* cMouseCursor::Copy(const cSprite* copy_object, float px, float py) cons
     // add it
     m_sprite_manager->Add(new_sprite);
 
+    cEditor_Journal* journal = Get_Editor_Journal();
+
+    if (journal) {
+        journal->Record_Add(new_sprite);
+    }
+
     return new_sprite;
 }
 
@@ -1187,6 +1203,12 @@ void cMouseCursor::Delete(cSprite* sprite)
 
     // delete object
     if (editor_enabled) {
+        cEditor_Journal* journal = Get_Editor_Journal();
+
+        if (journal) {
+            journal->Record_Delete(sprite);
+        }
+
         sprite->Destroy();
     }
 }
@@ -1361,8 +1383,13 @@ void cMouseCursor::Update_Selection(void)
         Clear_Selected_Objects();
     }
 
+    // objects near the selection rect
+    cSprite_List sprite_objects;
+    m_pick_index.Update(m_sprite_manager, pActive_Player);
+    m_pick_index.Query(rect, sprite_objects);
+
     // add selected objects
-    for (cSprite_List::iterator itr = m_sprite_manager->objects.begin(); itr != m_sprite_manager->objects.end(); ++itr) {
+    for (cSprite_List::iterator itr = sprite_objects.begin(); itr != sprite_objects.end(); ++itr) {
         cSprite* obj = (*itr);
 
         // don't check spawned/destroyed objects
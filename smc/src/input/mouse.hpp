@@ -20,6 +20,7 @@
 #include "../objects/movingsprite.hpp"
 #include "../core/math/rect.hpp"
 #include "../core/math/vector.hpp"
+#include "../core/editor/editor_pick_index.hpp"
 
 namespace SMC {
 
@@ -260,6 +261,9 @@ namespace SMC {
         cSprite* m_last_clicked_object;
         // counter for catching double-clicks
         float m_click_counter;
+
+        // editor rects of the sprite manager for picking
+        cEditor_Pick_Index m_pick_index;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
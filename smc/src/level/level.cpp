@@ -57,6 +57,8 @@
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/package_manager.hpp"
 #include "../core/filesystem/boost_relative.hpp"
+#include "../core/filesystem/xml_save_writer.hpp"
+#include "../level/level_library.hpp"
 #include "../overworld/world_editor.hpp"
 #include "../scripting/events/key_down_event.hpp"
 #include "../core/global_basic.hpp"
@@ -190,11 +192,14 @@ cLevel* cLevel::Load_From_File(fs::path filename)
 {
     if (filename.empty())
         throw(InvalidLevelError("Empty level filename!"));
-    if (!File_Exists(filename)) {
+    if (!pPackage_Manager->Resource_Exists(filename)) {
         std::string msg = "Level file not found: " + path_to_utf8(filename);
         throw (InvalidLevelError(msg));
     }
 
+    // a background save of the level may not be finished
+    pSave_Writer->Wait();
+
     // This is our loader
     cLevelLoader loader;
 
@@ -259,6 +264,11 @@ void cLevel::Unload(bool delayed /* = 0 */)
     // no version
     m_engine_version = -1;
 
+    // changes autosaved by the editor but not saved
+    if (pLevel_Editor) {
+        pLevel_Editor->Discard_Journal(m_level_filename);
+    }
+
     debug_print("Unloaded level: %s\n", path_to_utf8(m_level_filename).c_str());
     m_level_filename.clear();
 
@@ -279,10 +289,10 @@ void cLevel::Unload(bool delayed /* = 0 */)
     m_sprite_manager->Delete_All();
 }
 
-fs::path cLevel::Save_To_File(fs::path filename /* = fs::path() */)
+xmlpp::Document* cLevel::Create_Document(void)
 {
-    xmlpp::Document doc;
-    xmlpp::Element* p_root = doc.create_root_node("level");
+    xmlpp::Document* doc = new xmlpp::Document();
+    xmlpp::Element* p_root = doc->create_root_node("level");
     xmlpp::Element* p_node = NULL;
 
     // <information>
@@ -338,8 +348,23 @@ fs::path cLevel::Save_To_File(fs::path filename /* = fs::path() */)
     p_node->add_child_text(m_script);
     // </script>
 
+    return doc;
+}
+
+fs::path cLevel::Save_To_File(fs::path filename /* = fs::path() */)
+{
+    xmlpp::Document* doc = Create_Document();
+
     // Write to file (raises xmlpp::exception on write error)
-    doc.write_to_file_formatted(Glib::filename_from_utf8(path_to_utf8(filename)));
+    try {
+        doc->write_to_file_formatted(Glib::filename_from_utf8(path_to_utf8(filename)));
+    }
+    catch (xmlpp::exception&) {
+        delete doc;
+        throw;
+    }
+
+    delete doc;
     debug_print("Wrote level file '%s'.\n", path_to_utf8(filename).c_str());
 
     return filename;
@@ -359,20 +384,15 @@ void cLevel::Save(void)
         m_level_filename = fs::absolute(m_level_filename, pPackage_Manager->Get_User_Level_Path());
     }
 
-    try {
-        Save_To_File(m_level_filename);
-    }
-    catch (xmlpp::exception& e) {
-        cerr << "Error: Couldn't save level file: " << e.what() << endl;
-        cerr << "Is the file read-only?" << endl;
-        pHud_Debug->Set_Text(_("Couldn't save level ") + path_to_utf8(m_level_filename), speedfactor_fps * 5.0f);
+    const std::string level_name = path_to_utf8(Trim_Filename(m_level_filename, false, false));
 
-        // Abort
-        return;
-    }
+    // shown in the level browser
+    cLevel_Library::Save_Thumbnail(level_name);
 
-    // Display nice completion message
-    pHud_Debug->Set_Text(_("Level ") + path_to_utf8(Trim_Filename(m_level_filename, false, false)) + _(" saved"));
+    /* write in the background
+     * the autosaved changes are part of the level if it was written
+    */
+    pSave_Writer->Write(Create_Document(), m_level_filename, _("Level ") + level_name + _(" saved"), _("Couldn't save level ") + path_to_utf8(m_level_filename), cEditor_Journal::Get_Filename(m_level_filename));
 }
 
 void cLevel::Delete(void)
@@ -436,6 +456,9 @@ void cLevel::Init(void)
         }
     }
 
+    // decode the level sounds in the background
+    pAudio->Prewarm_Sounds(m_sprite_manager);
+
 #ifdef ENABLE_MRUBY
     Reinitialize_MRuby_Interpreter();
 #endif
@@ -926,7 +949,7 @@ void cLevel::Set_Music(fs::path filename)
 
     m_musicfile = filename;
     // check if music is available
-    m_valid_music = File_Exists(filename);
+    m_valid_music = pPackage_Manager->Resource_Exists(filename);
 }
 
 void cLevel::Set_Filename(fs::path filename, bool rename_old /* = true */)
@@ -1061,7 +1084,8 @@ void cLevel::Reinitialize_MRuby_Interpreter()
 
     // Run the mruby code associated with this level (this sets up
     // all the event handlers the user wants to register)
-    m_mruby->Run_Code(m_script, "(level script)");
+    // cached per level file
+    m_mruby->Run_Code(m_script, "(level script)", path_to_utf8(m_level_filename));
 }
 #endif
 
@@ -49,11 +49,18 @@ namespace SMC {
         */
         void Unload(bool delayed = 0);
 
+        /* Create the XML document of the level
+         * The document only contains copied values and can be written in another thread.
+         * The caller owns the document.
+        */
+        xmlpp::Document* Create_Document(void);
         // Save the level to a file as XML.
         // Raises xmlpp::exception on failure to write the XML file.
         boost::filesystem::path Save_To_File(boost::filesystem::path filename = boost::filesystem::path());
 
-        // Save the Level
+        /* Save the Level
+         * The file is written in the background and the result shown in the hud.
+        */
         void Save(void);
         // Delete and unload
         void Delete(void);
@@ -150,10 +157,19 @@ namespace SMC {
         static bool Is_Level_Object_Element(const CEGUI::String& element)
         {
             if (element == "information" || element == "settings" || element == "background" || element == "music" ||
-                    element == "global_effect" || element == "player" || element == "sound" || element == "particle_emitter" ||
-                    element == "path" || element == "sprite" || element == "powerup" || element == "item" || element == "enemy" ||
-                    element == "levelexit" || element == "level_entry" || element == "enemystopper" || element == "box" ||
-                    element == "moving_platform" || element == "falling_platform" || element == "ball" || element == "lava" || element == "crate") {
+                    element == "global_effect" || element == "player" || Is_Level_Sprite_Element(element)) {
+                return 1;
+            }
+
+            return 0;
+        };
+        // Returns true if the level element creates a placeable sprite
+        static bool Is_Level_Sprite_Element(const CEGUI::String& element)
+        {
+            if (element == "sound" || element == "particle_emitter" || element == "path" || element == "sprite" ||
+                    element == "powerup" || element == "item" || element == "enemy" || element == "levelexit" ||
+                    element == "level_entry" || element == "enemystopper" || element == "box" || element == "moving_platform" ||
+                    element == "falling_platform" || element == "ball" || element == "lava" || element == "crate") {
                 return 1;
             }
 
@@ -17,6 +17,7 @@
 #include "../user/preferences.hpp"
 #include "../core/game_core.hpp"
 #include "../video/gl_surface.hpp"
+#include "../video/renderer.hpp"
 #include "../core/framerate.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/package_manager.hpp"
@@ -270,47 +271,71 @@ void cBackground::Draw(void)
             posy_final += game_res_h - m_image_1->m_h;
         }
 
-        // align start position x
-        // to left
-        while (posx_final > 0.0f) {
-            posx_final -= m_image_1->m_w;
-        }
-        // to right
-        while (posx_final < -m_image_1->m_w) {
-            posx_final += m_image_1->m_w;
+        const float image_w = m_image_1->m_w;
+        const float image_h = m_image_1->m_h;
+
+        // align start position x to the image left of the screen
+        posx_final = fmod(posx_final, image_w);
+
+        if (posx_final > 0.0f) {
+            posx_final -= image_w;
         }
-        // align start position y
+
+        // tiles into all directions
         if (m_type == BG_IMG_ALL) {
-            // to top
-            while (posy_final > 0.0f) {
-                posy_final -= m_image_1->m_h;
-            }
-            // to bottom
-            while (posy_final < -m_image_1->m_h) {
-                posy_final += m_image_1->m_h;
+            // align start position y to the image above the screen
+            posy_final = fmod(posy_final, image_h);
+
+            if (posy_final > 0.0f) {
+                posy_final -= image_h;
             }
         }
 
-        // draw until width is filled
-        while (posx_final < game_res_w) {
-            // draw horizontal
-            m_image_1->Blit(posx_final, posy_final, m_pos_z);
+        // a rotated image can not be repeated by the texture coordinates
+        if (!Is_Float_Equal(m_image_1->m_base_rot_x, 0.0f) || !Is_Float_Equal(m_image_1->m_base_rot_y, 0.0f) || !Is_Float_Equal(m_image_1->m_base_rot_z, 0.0f)) {
+            // draw until width is filled
+            while (posx_final < game_res_w) {
+                // draw horizontal
+                m_image_1->Blit(posx_final, posy_final, m_pos_z);
 
-            // draw vertical
-            if (m_type == BG_IMG_ALL) {
-                float posy_temp = posy_final;
+                // draw vertical
+                if (m_type == BG_IMG_ALL) {
+                    float posy_temp = posy_final;
 
-                // draw until height is filled
-                while (posy_temp < game_res_h - m_image_1->m_h) {
-                    // change position first as this position y is already drawn
-                    posy_temp += m_image_1->m_h;
+                    // draw until height is filled
+                    while (posy_temp < game_res_h - image_h) {
+                        // change position first as this position y is already drawn
+                        posy_temp += image_h;
 
-                    m_image_1->Blit(posx_final, posy_temp, m_pos_z);
+                        m_image_1->Blit(posx_final, posy_temp, m_pos_z);
+                    }
                 }
+
+                posx_final += image_w;
             }
 
-            posx_final += m_image_1->m_w;
+            return;
         }
+
+        // one quad covering the screen width with repeating texture coordinates
+        cSurface_Request* request = new cSurface_Request();
+        m_image_1->Blit_Data(request);
+
+        request->m_pos_x += posx_final;
+        request->m_pos_y += posy_final;
+        request->m_pos_z = m_pos_z;
+        // the texture coordinates repeat the drawn image size
+        request->m_w = game_res_w - posx_final;
+        request->m_tex_end_x = request->m_w / m_image_1->m_start_w;
+
+        if (m_type == BG_IMG_ALL) {
+            request->m_h = game_res_h - posy_final;
+            request->m_tex_end_y = request->m_h / m_image_1->m_start_h;
+        }
+
+        request->m_tex_repeat = 1;
+
+        pRenderer->Add(request);
     }
 }
 
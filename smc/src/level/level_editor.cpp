@@ -28,10 +28,20 @@
 #include "../core/filesystem/filesystem.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/editor/editor_items_loader.hpp"
+#include "../core/filesystem/package_manager.hpp"
+#include "../core/filesystem/xml_save_writer.hpp"
+#include "../core/framerate.hpp"
 #include "level_loader.hpp"
 
+using namespace std;
+
+namespace fs = boost::filesystem;
+
 namespace SMC {
 
+// seconds between the journal autosaves
+static const float level_editor_autosave_interval = 30.0f;
+
 /* *** *** *** *** *** *** *** cEditor_Level *** *** *** *** *** *** *** *** *** *** */
 
 cEditor_Level::cEditor_Level(cSprite_Manager* sprite_manager, cLevel* level)
@@ -44,6 +54,9 @@ cEditor_Level::cEditor_Level(cSprite_Manager* sprite_manager, cLevel* level)
 
     m_level = level;
     m_settings_screen = new cLevel_Settings(sprite_manager, m_level);
+    m_autosave_counter = 0.0f;
+
+    m_journal.Set_Loader(items_loader_callback, NULL, level_engine_version);
 }
 
 cEditor_Level::~cEditor_Level(void)
@@ -98,6 +111,8 @@ void cEditor_Level::Enable(void)
     }
 
     cEditor::Enable();
+
+    Recover_Journal();
 }
 
 void cEditor_Level::Disable(bool native_mode /* = 0 */)
@@ -109,6 +124,9 @@ void cEditor_Level::Disable(bool native_mode /* = 0 */)
 
     pHud_Debug->Set_Text(_("Level Editor disabled"));
 
+    m_journal.Commit();
+    Autosave();
+
     editor_level_enabled = 0;
 
     if (Game_Mode == MODE_LEVEL) {
@@ -119,6 +137,22 @@ void cEditor_Level::Disable(bool native_mode /* = 0 */)
     cEditor::Disable(native_mode);
 }
 
+void cEditor_Level::Update(void)
+{
+    if (!m_enabled) {
+        return;
+    }
+
+    cEditor::Update();
+
+    m_autosave_counter += pFramerate->m_speed_factor;
+
+    if (m_autosave_counter >= speedfactor_fps * level_editor_autosave_interval) {
+        m_autosave_counter = 0.0f;
+        Autosave();
+    }
+}
+
 bool cEditor_Level::Key_Down(SDLKey key)
 {
     if (!m_enabled) {
@@ -266,6 +300,84 @@ bool cEditor_Level::Switch_Object_State(cSprite* obj) const
     return 1;
 }
 
+void cEditor_Level::Autosave(void)
+{
+    // only finished steps
+    if (!m_journal.Get_Unwritten_Count() || !pActive_Level->Is_Loaded()) {
+        return;
+    }
+
+    // a level write in the background removes the journal when finished
+    if (pSave_Writer->Is_Busy()) {
+        return;
+    }
+
+    const fs::path level_filename = pActive_Level->m_level_filename;
+
+    // the level was never saved into the user level dir
+    if (!File_Exists(level_filename) || path_to_utf8(level_filename).find(path_to_utf8(pPackage_Manager->Get_User_Level_Path())) == std::string::npos) {
+        return;
+    }
+
+    if (m_journal.Append_File(cEditor_Journal::Get_Filename(level_filename))) {
+        m_journal_level_filename = level_filename;
+    }
+}
+
+void cEditor_Level::Recover_Journal(void)
+{
+    if (!pActive_Level->Is_Loaded()) {
+        return;
+    }
+
+    const fs::path level_filename = pActive_Level->m_level_filename;
+
+    // only asked once for each loaded level
+    if (level_filename == m_journal_checked_filename) {
+        return;
+    }
+
+    m_journal_checked_filename = level_filename;
+
+    // the journal of this session is already applied
+    if (level_filename == m_journal_level_filename || !cEditor_Journal::Has_File(level_filename)) {
+        return;
+    }
+
+    // left by a game which was not closed properly
+    if (!Box_Question(_("Recover the unsaved changes of level ") + pActive_Level->Get_Level_Name() + " ?")) {
+        boost::system::error_code ec;
+        fs::remove(cEditor_Journal::Get_Filename(level_filename), ec);
+        return;
+    }
+
+    m_journal.Commit();
+
+    if (m_journal.Replay_File(level_filename)) {
+        // discarded with the other changes if not saved
+        m_journal_level_filename = level_filename;
+        pHud_Debug->Set_Text(_("Recovered unsaved changes"));
+    }
+}
+
+void cEditor_Level::Discard_Journal(const fs::path& level_filename)
+{
+    // a following load checks the journal again
+    if (level_filename == m_journal_checked_filename) {
+        m_journal_checked_filename.clear();
+    }
+
+    if (level_filename.empty() || level_filename != m_journal_level_filename) {
+        return;
+    }
+
+    m_journal_level_filename.clear();
+    m_journal.Clear_Unwritten();
+
+    boost::system::error_code ec;
+    fs::remove(cEditor_Journal::Get_Filename(level_filename), ec);
+}
+
 bool cEditor_Level::Function_New(void)
 {
     std::string level_name = Box_Text_Input(_("Create a new Level"), C_("level", "Name"));
@@ -341,6 +453,11 @@ void cEditor_Level::Function_Save(bool with_dialog /* = 0 */)
         return;
     }
 
+    // the level includes all changes
+    m_journal.Commit();
+    m_journal.Clear_Unwritten();
+    m_journal_level_filename.clear();
+
     pActive_Level->Save();
 }
 
@@ -353,6 +470,12 @@ void cEditor_Level::Function_Save_as(void)
         return;
     }
 
+    m_journal.Commit();
+
+    // the changes are saved into the new level only
+    Discard_Journal(pActive_Level->m_level_filename);
+    m_journal.Clear_Unwritten();
+
     pActive_Level->Set_Filename(levelname, 0);
     pActive_Level->Save();
 }
@@ -37,6 +37,8 @@ namespace SMC {
          * native_mode : if unset the current game mode isn't altered
         */
         virtual void Disable(bool native_mode = 0);
+        // Update
+        virtual void Update(void);
 
 
         /* handle key down event
@@ -57,6 +59,17 @@ namespace SMC {
          * returns true if successful
         */
         bool Switch_Object_State(cSprite* obj) const;
+        // Append the journal changes to the journal file of the level
+        void Autosave(void);
+        /* Ask to apply the journal file of the active level
+         * Only done once for each loaded level as the journal file is only left
+         * behind if the game was not closed properly.
+        */
+        void Recover_Journal(void);
+        /* Remove the journal file of the level if it holds changes of this session
+         * Called when the level is unloaded without saving.
+        */
+        void Discard_Journal(const boost::filesystem::path& level_filename);
 
         // Menu functions
         virtual bool Function_New(void);
@@ -71,6 +84,12 @@ namespace SMC {
         cLevel* m_level;
         // Level Settings
         cLevel_Settings* m_settings_screen;
+        // time since the last autosave
+        float m_autosave_counter;
+        // level whose journal file holds the unsaved changes of this session
+        boost::filesystem::path m_journal_level_filename;
+        // level whose journal file was checked for changes to recover
+        boost::filesystem::path m_journal_checked_filename;
     protected:
         static std::vector<cSprite*> items_loader_callback(const std::string& name, XmlAttributes& attributes, int engine_version, cSprite_Manager* p_sprite_manager, void* p_data);
         virtual void Parse_Items_File(boost::filesystem::path filename);
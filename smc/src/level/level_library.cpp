@@ -0,0 +1,438 @@
+/***************************************************************************
+ * level_library.cpp  -  index of the level metadata
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../level/level_library.hpp"
+#include "../level/level.hpp"
+#include "../video/video.hpp"
+#include "../core/property_helper.hpp"
+#include "../core/xml_attributes.hpp"
+#include "../core/math/utilities.hpp"
+#include "../core/job_system.hpp"
+#include "../core/filesystem/filesystem.hpp"
+#include "../core/filesystem/binary_file.hpp"
+#include "../core/filesystem/resource_manager.hpp"
+#include "../core/filesystem/package_manager.hpp"
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace SMC {
+
+static const char* level_library_cache_magic = "SMCLVLIB";
+static const Uint32 level_library_cache_version = 2;
+
+static std::time_t Get_Level_File_Time(const fs::path& filename)
+{
+    return pPackage_Manager->Get_Resource_Write_Time(filename);
+}
+
+static std::string Get_Lower_Text(const std::string& str)
+{
+    std::string lower = str;
+
+    // only ASCII is changed which keeps UTF-8 intact
+    for (std::string::iterator itr = lower.begin(); itr != lower.end(); ++itr) {
+        if ((*itr) >= 'A' && (*itr) <= 'Z') {
+            (*itr) = (*itr) - 'A' + 'a';
+        }
+    }
+
+    return lower;
+}
+
+struct level_info_author_less {
+    bool operator()(const cLevel_Library::cLevel_Info* a, const cLevel_Library::cLevel_Info* b) const
+    {
+        return Get_Lower_Text(a->m_author) < Get_Lower_Text(b->m_author);
+    }
+};
+
+struct level_info_difficulty_less {
+    bool operator()(const cLevel_Library::cLevel_Info* a, const cLevel_Library::cLevel_Info* b) const
+    {
+        return a->m_difficulty < b->m_difficulty;
+    }
+};
+
+// most objects first
+struct level_info_objects_greater {
+    bool operator()(const cLevel_Library::cLevel_Info* a, const cLevel_Library::cLevel_Info* b) const
+    {
+        return a->m_object_count > b->m_object_count;
+    }
+};
+
+/* *** *** *** *** *** *** *** cLevel_Info_Loader *** *** *** *** *** *** *** *** *** *** */
+
+/* Reads only the settings of a level file and counts its objects
+ * Nothing is created so this is much faster than loading the level.
+*/
+class cLevel_Info_Loader : public xmlpp::SaxParser {
+public:
+    cLevel_Info_Loader(cLevel_Library::cLevel_Info& info)
+        : xmlpp::SaxParser(), m_info(info)
+    {
+        m_info.m_author.clear();
+        m_info.m_difficulty = 0;
+        m_info.m_land_type = LLT_UNDEFINED;
+        m_info.m_object_count = 0;
+    };
+
+protected:
+    virtual void on_start_element(const Glib::ustring& name, const xmlpp::SaxParser::AttributeList& properties)
+    {
+        if (name != "property" && name != "Property") {
+            return;
+        }
+
+        std::string key;
+        std::string value;
+
+        for (xmlpp::SaxParser::AttributeList::const_iterator itr = properties.begin(); itr != properties.end(); ++itr) {
+            if (itr->name == "name") {
+                key = itr->value;
+            }
+            else if (itr->name == "value") {
+                value = itr->value;
+            }
+        }
+
+        m_current_properties[key] = value;
+    };
+
+    virtual void on_end_element(const Glib::ustring& name)
+    {
+        if (name == "property" || name == "Property") {
+            return;
+        }
+
+        if (name == "settings") {
+            m_info.m_author = m_current_properties["lvl_author"];
+            m_info.m_difficulty = static_cast<Uint8>(Clamp(string_to_int(m_current_properties["lvl_difficulty"]), 0, 100));
+            m_info.m_land_type = Get_Level_Land_Type_Id(m_current_properties["lvl_land_type"]);
+        }
+        else if (cLevel::Is_Level_Sprite_Element(std::string(name))) {
+            m_info.m_object_count++;
+        }
+
+        m_current_properties.clear();
+    };
+
+private:
+    cLevel_Library::cLevel_Info& m_info;
+    XmlAttributes m_current_properties;
+};
+
+/* *** *** *** *** *** *** *** cLevel_Library::cParse_Job *** *** *** *** *** *** *** *** *** *** */
+
+class cLevel_Library::cParse_Job : public cJob {
+public:
+    // info : receives the metadata and must exist until the job is finished
+    cParse_Job(cLevel_Info* info)
+        : cJob("level info", JOB_PRIORITY_HIGH), m_info(info)
+    {}
+
+    virtual void Run(void)
+    {
+        if (!Parse_Level(m_info->m_path, *m_info)) {
+            // listed without metadata and not parsed again until changed
+            m_info->m_author.clear();
+            m_info->m_difficulty = 0;
+            m_info->m_land_type = LLT_UNDEFINED;
+            m_info->m_object_count = 0;
+        }
+    }
+
+private:
+    cLevel_Info* m_info;
+};
+
+/* *** *** *** *** *** *** *** cLevel_Library *** *** *** *** *** *** *** *** *** *** */
+
+cLevel_Library::cLevel_Library(void)
+{
+    m_cache_loaded = 0;
+    m_cache_changed = 0;
+}
+
+cLevel_Library::~cLevel_Library(void)
+{
+    m_cache.clear();
+    m_levels.clear();
+}
+
+void cLevel_Library::Update(void)
+{
+    const fs::path cache_filename = pResource_Manager->Get_User_Cache_Directory() / utf8_to_path("level_library.cache");
+
+    if (!m_cache_loaded) {
+        m_cache_loaded = 1;
+
+        if (!Load_Cache(cache_filename)) {
+            m_cache.clear();
+            m_cache_changed = 1;
+        }
+    }
+
+    m_levels.clear();
+
+    const fs::path game_dir = pPackage_Manager->Get_Game_Level_Path();
+    const fs::path user_dir = pPackage_Manager->Get_User_Level_Path();
+
+    std::set<std::string> found;
+    // the user level data replaces the game level data
+    Scan_Directory(game_dir, 0, found);
+    Scan_Directory(user_dir, 1, found);
+
+    // remove deleted levels of the scanned directories
+    Level_Map::iterator itr = m_cache.begin();
+
+    while (itr != m_cache.end()) {
+        const fs::path dir = itr->second.m_path.parent_path();
+
+        if ((dir == game_dir || dir == user_dir) && found.find(itr->first) == found.end()) {
+            m_cache.erase(itr++);
+            m_cache_changed = 1;
+        }
+        else {
+            ++itr;
+        }
+    }
+
+    if (m_cache_changed) {
+        if (Save_Cache(cache_filename)) {
+            m_cache_changed = 0;
+        }
+    }
+}
+
+void cLevel_Library::Query(const std::string& filter, Level_Library_Sort sort, vector<const cLevel_Info*>& result) const
+{
+    result.clear();
+    result.reserve(m_levels.size());
+
+    const std::string lower_filter = Get_Lower_Text(filter);
+
+    // already sorted by name
+    for (Level_Map::const_iterator itr = m_levels.begin(); itr != m_levels.end(); ++itr) {
+        const cLevel_Info& info = itr->second;
+
+        if (!lower_filter.empty() && Get_Lower_Text(info.m_name).find(lower_filter) == std::string::npos && Get_Lower_Text(info.m_author).find(lower_filter) == std::string::npos) {
+            continue;
+        }
+
+        result.push_back(&info);
+    }
+
+    // stable to keep the name order for equal values
+    if (sort == LEVEL_LIBRARY_SORT_AUTHOR) {
+        std::stable_sort(result.begin(), result.end(), level_info_author_less());
+    }
+    else if (sort == LEVEL_LIBRARY_SORT_DIFFICULTY) {
+        std::stable_sort(result.begin(), result.end(), level_info_difficulty_less());
+    }
+    else if (sort == LEVEL_LIBRARY_SORT_OBJECTS) {
+        std::stable_sort(result.begin(), result.end(), level_info_objects_greater());
+    }
+}
+
+const cLevel_Library::cLevel_Info* cLevel_Library::Get_Level(const std::string& name) const
+{
+    Level_Map::const_iterator itr = m_levels.find(name);
+
+    if (itr == m_levels.end()) {
+        return NULL;
+    }
+
+    return &itr->second;
+}
+
+fs::path cLevel_Library::Get_Thumbnail_Filename(const std::string& name)
+{
+    return pResource_Manager->Get_User_Cache_Directory() / utf8_to_path("level_thumbnails") / utf8_to_path(name + ".png");
+}
+
+void cLevel_Library::Save_Thumbnail(const std::string& name)
+{
+    const fs::path filename = Get_Thumbnail_Filename(name);
+
+    if (!Dir_Exists(filename.parent_path())) {
+        boost::system::error_code ec;
+        fs::create_directories(filename.parent_path(), ec);
+
+        if (ec) {
+            cerr << "Warning : Could not create level thumbnail directory " << path_to_utf8(filename.parent_path()) << endl;
+            return;
+        }
+    }
+
+    pVideo->Save_Screenshot(filename, m_thumbnail_width, m_thumbnail_height);
+}
+
+void cLevel_Library::Scan_Directory(const fs::path& dir, bool user, std::set<std::string>& found)
+{
+    if (!pPackage_Manager->Resource_Dir_Exists(dir)) {
+        return;
+    }
+
+    vector<fs::path> lvl_files = pPackage_Manager->Get_Resource_Files(dir, ".smclvl");
+
+    // new or changed levels parsed in parallel
+    vector<cLevel_Info> parsed;
+    // the jobs keep pointers into it
+    parsed.reserve(lvl_files.size());
+    vector<Job_ID> jobs;
+
+    for (vector<fs::path>::const_iterator itr = lvl_files.begin(); itr != lvl_files.end(); ++itr) {
+        const fs::path& filename = (*itr);
+        const std::string key = path_to_utf8(filename);
+        const std::time_t file_time = Get_Level_File_Time(filename);
+
+        found.insert(key);
+
+        Level_Map::const_iterator cached = m_cache.find(key);
+
+        if (cached != m_cache.end() && cached->second.m_time == file_time) {
+            continue;
+        }
+
+        cLevel_Info info;
+        info.m_name = path_to_utf8(filename.stem());
+        info.m_path = filename;
+        info.m_time = file_time;
+        info.m_game = 0;
+        info.m_user = 0;
+
+        parsed.push_back(info);
+        jobs.push_back(pJob_System->Add(new cParse_Job(&parsed.back())));
+    }
+
+    pJob_System->Wait(jobs);
+
+    for (vector<cLevel_Info>::const_iterator itr = parsed.begin(); itr != parsed.end(); ++itr) {
+        m_cache[path_to_utf8(itr->m_path)] = (*itr);
+        m_cache_changed = 1;
+    }
+
+    for (vector<fs::path>::const_iterator itr = lvl_files.begin(); itr != lvl_files.end(); ++itr) {
+        const cLevel_Info& info = m_cache.find(path_to_utf8(*itr))->second;
+        Level_Map::iterator level = m_levels.find(info.m_name);
+
+        if (level == m_levels.end()) {
+            level = m_levels.insert(Level_Map::value_type(info.m_name, info)).first;
+            level->second.m_game = !user;
+            level->second.m_user = user;
+        }
+        // in both directories
+        else if (user) {
+            level->second = info;
+            level->second.m_game = 1;
+            level->second.m_user = 1;
+        }
+    }
+}
+
+bool cLevel_Library::Parse_Level(const fs::path& filename, cLevel_Info& info)
+{
+    try {
+        cLevel_Info_Loader loader(info);
+        std::string data;
+
+        // from a package archive
+        if (pPackage_Manager->Read_Archive_File(filename, data)) {
+            loader.parse_memory_raw(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+        }
+        else {
+            loader.parse_file(path_to_utf8(filename));
+        }
+    }
+    catch (xmlpp::exception& e) {
+        cerr << "Warning : Could not read level info of " << path_to_utf8(filename) << " : " << e.what() << endl;
+        return 0;
+    }
+
+    return 1;
+}
+
+bool cLevel_Library::Load_Cache(const fs::path& filename)
+{
+    if (!File_Exists(filename)) {
+        return 0;
+    }
+
+    cBinary_Reader reader(filename, level_library_cache_magic, level_library_cache_version);
+
+    // created by another game version
+    if (reader.Read_Uint32() != smc_version) {
+        return 0;
+    }
+
+    Uint32 count = reader.Read_Uint32();
+
+    for (Uint32 i = 0; i < count && reader.Is_Good(); i++) {
+        cLevel_Info info;
+        info.m_path = utf8_to_path(reader.Read_String());
+        info.m_name = path_to_utf8(info.m_path.stem());
+        info.m_time = static_cast<std::time_t>(reader.Read_Uint64());
+        info.m_author = reader.Read_String();
+        info.m_difficulty = reader.Read_Uint8();
+        info.m_land_type = static_cast<LevelLandType>(reader.Read_Int32());
+        info.m_object_count = reader.Read_Uint32();
+        info.m_game = 0;
+        info.m_user = 0;
+
+        m_cache[path_to_utf8(info.m_path)] = info;
+    }
+
+    if (!reader.Is_Good()) {
+        cerr << "Warning : Level library cache " << path_to_utf8(filename) << " is invalid" << endl;
+        return 0;
+    }
+
+    return 1;
+}
+
+bool cLevel_Library::Save_Cache(const fs::path& filename) const
+{
+    cBinary_Writer writer(filename, level_library_cache_magic, level_library_cache_version);
+
+    writer.Write_Uint32(smc_version);
+    writer.Write_Uint32(m_cache.size());
+
+    for (Level_Map::const_iterator itr = m_cache.begin(); itr != m_cache.end(); ++itr) {
+        const cLevel_Info& info = itr->second;
+
+        writer.Write_String(itr->first);
+        writer.Write_Uint64(static_cast<Uint64>(info.m_time));
+        writer.Write_String(info.m_author);
+        writer.Write_Uint8(info.m_difficulty);
+        writer.Write_Int32(info.m_land_type);
+        writer.Write_Uint32(info.m_object_count);
+    }
+
+    if (!writer.Finish()) {
+        cerr << "Warning : Could not write level library cache " << path_to_utf8(filename) << endl;
+        return 0;
+    }
+
+    return 1;
+}
+
+cLevel_Library* pLevel_Library = NULL;
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
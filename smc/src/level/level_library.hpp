@@ -0,0 +1,121 @@
+/***************************************************************************
+ * level_library.h
+ *
+ * Copyright © 2003 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_LEVEL_LIBRARY_HPP
+#define SMC_LEVEL_LIBRARY_HPP
+
+#include "../core/global_basic.hpp"
+#include "../core/global_game.hpp"
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** Level library sort types *** *** *** *** *** *** *** *** *** *** */
+
+    enum Level_Library_Sort {
+        LEVEL_LIBRARY_SORT_NAME = 0,
+        LEVEL_LIBRARY_SORT_AUTHOR = 1,
+        LEVEL_LIBRARY_SORT_DIFFICULTY = 2,
+        LEVEL_LIBRARY_SORT_OBJECTS = 3
+    };
+
+    /* *** *** *** *** *** *** *** cLevel_Library *** *** *** *** *** *** *** *** *** *** */
+
+    /* Index of the game and user levels with their metadata
+     * The metadata is cached on disk keyed by the level path and only parsed again
+     * if the modification time of the level file changed. A level in the game and
+     * user directory is listed once with the user level data.
+    */
+    class cLevel_Library {
+    public:
+        cLevel_Library(void);
+        ~cLevel_Library(void);
+
+        struct cLevel_Info {
+            // level name without extension
+            std::string m_name;
+            // level filename
+            boost::filesystem::path m_path;
+            // modification time of the level file
+            std::time_t m_time;
+            std::string m_author;
+            // 0 if undefined
+            Uint8 m_difficulty;
+            LevelLandType m_land_type;
+            // level objects
+            Uint32 m_object_count;
+            // available in the game and/or user directory
+            bool m_game;
+            bool m_user;
+        };
+
+        /* Scan the game and user level directories of the current package
+         * Changed levels are parsed again by jobs and the disk cache is updated.
+        */
+        void Update(void);
+
+        /* Get the levels containing the filter in the name or author
+         * The filter is case insensitive.
+        */
+        void Query(const std::string& filter, Level_Library_Sort sort, vector<const cLevel_Info*>& result) const;
+        // Get a level by name or NULL if not found
+        const cLevel_Info* Get_Level(const std::string& name) const;
+
+        // Return the thumbnail filename of the level
+        static boost::filesystem::path Get_Thumbnail_Filename(const std::string& name);
+        // Save a downscaled image of the screen as thumbnail of the level
+        static void Save_Thumbnail(const std::string& name);
+
+        // thumbnail size
+        static const unsigned int m_thumbnail_width = 160;
+        static const unsigned int m_thumbnail_height = 120;
+
+    private:
+        typedef std::map<std::string, cLevel_Info> Level_Map;
+
+        // Parses the metadata of a level file in a worker thread
+        class cParse_Job;
+
+        /* Add the levels of the directory to the current levels
+         * found : receives the paths of the found level files
+        */
+        void Scan_Directory(const boost::filesystem::path& dir, bool user, std::set<std::string>& found);
+        // Parse the level file metadata. Returns false on failure.
+        static bool Parse_Level(const boost::filesystem::path& filename, cLevel_Info& info);
+
+        // Load the disk cache. Returns false if not available.
+        bool Load_Cache(const boost::filesystem::path& filename);
+        // Save the disk cache. Returns false on failure.
+        bool Save_Cache(const boost::filesystem::path& filename) const;
+
+        // parsed levels of all scanned directories keyed by the level path
+        Level_Map m_cache;
+        // levels of the current package keyed by the level name
+        Level_Map m_levels;
+        // disk cache was loaded
+        bool m_cache_loaded;
+        // cache needs to be written
+        bool m_cache_changed;
+    };
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+    // Level Library
+    extern cLevel_Library* pLevel_Library;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
@@ -3,6 +3,7 @@
 #include "../core/sprite_manager.hpp"
 #include "../core/property_helper.hpp"
 #include "../core/filesystem/resource_manager.hpp"
+#include "../core/filesystem/package_manager.hpp"
 #include "../video/font.hpp"
 #include "../objects/enemystopper.hpp"
 #include "../objects/level_exit.hpp"
@@ -68,7 +69,13 @@ cLevel* cLevelLoader::Get_Level()
 void cLevelLoader::parse_file(boost::filesystem::path filename)
 {
     m_levelfile = filename;
-    xmlpp::SaxParser::parse_file(path_to_utf8(filename));
+
+    // from a package archive
+    std::string data;
+    if (pPackage_Manager->Read_Archive_File(filename, data))
+        xmlpp::SaxParser::parse_memory_raw(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    else
+        xmlpp::SaxParser::parse_file(path_to_utf8(filename));
 }
 
 void cLevelLoader::on_start_document()
@@ -168,7 +168,7 @@ fs::path cLevel_Manager::Get_Path(const std::string& levelname, bool check_only_
     // use new file type as default
     user_filename.replace_extension(".smclvl");
 
-    if (File_Exists(user_filename)) {
+    if (pPackage_Manager->Resource_Exists(user_filename)) {
         // found
         return user_filename;
     }
@@ -176,7 +176,7 @@ fs::path cLevel_Manager::Get_Path(const std::string& levelname, bool check_only_
     // use old file type
     user_filename.replace_extension(".txt");
 
-    if (File_Exists(user_filename)) {
+    if (pPackage_Manager->Resource_Exists(user_filename)) {
         // found
         return user_filename;
     }
@@ -187,7 +187,7 @@ fs::path cLevel_Manager::Get_Path(const std::string& levelname, bool check_only_
         // use new file type
         game_filename.replace_extension(".smclvl");
 
-        if (File_Exists(game_filename)) {
+        if (pPackage_Manager->Resource_Exists(game_filename)) {
             // found
             return game_filename;
         }
@@ -195,7 +195,7 @@ fs::path cLevel_Manager::Get_Path(const std::string& levelname, bool check_only_
         // use old file type
         game_filename.replace_extension(".txt");
 
-        if (File_Exists(game_filename)) {
+        if (pPackage_Manager->Resource_Exists(game_filename)) {
             // found
             return game_filename;
         }
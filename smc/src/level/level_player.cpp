@@ -240,11 +240,11 @@ void cLevel_Player::DownGrade_Player(bool delayed /* = true */, bool force /* =
 
     // lost a live
     if (m_lives >= 0) {
-        pAudio->Play_Sound(utf8_to_path("player/dead.ogg"), RID_MARYO_DEATH);
+        pAudio->Play_Sound(utf8_to_path("player/dead.ogg"), RID_MARYO_DEATH, -1, 0, SOUND_PRIORITY_CRITICAL);
     }
     // game over
     else {
-        pAudio->Play_Sound(pPackage_Manager->Get_Music_Reading_Path("game/lost_1.ogg"), RID_MARYO_DEATH);
+        pAudio->Play_Sound(pPackage_Manager->Get_Music_Reading_Path("game/lost_1.ogg"), RID_MARYO_DEATH, -1, 0, SOUND_PRIORITY_CRITICAL);
     }
 
     // dying animation
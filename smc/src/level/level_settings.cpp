@@ -506,16 +506,6 @@ void cLevel_Settings::Load_BG_Image_List(void)
         item->setSelectionBrushImage("TaharezLook", "ListboxSelectionBrush");
         listbox->addItem(static_cast<CEGUI::ListboxItem*>(item));
     }
-
-    CEGUI::PushButton* button_add = static_cast<CEGUI::PushButton*>(CEGUI::WindowManager::getSingleton().getWindow("button_add_background_image"));
-
-    // 9 layers + default background is the maximum
-    if (m_level->m_background_manager->size() >= 10) {
-        button_add->disable();
-    }
-    else {
-        button_add->enable();
-    }
 }
 
 bool cLevel_Settings::Update_BG_Image(const CEGUI::EventArgs& event)
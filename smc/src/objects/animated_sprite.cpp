@@ -35,6 +35,73 @@ cAnimation_Surface::~cAnimation_Surface(void)
     //
 }
 
+/* *** *** *** *** *** *** *** cAnimation_Definition *** *** *** *** *** *** *** *** *** *** */
+
+cAnimation_Definition::cAnimation_Definition(void)
+{
+    //
+}
+
+cAnimation_Definition::~cAnimation_Definition(void)
+{
+    //
+}
+
+void cAnimation_Definition::Add_Image(cGL_Surface* image, Uint32 time /* = 0 */)
+{
+    cAnimation_Surface obj;
+    obj.m_image = image;
+    obj.m_time = time;
+
+    m_images.push_back(obj);
+}
+
+/* *** *** *** *** *** *** *** cAnimation_Definition_Manager *** *** *** *** *** *** *** *** *** *** */
+
+cAnimation_Definition_Manager::cAnimation_Definition_Manager(void)
+{
+    //
+}
+
+cAnimation_Definition_Manager::~cAnimation_Definition_Manager(void)
+{
+    Delete_All();
+}
+
+const cAnimation_Definition* cAnimation_Definition_Manager::Get(const std::string& key) const
+{
+    Definition_Map::const_iterator itr = m_definitions.find(key);
+
+    if (itr == m_definitions.end()) {
+        return NULL;
+    }
+
+    return itr->second;
+}
+
+cAnimation_Definition* cAnimation_Definition_Manager::Create(const std::string& key)
+{
+    cAnimation_Definition*& animation = m_definitions[key];
+
+    // replace
+    if (animation) {
+        delete animation;
+    }
+
+    animation = new cAnimation_Definition();
+
+    return animation;
+}
+
+void cAnimation_Definition_Manager::Delete_All(void)
+{
+    for (Definition_Map::iterator itr = m_definitions.begin(); itr != m_definitions.end(); ++itr) {
+        delete itr->second;
+    }
+
+    m_definitions.clear();
+}
+
 /* *** *** *** *** *** *** *** cAnimated_Sprite *** *** *** *** *** *** *** *** *** *** */
 
 cAnimated_Sprite::cAnimated_Sprite(cSprite_Manager* sprite_manager, std::string type_name /* = "sprite" */)
@@ -48,6 +115,9 @@ cAnimated_Sprite::cAnimated_Sprite(cSprite_Manager* sprite_manager, std::string
     m_anim_time_default = 1000;
     m_anim_counter = 0;
     m_anim_mod = 1.0f;
+
+    m_animation = NULL;
+    m_anim_time_all = 0;
 }
 
 cAnimated_Sprite::~cAnimated_Sprite(void)
@@ -57,6 +127,25 @@ cAnimated_Sprite::~cAnimated_Sprite(void)
 
 void cAnimated_Sprite::Add_Image(cGL_Surface* image, Uint32 time /* = 0 */)
 {
+    // the shared images can not be changed
+    if (m_animation) {
+        m_images = m_animation->m_images;
+        m_animation = NULL;
+
+        for (cAnimation_Surface_List::iterator itr = m_images.begin(); itr != m_images.end(); ++itr) {
+            cAnimation_Surface& obj = (*itr);
+
+            if (m_anim_time_all) {
+                obj.m_time = m_anim_time_all;
+            }
+            else if (obj.m_time == 0) {
+                obj.m_time = m_anim_time_default;
+            }
+        }
+
+        m_anim_time_all = 0;
+    }
+
     // set to default time
     if (time == 0) {
         time = m_anim_time_default;
@@ -69,6 +158,13 @@ void cAnimated_Sprite::Add_Image(cGL_Surface* image, Uint32 time /* = 0 */)
     m_images.push_back(obj);
 }
 
+void cAnimated_Sprite::Set_Animation_Definition(const cAnimation_Definition* animation)
+{
+    Clear_Images();
+
+    m_animation = animation;
+}
+
 void cAnimated_Sprite::Set_Image_Num(const int num, const bool new_startimage /* = 0 */, const bool del_img /* = 0 */)
 {
     if (m_curr_img == num) {
@@ -80,27 +176,31 @@ void cAnimated_Sprite::Set_Image_Num(const int num, const bool new_startimage /*
     if (m_curr_img < 0) {
         cMovingSprite::Set_Image(NULL, new_startimage, del_img);
     }
-    else if (m_curr_img < static_cast<int>(m_images.size())) {
-        cMovingSprite::Set_Image(m_images[m_curr_img].m_image, new_startimage, del_img);
+    else if (m_curr_img < static_cast<int>(Get_Images().size())) {
+        cMovingSprite::Set_Image(Get_Images()[m_curr_img].m_image, new_startimage, del_img);
     }
     else {
-        debug_print("Warning : Object image number %d bigger as the array size %u, sprite type %d, name %s\n", m_curr_img, static_cast<unsigned int>(m_images.size()), m_type, m_name.c_str());
+        debug_print("Warning : Object image number %d bigger as the array size %u, sprite type %d, name %s\n", m_curr_img, static_cast<unsigned int>(Get_Images().size()), m_type, m_name.c_str());
     }
 }
 
 cGL_Surface* cAnimated_Sprite::Get_Image(const unsigned int num) const
 {
-    if (num >= m_images.size()) {
+    const cAnimation_Surface_List& images = Get_Images();
+
+    if (num >= images.size()) {
         return NULL;
     }
 
-    return m_images[num].m_image;
+    return images[num].m_image;
 }
 
 void cAnimated_Sprite::Clear_Images(void)
 {
     m_curr_img = -1;
     m_images.clear();
+    m_animation = NULL;
+    m_anim_time_all = 0;
 }
 
 void cAnimated_Sprite::Update_Animation(void)
@@ -112,16 +212,23 @@ void cAnimated_Sprite::Update_Animation(void)
 
     m_anim_counter += pFramerate->m_elapsed_ticks;
 
+    const cAnimation_Surface_List& images = Get_Images();
+
     // out of range
-    if (m_curr_img < 0 || m_curr_img >= static_cast<int>(m_images.size())) {
-        cerr << "Warning: Animation image " << m_curr_img << " for " << m_name << " out of range (max " << (m_images.size() - 1) << "). Forcing start image." << endl;
+    if (m_curr_img < 0 || m_curr_img >= static_cast<int>(images.size())) {
+        cerr << "Warning: Animation image " << m_curr_img << " for " << m_name << " out of range (max " << (images.size() - 1) << "). Forcing start image." << endl;
         Set_Image_Num(m_anim_img_start);
         return;
     }
 
-    cAnimation_Surface image = m_images[m_curr_img];
+    // shared images may use the time set for all images or the default time
+    Uint32 image_time = m_anim_time_all ? m_anim_time_all : images[m_curr_img].m_time;
+
+    if (image_time == 0) {
+        image_time = m_anim_time_default;
+    }
 
-    if (static_cast<Uint32>(m_anim_counter * m_anim_mod) >= image.m_time) {
+    if (static_cast<Uint32>(m_anim_counter * m_anim_mod) >= image_time) {
         if (m_curr_img >= m_anim_img_end) {
             Set_Image_Num(m_anim_img_start);
         }
@@ -129,12 +236,16 @@ void cAnimated_Sprite::Update_Animation(void)
             Set_Image_Num(m_curr_img + 1);
         }
 
-        m_anim_counter = static_cast<Uint32>(m_anim_counter * m_anim_mod) - image.m_time;
+        m_anim_counter = static_cast<Uint32>(m_anim_counter * m_anim_mod) - image_time;
     }
 }
 
 void cAnimated_Sprite::Set_Time_All(const Uint32 time, const bool default_time /* = 0 */)
 {
+    if (m_animation) {
+        m_anim_time_all = time;
+    }
+
     for (cAnimation_Surface_List::iterator itr = m_images.begin(); itr != m_images.end(); ++itr) {
         cAnimation_Surface& obj = (*itr);
         obj.m_time = time;
@@ -145,6 +256,8 @@ void cAnimated_Sprite::Set_Time_All(const Uint32 time, const bool default_time /
     }
 }
 
+cAnimation_Definition_Manager* pAnimation_Definition_Manager = NULL;
+
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 } // namespace SMC
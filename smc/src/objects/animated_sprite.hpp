@@ -34,6 +34,53 @@ namespace SMC {
         Uint32 m_time;
     };
 
+    typedef vector<cAnimation_Surface> cAnimation_Surface_List;
+
+    /* *** *** *** *** *** *** *** cAnimation_Definition *** *** *** *** *** *** *** *** *** *** */
+
+    /* Animation images shared by all sprites of a type and variant
+     * Created once by the first sprite and never changed afterwards.
+    */
+    class cAnimation_Definition {
+    public:
+        cAnimation_Definition(void);
+        ~cAnimation_Definition(void);
+
+        /* Add an image to the animation
+         * NULL image is allowed
+         * time: if not set the sprite uses its default display time
+        */
+        void Add_Image(cGL_Surface* image, Uint32 time = 0);
+
+        // images with their display time
+        cAnimation_Surface_List m_images;
+    };
+
+    /* *** *** *** *** *** *** *** cAnimation_Definition_Manager *** *** *** *** *** *** *** *** *** *** */
+
+    /* Shared animation definitions by type and variant
+     * The images are owned by the image manager so a definition stays valid until
+     * the game exits.
+    */
+    class cAnimation_Definition_Manager {
+    public:
+        cAnimation_Definition_Manager(void);
+        ~cAnimation_Definition_Manager(void);
+
+        /* Return the definition with the given key or NULL if not created
+         * key : type and variant like "furball/brown"
+        */
+        const cAnimation_Definition* Get(const std::string& key) const;
+        // Create an empty definition with the given key to add the images to
+        cAnimation_Definition* Create(const std::string& key);
+        // Delete all definitions
+        void Delete_All(void);
+
+    private:
+        typedef std::map<std::string, cAnimation_Definition*> Definition_Map;
+        Definition_Map m_definitions;
+    };
+
     /* *** *** *** *** *** *** *** cAnimated_Sprite *** *** *** *** *** *** *** *** *** *** */
 
     class cAnimated_Sprite : public cMovingSprite {
@@ -46,6 +93,10 @@ namespace SMC {
          * time: if not set uses the default display time
         */
         void Add_Image(cGL_Surface* image, Uint32 time = 0);
+        /* Use the shared images of the definition
+         * The own images are cleared. Adding an image copies the shared images first.
+        */
+        void Set_Animation_Definition(const cAnimation_Definition* animation);
         // Set the animation start and end image
         inline void Set_Animation_Image_Range(const int start, const int end)
         {
@@ -61,6 +112,15 @@ namespace SMC {
         cGL_Surface* Get_Image(const unsigned int num) const;
         // Clear the image list
         void Clear_Images(void);
+        // Return the shared or own images
+        inline const cAnimation_Surface_List& Get_Images(void) const
+        {
+            if (m_animation) {
+                return m_animation->m_images;
+            }
+
+            return m_images;
+        };
 
         /* Set if the animation is enabled
          * default : disabled
@@ -85,6 +145,7 @@ namespace SMC {
         };
         /* Set display time for all images
          * default_time: if set also make it the default time
+         * Shared images keep their time and the given time is used instead.
         */
         void Set_Time_All(const Uint32 time, const bool default_time = 0);
         /* Set the animation speed modifier
@@ -120,13 +181,21 @@ namespace SMC {
         // animation speed modifier
         float m_anim_mod;
 
-        // Surface list
-        typedef vector<cAnimation_Surface> cAnimation_Surface_List;
+        // own surface list if no shared definition is used
         cAnimation_Surface_List m_images;
+        // shared definition or NULL
+        const cAnimation_Definition* m_animation;
+        // display time of all shared images or 0 to use their own time
+        Uint32 m_anim_time_all;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
+    // Shared animation definitions
+    extern cAnimation_Definition_Manager* pAnimation_Definition_Manager;
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
 } // namespace SMC
 
 #endif
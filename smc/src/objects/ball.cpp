@@ -195,7 +195,7 @@ void cBall::Destroy_Ball(bool with_sound /* = 0 */)
 {
     if (with_sound) {
         if (m_ball_type == FIREBALL_DEFAULT) {
-            pAudio->Play_Sound("item/fireball_explode.wav");
+            pAudio->Play_Sound_At("item/fireball_explode.wav", m_pos_x, m_pos_y);
         }
     }
 
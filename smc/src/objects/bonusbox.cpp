@@ -61,6 +61,7 @@ void cBonusBox::Init(void)
     m_name = "Bonus Box";
     m_force_best_item = 0;
     m_camera_range = 5000;
+    Set_Update_Policy(UPDATE_POLICY_IN_RANGE);
     m_can_be_on_ground = 0;
 
     Set_Animation_Type("Bonus");
@@ -107,6 +108,32 @@ xmlpp::Element* cBonusBox::Save_To_XML_Node(xmlpp::Element* p_element)
     return p_node;
 }
 
+void cBonusBox::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    cBaseBox::Get_Sound_Files(sound_files);
+
+    if (box_type == TYPE_UNDEFINED) {
+        sound_files.push_back("item/empty_box.wav");
+    }
+    else if (box_type == TYPE_GOLDPIECE) {
+        sound_files.push_back("item/goldpiece_1.ogg");
+
+        if (m_gold_color == COL_RED) {
+            sound_files.push_back("item/goldpiece_red.wav");
+        }
+    }
+    else {
+        sound_files.push_back("sprout_1.ogg");
+
+        // may be replaced with a mushroom
+        if (box_type == TYPE_FIREPLANT || box_type == TYPE_MUSHROOM_BLUE) {
+            cPowerUp::Get_Item_Sound_Files(TYPE_MUSHROOM_DEFAULT, sound_files);
+        }
+
+        cPowerUp::Get_Item_Sound_Files(box_type, sound_files);
+    }
+}
+
 void cBonusBox::Set_Useable_Count(int count, bool new_startcount /* = 0 */)
 {
     cBaseBox::Set_Useable_Count(count, new_startcount);
@@ -110,6 +110,9 @@ namespace SMC {
         // Save to node
         virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
 
+        // Add the sound files this box and its item can play
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+
     protected:
         // typename inherited
     };
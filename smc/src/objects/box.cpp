@@ -834,6 +834,11 @@ std::string cBaseBox::Create_Name(void) const
     return name;
 }
 
+void cBaseBox::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    sound_files.push_back("wall_hit.wav");
+}
+
 void cBaseBox::Set_Massive_Type(MassiveType type)
 {
     // Ignore to prevent "m" toggling in level editor
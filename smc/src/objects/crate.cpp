@@ -144,6 +144,11 @@ std::string cCrate::Get_XML_Type_Name()
     return "crate";
 }
 
+void cCrate::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    sound_files.push_back("wood_1.ogg");
+}
+
 xmlpp::Element* cCrate::Save_To_XML_Node(xmlpp::Element* p_element)
 {
     xmlpp::Element* p_node = cAnimated_Sprite::Save_To_XML_Node(p_element);
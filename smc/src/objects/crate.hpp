@@ -53,6 +53,9 @@ namespace SMC {
 
         virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
 
+        // Add the sound files this crate can play
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+
         virtual void Handle_Collision_Player(cObjectCollision* p_collision);
         virtual void Handle_Collision_Enemy(cObjectCollision* p_collision);
         virtual void Handle_out_of_Level(ObjectDirection dir);
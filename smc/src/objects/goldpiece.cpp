@@ -57,6 +57,7 @@ void cGoldpiece::Init(void)
     m_sprite_array = ARRAY_ACTIVE;
     m_massive_type = MASS_PASSIVE;
     m_type = TYPE_GOLDPIECE;
+    Set_Update_Policy(UPDATE_POLICY_IN_RANGE);
     m_pos_z = 0.041f;
     m_can_be_on_ground = 0;
 
@@ -76,6 +77,16 @@ std::string cGoldpiece::Get_XML_Type_Name()
     return "goldpiece";
 }
 
+void cGoldpiece::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    if (m_color_type == COL_RED) {
+        sound_files.push_back("item/goldpiece_red.wav");
+    }
+    else {
+        sound_files.push_back("item/goldpiece_1.ogg");
+    }
+}
+
 xmlpp::Element* cGoldpiece::Save_To_XML_Node(xmlpp::Element* p_element)
 {
     xmlpp::Element* p_node = cAnimated_Sprite::Save_To_XML_Node(p_element);
@@ -318,6 +329,8 @@ cJGoldpiece::cJGoldpiece(cSprite_Manager* sprite_manager)
     : cGoldpiece(sprite_manager)
 {
     m_type = TYPE_JUMPING_GOLDPIECE;
+    // the jump animation also runs out of range
+    Set_Update_Policy(UPDATE_POLICY_ALWAYS);
     Set_Spawned(1);
 
     cJGoldpiece::Set_Gold_Color(COL_YELLOW);
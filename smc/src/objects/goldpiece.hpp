@@ -78,6 +78,9 @@ namespace SMC {
         // Save to node
         virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
 
+        // Add the sound files played when collected
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+
     protected:
         // save to stream
         virtual std::string Get_XML_Type_Name();
@@ -153,6 +153,13 @@ std::string cLevel_Entry::Create_Name(void) const
     return name;
 }
 
+void cLevel_Entry::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    if (m_entry_type == LEVEL_ENTRY_WARP) {
+        sound_files.push_back("leave_pipe.ogg");
+    }
+}
+
 void cLevel_Entry::Draw(cSurface_Request* request /* = NULL */)
 {
     if (!m_valid_draw) {
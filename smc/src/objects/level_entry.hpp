@@ -99,6 +99,9 @@ namespace SMC {
         virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
         virtual std::string  Create_Name(void) const;
 
+        // Add the sound files this entry can play
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+
     protected:
         virtual std::string Get_XML_Type_Name();
     };
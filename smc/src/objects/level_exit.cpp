@@ -217,6 +217,13 @@ std::string cLevel_Exit::Create_Name(void) const
     return name;
 }
 
+void cLevel_Exit::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    if (m_exit_type == LEVEL_EXIT_WARP) {
+        sound_files.push_back("enter_pipe.ogg");
+    }
+}
+
 void cLevel_Exit::Draw(cSurface_Request* request /* = NULL */)
 {
     if (!m_valid_draw) {
@@ -137,6 +137,9 @@ namespace SMC {
         virtual xmlpp::Element* Save_To_XML_Node(xmlpp::Element* p_element);
         virtual std::string Create_Name(void) const;
 
+        // Add the sound files this exit can play
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+
     protected:
         // save to stream
         virtual std::string Get_XML_Type_Name();
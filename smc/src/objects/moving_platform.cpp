@@ -110,6 +110,7 @@ void cMoving_Platform::Init(void)
     m_can_be_on_ground = 0;
 
     m_camera_range = 3000;
+    Set_Update_Policy(UPDATE_POLICY_IN_RANGE);
     m_can_be_ground = 1;
 
     m_move_type = MOVING_PLATFORM_TYPE_LINE;
@@ -821,6 +822,7 @@ void cMoving_Platform::Update_Rect(void)
     // set width
     m_col_rect.m_w = m_rect.m_w;
     m_start_rect.m_w = m_rect.m_w;
+    Col_Rect_Changed();
 }
 
 void cMoving_Platform::Update_Velocity(void)
@@ -51,7 +51,7 @@ cMovingSprite::cMovingSprite(XmlAttributes& attributes, cSprite_Manager* sprite_
 
 cMovingSprite::~cMovingSprite(void)
 {
-    //
+    Set_Ground_Object(NULL);
 }
 
 void cMovingSprite::Init(void)
@@ -70,6 +70,8 @@ void cMovingSprite::Init(void)
 
     m_ice_resistance = 0.0f;
     m_freeze_counter = 0.0f;
+
+    Set_Update_Policy(UPDATE_POLICY_ALWAYS);
 }
 
 cMovingSprite* cMovingSprite::Copy(void) const
@@ -663,6 +665,9 @@ cObjectCollisionType* cMovingSprite::Collision_Check(const GL_rect& new_rect, co
         }
     }
 
+    // validated objects
+    Uint32 checks = 0;
+
     // Check objects
     for (cSprite_List::iterator itr = objects->begin(); itr != objects->end(); ++itr) {
         // get object pointer
@@ -689,6 +694,7 @@ cObjectCollisionType* cMovingSprite::Collision_Check(const GL_rect& new_rect, co
         }
 
         // validate
+        checks++;
         Col_Valid_Type col_valid = Validate_Collision(level_object);
 
         // not a valid collision
@@ -713,6 +719,9 @@ cObjectCollisionType* cMovingSprite::Collision_Check(const GL_rect& new_rect, co
         col_list->Add(Create_Collision_Object(this, level_object, col_valid));
     }
 
+    pPerf_Counters->Add(PERF_COUNT_COLLISION_CANDIDATES, objects->size());
+    pPerf_Counters->Add(PERF_COUNT_COLLISION_CHECKS, checks);
+
     return col_list;
 }
 
@@ -782,7 +791,7 @@ bool cMovingSprite::Set_On_Ground(cSprite* obj, bool set_on_top /* = 1 */)
     }
 
     // set groundobject
-    m_ground_object = obj;
+    Set_Ground_Object(obj);
     // set on top
     if (set_on_top) {
         Set_On_Top(m_ground_object, 0);
@@ -878,64 +887,175 @@ void cMovingSprite::Collide_Move(void)
         return;
     }
 
+    const float pos_x_orig = m_pos_x;
+    const float pos_y_orig = m_pos_y;
+
     // move and create collision data
     Col_Move(m_velx, m_vely);
 
-    Move_With_Ground();
+    // carry the objects standing on us
+    if (!m_riders.empty()) {
+        Move_Riders(m_pos_x - pos_x_orig, m_pos_y - pos_y_orig);
+    }
 }
 
-void cMovingSprite::Move_With_Ground(void)
+bool cMovingSprite::Get_Collide_Move_Rect(GL_rect& rect) const
 {
-    if (!m_ground_object || (m_ground_object->m_sprite_array != ARRAY_ACTIVE && m_ground_object->m_sprite_array != ARRAY_ENEMY)) {  // || m_ground_object->sprite_array == ARRAY_MASSIVE
-        return;
+    if (!m_valid_update || !Is_In_Range()) {
+        return 0;
     }
 
-    cMovingSprite* moving_ground_object = dynamic_cast<cMovingSprite*>(m_ground_object);
+    const float move_x = m_velx * pFramerate->m_speed_factor;
+    const float move_y = m_vely * pFramerate->m_speed_factor;
 
-    // invalid moving sprite
-    if (!moving_ground_object) {
-        return;
+    // same as Col_Move
+    if (Is_Float_Equal(move_x, 0.0f) && Is_Float_Equal(move_y, 0.0f)) {
+        return 0;
     }
 
-    // does not move
-    if (Is_Float_Equal(moving_ground_object->m_velx, 0.0f) && Is_Float_Equal(moving_ground_object->m_vely, 0.0f)) {
+    rect = m_col_rect;
+
+    if (move_x > 0.0f) {
+        rect.m_w += move_x;
+    }
+    else {
+        rect.m_x += move_x;
+        rect.m_w -= move_x;
+    }
+
+    if (move_y > 0.0f) {
+        rect.m_h += move_y;
+    }
+    else {
+        rect.m_y += move_y;
+        rect.m_h -= move_y;
+    }
+
+    return 1;
+}
+
+void cMovingSprite::Move_Riders(float move_x, float move_y)
+{
+    if (Is_Float_Equal(move_x, 0.0f) && Is_Float_Equal(move_y, 0.0f)) {
         return;
     }
 
-    // check ground first because of the moving object velocity
-    Check_on_Ground();
-    // save posx for possible can not move test
-    float posy_orig = m_pos_y;
-    /* stop object from getting stopped of the moving object which did not yet move itself
-     * for example the player always moves as last
-    */
-    bool is_massive = 0;
-    if (moving_ground_object->m_massive_type == MASS_MASSIVE) {
-        moving_ground_object->m_massive_type = MASS_PASSIVE;
-        is_massive = 1;
+    // riders in ground order with the index of their ground
+    vector<cMovingSprite*> chain;
+    vector<int> chain_ground;
+
+    for (vector<cMovingSprite*>::const_iterator itr = m_riders.begin(); itr != m_riders.end(); ++itr) {
+        chain.push_back(*itr);
+        chain_ground.push_back(-1);
     }
-    // move
-    Col_Move(moving_ground_object->m_velx, moving_ground_object->m_vely, 0, 0, 0);
 
-    if (is_massive) {
-        moving_ground_object->m_massive_type = MASS_MASSIVE;
+    for (unsigned int i = 0; i < chain.size(); i++) {
+        const vector<cMovingSprite*>& riders = chain[i]->m_riders;
+
+        for (vector<cMovingSprite*>::const_iterator itr = riders.begin(); itr != riders.end(); ++itr) {
+            // ground loop
+            if ((*itr) == this || std::find(chain.begin(), chain.end(), *itr) != chain.end()) {
+                continue;
+            }
+
+            chain.push_back(*itr);
+            chain_ground.push_back(i);
+        }
+    }
+
+    // move the group
+    for (vector<cMovingSprite*>::iterator itr = chain.begin(); itr != chain.end(); ++itr) {
+        (*itr)->Move(move_x, move_y, 1);
     }
-    // if ground object is moving up
-    if (moving_ground_object->m_vely < -0.01f) {
-        // test if we could not move upwards because something did block us in Col_Move()
-        if (Is_Float_Equal(m_pos_y, posy_orig)) {
+
+    // check every rider once with the ground below it already in place
+    vector<bool> chain_stopped(chain.size(), 0);
+
+    for (unsigned int i = 0; i < chain.size(); i++) {
+        cMovingSprite* rider = chain[i];
+        const int ground = chain_ground[i];
+
+        // the ground stayed behind
+        if (ground >= 0 && chain_stopped[ground]) {
+            rider->Move(-move_x, -move_y, 1);
+            chain_stopped[i] = 1;
+            continue;
+        }
+
+        // ignore only touching objects
+        GL_rect check_rect = rider->m_col_rect;
+        check_rect.m_x += 0.1f;
+        check_rect.m_y += 0.1f;
+        check_rect.m_w -= 0.2f;
+        check_rect.m_h -= 0.2f;
+
+        cObjectCollisionType* col_list = rider->Collision_Check(check_rect, COLLIDE_ONLY_BLOCKING);
+        bool blocked = 0;
+
+        for (cObjectCollision_List::iterator col_itr = col_list->objects.begin(); col_itr != col_list->objects.end(); ++col_itr) {
+            const cSprite* col_obj = (*col_itr)->m_obj;
+
+            // moved with us
+            if (col_obj == this || std::find(chain.begin(), chain.end(), col_obj) != chain.end()) {
+                continue;
+            }
+
+            blocked = 1;
+            break;
+        }
+
+        delete col_list;
+
+        if (!blocked) {
+            continue;
+        }
+
+        cSprite* ground_object = rider->m_ground_object;
+
+        // ground is moving up
+        if (move_y < -0.01f && ground_object) {
             // massive
-            if (moving_ground_object->m_massive_type == MASS_MASSIVE) {
+            if (ground_object->m_massive_type == MASS_MASSIVE) {
                 // got crunched
-                DownGrade(1);
+                rider->DownGrade(1);
+                continue;
             }
             // halfmassive
-            else if (moving_ground_object->m_massive_type == MASS_HALFMASSIVE) {
+            else if (ground_object->m_massive_type == MASS_HALFMASSIVE) {
                 // lost ground
-                Move(0.0f, 1.9f, 1);
-                Reset_On_Ground();
+                rider->Move(-move_x, -move_y + 1.9f, 1);
+                rider->Reset_On_Ground();
+                chain_stopped[i] = 1;
+                continue;
             }
         }
+
+        // stay behind
+        rider->Move(-move_x, -move_y, 1);
+        rider->Reset_On_Ground();
+        chain_stopped[i] = 1;
+    }
+}
+
+void cMovingSprite::Set_Ground_Object(cSprite* obj)
+{
+    if (m_ground_object == obj) {
+        return;
+    }
+
+    if (m_ground_object) {
+        vector<cMovingSprite*>& riders = m_ground_object->m_riders;
+        vector<cMovingSprite*>::iterator itr = std::find(riders.begin(), riders.end(), this);
+
+        if (itr != riders.end()) {
+            riders.erase(itr);
+        }
+    }
+
+    m_ground_object = obj;
+
+    if (m_ground_object) {
+        m_ground_object->m_riders.push_back(this);
     }
 }
 
@@ -1119,7 +1239,7 @@ Col_Valid_Type cMovingSprite::Validate_Collision_Object_On_Top(cMovingSprite* mo
         else if (m_massive_type == MASS_MASSIVE) {
             // always pick up
             if (moving_sprite->m_ground_object != this) {
-                moving_sprite->m_ground_object = this;
+                moving_sprite->Set_Ground_Object(this);
                 return COL_VTYPE_NOT_VALID;
             }
         }
@@ -1182,6 +1302,7 @@ void cMovingSprite::Send_Collision(const cObjectCollision* collision, bool handl
 
     // create the new collision
     cObjectCollision* new_collision = new cObjectCollision();
+    pPerf_Counters->Add(PERF_COUNT_COLLISION_OBJECTS);
     // this is a received collision
     new_collision->m_received = 1;
 
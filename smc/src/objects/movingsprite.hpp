@@ -100,10 +100,12 @@ namespace SMC {
         */
         virtual void Col_Move(float move_x, float move_y, bool real = 0, bool force = 0, bool check_on_ground = 1);
 
-        /* if the ground object moves then move us with it
-         * massive moving ground can crunch us
+        /* Move the sprites standing on us and the sprites standing on them with us
+         * The whole chain is moved as a group and every rider is checked once.
+         * A blocked rider stays behind and loses its ground
+         * except if we move upwards where massive ground crunches it.
         */
-        void Move_With_Ground(void);
+        void Move_Riders(float move_x, float move_y);
 
         // Set velocity
         inline void Set_Velocity(const float x, const float y)
@@ -220,13 +222,15 @@ namespace SMC {
         // object looses onground state
         inline void Reset_On_Ground(void)
         {
-            m_ground_object = NULL;
+            Set_Ground_Object(NULL);
         };
         // Corrects the position if the object got stuck
         void Update_Anti_Stuck(void);
 
         // default collision and movement handling
         virtual void Collide_Move(void);
+        // Get the rect checked by Col_Move() for the velocity of this frame
+        virtual bool Get_Collide_Move_Rect(GL_rect& rect) const;
 
         /* Freeze for the given time
         */
@@ -303,6 +307,8 @@ namespace SMC {
          * stop_on_internal : if set stops moving if internal collision was found
         */
         cObjectCollisionType* Col_Move_in_Steps(float move_x, float move_y, float step_size_x, float step_size_y, float final_pos_x, float final_pos_y, cSprite_List sprite_list, bool stop_on_internal = 0);
+        // Set the ground object and update the riders of the old and new ground object
+        void Set_Ground_Object(cSprite* obj);
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -207,6 +207,36 @@ void cPowerUp::Handle_Collision_Player(cObjectCollision* collision)
     Activate();
 }
 
+void cPowerUp::Get_Sound_Files(vector<std::string>& sound_files) const
+{
+    Get_Item_Sound_Files(m_type, sound_files);
+}
+
+void cPowerUp::Get_Item_Sound_Files(SpriteType item_type, vector<std::string>& sound_files)
+{
+    if (item_type == TYPE_MUSHROOM_DEFAULT) {
+        sound_files.push_back("item/mushroom.ogg");
+    }
+    else if (item_type == TYPE_FIREPLANT) {
+        sound_files.push_back("item/fireplant.ogg");
+    }
+    else if (item_type == TYPE_MUSHROOM_BLUE) {
+        sound_files.push_back("item/mushroom_blue.wav");
+    }
+    else if (item_type == TYPE_MUSHROOM_GHOST) {
+        sound_files.push_back("item/mushroom_ghost.ogg");
+    }
+    else if (item_type == TYPE_MUSHROOM_LIVE_1) {
+        sound_files.push_back("item/live_up.ogg");
+    }
+    else if (item_type == TYPE_MUSHROOM_POISON) {
+        sound_files.push_back("player/powerdown.ogg");
+    }
+    else if (item_type == TYPE_MOON) {
+        sound_files.push_back("item/moon.ogg");
+    }
+}
+
 /* *** *** *** *** *** *** cMushroom *** *** *** *** *** *** *** *** *** *** *** */
 
 cMushroom::cMushroom(cSprite_Manager* sprite_manager)
@@ -237,6 +267,7 @@ void cMushroom::Init(void)
     m_velx = 3.0f;
     m_direction = DIR_RIGHT;
     m_camera_range = 5000;
+    Set_Update_Policy(UPDATE_POLICY_IN_RANGE);
 
     m_type = TYPE_UNDEFINED;
     Set_Type(TYPE_MUSHROOM_DEFAULT);
@@ -495,6 +526,7 @@ cFirePlant::~cFirePlant(void)
 void cFirePlant::Init(void)
 {
     m_type = TYPE_FIREPLANT;
+    Set_Update_Policy(UPDATE_POLICY_IN_RANGE);
     m_can_be_on_ground = 0;
     m_pos_z = 0.051f;
 
@@ -615,6 +647,7 @@ cMoon::~cMoon(void)
 void cMoon::Init(void)
 {
     m_type = TYPE_MOON;
+    Set_Update_Policy(UPDATE_POLICY_IN_RANGE);
     m_can_be_on_ground = 0;
     m_pos_z = 0.052f;
 
@@ -68,6 +68,11 @@ namespace SMC {
         // collision from player
         virtual void Handle_Collision_Player(cObjectCollision* collision);
 
+        // Add the sound files played when this powerup is collected
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const;
+        // Add the sound files played when an item of the given type is collected
+        static void Get_Item_Sound_Files(SpriteType item_type, vector<std::string>& sound_files);
+
         float m_counter;
 
         // node saving inherited
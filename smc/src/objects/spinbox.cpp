@@ -46,6 +46,7 @@ void cSpinBox::Init(void)
     box_type = m_type;
     m_name = "Spinbox";
     m_camera_range = 5000;
+    Set_Update_Policy(UPDATE_POLICY_IN_RANGE);
     m_can_be_on_ground = 0;
 
     m_spin_counter = 0.0f;
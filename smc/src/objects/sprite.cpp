@@ -84,6 +84,7 @@ cObjectCollision* cCollidingSprite::Create_Collision_Object(const cSprite* base,
 
     // create
     cObjectCollision* collision = new cObjectCollision();
+    pPerf_Counters->Add(PERF_COUNT_COLLISION_OBJECTS);
 
     // if col object is available
     if (col) {
@@ -305,6 +306,7 @@ const float cSprite::m_pos_z_front_passive_start = 0.1f;
 const float cSprite::m_pos_z_halfmassive_start = 0.04f;
 const float cSprite::m_pos_z_player = 0.0999f;
 const float cSprite::m_pos_z_delta = 0.000001f;
+Uint32 cSprite::m_editor_rect_change_count = 0;
 
 cSprite::cSprite(cSprite_Manager* sprite_manager, const std::string type_name /* = "sprite" */)
     : cCollidingSprite(sprite_manager), m_type_name(type_name)
@@ -328,6 +330,11 @@ cSprite::cSprite(XmlAttributes& attributes, cSprite_Manager* sprite_manager, con
 
 cSprite::~cSprite(void)
 {
+    // riders lose their ground
+    for (vector<cMovingSprite*>::iterator itr = m_riders.begin(); itr != m_riders.end(); ++itr) {
+        (*itr)->m_ground_object = NULL;
+    }
+
     if (m_delete_image && m_image) {
         delete m_image;
         m_image = NULL;
@@ -405,6 +412,22 @@ void cSprite::Init(void)
 
     m_valid_draw = 1;
     m_valid_update = 1;
+    m_collide_move_stamp = 0;
+    m_broad_phase_stamp = 0;
+    m_broad_phase_num = 0;
+    m_broad_phase_mover = -1;
+    m_quad.m_image = NULL;
+    m_quad_dirty = 1;
+
+    // a basic sprite has nothing to update
+    m_update_policy = UPDATE_POLICY_SLEEP;
+    m_update_interval = 1;
+    m_update_skipped_speed_factor = 0.0f;
+    m_update_skipped_ticks = 0;
+    m_sleeping = 1;
+    m_sleep_time = 0.0f;
+    m_sleep_player_distance = 0.0f;
+    m_sleep_wake_on_touch = 0;
 
     m_editor_window_name_width = 0.0f;
 
@@ -511,6 +534,11 @@ void cSprite::Set_Image(cGL_Surface* new_image, bool new_start_image /* = 0 */,
 
     m_image = new_image;
 
+    // the editor rect size may change
+    if (editor_enabled || new_start_image) {
+        m_editor_rect_change_count++;
+    }
+
     if (m_image) {
         // collision data
         m_col_pos = m_image->m_col_pos;
@@ -725,6 +753,8 @@ void cSprite::Update_Rect_Rotation_Z(void)
         m_col_rect.m_w = m_col_rect.m_h;
         m_col_rect.m_h = orig_col_w;
     }
+
+    Col_Rect_Changed();
 }
 
 void cSprite::Set_Rotation_X(float rot, bool new_start_rot /* = 0 */)
@@ -789,6 +819,9 @@ void cSprite::Set_Scale_X(const float scale, const bool new_startscale /* = 0 */
     if (new_startscale) {
         m_start_scale_x = m_scale_x;
     }
+
+    m_quad_dirty = 1;
+    Col_Rect_Changed();
 }
 
 void cSprite::Set_Scale_Y(const float scale, const bool new_startscale /* = 0 */)
@@ -815,6 +848,9 @@ void cSprite::Set_Scale_Y(const float scale, const bool new_startscale /* = 0 */
     if (new_startscale) {
         m_start_scale_y = m_scale_y;
     }
+
+    m_quad_dirty = 1;
+    Col_Rect_Changed();
 }
 void cSprite::Set_On_Top(const cSprite* sprite, bool optimize_hor_pos /* = 1 */)
 {
@@ -861,6 +897,10 @@ void cSprite::Update_Position_Rect(void)
     }
     // editor mode
     else {
+        if (!Is_Float_Equal(m_start_rect.m_x, m_start_pos_x) || !Is_Float_Equal(m_start_rect.m_y, m_start_pos_y)) {
+            m_editor_rect_change_count++;
+        }
+
         m_rect.m_x = m_start_pos_x;
         m_rect.m_y = m_start_pos_y;
         m_start_rect.m_x = m_start_pos_x;
@@ -870,9 +910,18 @@ void cSprite::Update_Position_Rect(void)
         m_col_rect.m_y = m_pos_y + m_col_pos.m_y;
     }
 
+    m_quad_dirty = 1;
+    Col_Rect_Changed();
     Update_Valid_Draw();
 }
 
+void cSprite::Col_Rect_Changed(void)
+{
+    if (m_sprite_manager && m_broad_phase_stamp == m_sprite_manager->m_broad_phase.m_stamp && m_sprite_manager->m_broad_phase.Is_Active()) {
+        m_sprite_manager->m_broad_phase.Col_Rect_Changed(this);
+    }
+}
+
 void cSprite::Update_Valid_Draw(void)
 {
     m_valid_draw = Is_Draw_Valid();
@@ -883,6 +932,49 @@ void cSprite::Update_Valid_Update(void)
     m_valid_update = Is_Update_Valid();
 }
 
+void cSprite::Set_Update_Policy(Sprite_Update_Policy policy, unsigned int interval /* = 1 */)
+{
+    if (interval < 1) {
+        interval = 1;
+    }
+
+    m_update_policy = policy;
+    m_update_interval = interval;
+    m_update_skipped_speed_factor = 0.0f;
+    m_update_skipped_ticks = 0;
+    m_sleeping = 0;
+
+    if (m_sprite_manager) {
+        m_sprite_manager->Invalidate_Update_Buckets();
+    }
+}
+
+void cSprite::Sleep(float time /* = 0.0f */, float player_distance /* = 0.0f */, bool wake_on_touch /* = 0 */)
+{
+    m_sleep_time = time;
+    m_sleep_player_distance = player_distance;
+    m_sleep_wake_on_touch = wake_on_touch;
+    m_sleeping = 1;
+
+    // the wake up conditions decide the bucket
+    if (m_sprite_manager) {
+        m_sprite_manager->Invalidate_Update_Buckets();
+    }
+}
+
+void cSprite::Wake_Up(void)
+{
+    if (!m_sleeping) {
+        return;
+    }
+
+    m_sleeping = 0;
+
+    if (m_sprite_manager) {
+        m_sprite_manager->Invalidate_Update_Buckets();
+    }
+}
+
 void cSprite::Draw(cSurface_Request* request /* = NULL */)
 {
     if (!m_valid_draw) {
@@ -965,6 +1057,8 @@ void cSprite::Draw_Image(cSurface_Request* request /* = NULL */) const
         return;
     }
 
+    pPerf_Counters->Add(PERF_COUNT_SPRITES_DRAWN);
+
     bool create_request = 0;
 
     if (!request) {
@@ -990,93 +1084,126 @@ void cSprite::Draw_Image(cSurface_Request* request /* = NULL */) const
 
 void cSprite::Draw_Image_Normal(cSurface_Request* request /* = NULL */) const
 {
-    // texture id
+    // code changing the image or position directly does not set the quad dirty
+    if (m_quad_dirty || m_quad.m_image != m_image || m_quad.m_sprite_pos_x != m_pos_x || m_quad.m_sprite_pos_y != m_pos_y) {
+        Update_Quad();
+    }
+
+    // texture id which changes if the textures are restored
     request->m_texture_id = m_image->m_image;
 
-    // size
-    request->m_w = m_image->m_start_w;
-    request->m_h = m_image->m_start_h;
+    // position and size
+    request->m_pos_x = m_quad.m_pos_x;
+    request->m_pos_y = m_quad.m_pos_y;
+    request->m_w = m_quad.m_w;
+    request->m_h = m_quad.m_h;
+
+    // scale
+    if (m_quad.m_scale_x != 1.0f) {
+        request->m_scale_x = m_quad.m_scale_x;
+    }
+
+    if (m_quad.m_scale_y != 1.0f) {
+        request->m_scale_y = m_quad.m_scale_y;
+    }
 
     // rotation
     request->m_rot_x += m_rot_x + m_image->m_base_rot_x;
     request->m_rot_y += m_rot_y + m_image->m_base_rot_y;
     request->m_rot_z += m_rot_z + m_image->m_base_rot_z;
 
+    // position z
+    request->m_pos_z = m_pos_z;
+
+    // no camera setting
+    request->m_no_camera = m_no_camera;
+
+    // color
+    request->m_color = m_color;
+    // combine color
+    if (m_combine_type) {
+        request->m_combine_type = m_combine_type;
+        request->m_combine_color[0] = m_combine_color[0];
+        request->m_combine_color[1] = m_combine_color[1];
+        request->m_combine_color[2] = m_combine_color[2];
+    }
+
+    // shadow
+    if (m_shadow_pos) {
+        request->m_shadow_pos = m_shadow_pos;
+        request->m_shadow_color = m_shadow_color;
+    }
+}
+
+void cSprite::Update_Quad(void) const
+{
+    pPerf_Counters->Add(PERF_COUNT_SPRITE_QUADS_BUILT);
+
+    m_quad.m_image = m_image;
+    m_quad.m_sprite_pos_x = m_pos_x;
+    m_quad.m_sprite_pos_y = m_pos_y;
+    m_quad_dirty = 0;
+
+    // size
+    m_quad.m_w = m_image->m_start_w;
+    m_quad.m_h = m_image->m_start_h;
+
+    m_quad.m_scale_x = 1.0f;
+    m_quad.m_scale_y = 1.0f;
+
     // position x and
     // scalex
     if (m_scale_x != 1.0f) {
         // scale to the right and left
         if (m_scale_right && m_scale_left) {
-            request->m_scale_x = m_scale_x;
-            request->m_pos_x = m_pos_x + (m_image->m_int_x * m_scale_x) - ((m_image->m_w * 0.5f) * (m_scale_x - 1.0f));
+            m_quad.m_scale_x = m_scale_x;
+            m_quad.m_pos_x = m_pos_x + (m_image->m_int_x * m_scale_x) - ((m_image->m_w * 0.5f) * (m_scale_x - 1.0f));
         }
         // scale to the right only
         else if (m_scale_right) {
-            request->m_scale_x = m_scale_x;
-            request->m_pos_x = m_pos_x + (m_image->m_int_x * m_scale_x);
+            m_quad.m_scale_x = m_scale_x;
+            m_quad.m_pos_x = m_pos_x + (m_image->m_int_x * m_scale_x);
         }
         // scale to the left only
         else if (m_scale_left) {
-            request->m_scale_x = m_scale_x;
-            request->m_pos_x = m_pos_x + (m_image->m_int_x * m_scale_x) - ((m_image->m_w) * (m_scale_x - 1.0f));
+            m_quad.m_scale_x = m_scale_x;
+            m_quad.m_pos_x = m_pos_x + (m_image->m_int_x * m_scale_x) - ((m_image->m_w) * (m_scale_x - 1.0f));
         }
         // no scaling
         else {
-            request->m_pos_x = m_pos_x + m_image->m_int_x;
+            m_quad.m_pos_x = m_pos_x + m_image->m_int_x;
         }
     }
     // no scalex
     else {
-        request->m_pos_x = m_pos_x + m_image->m_int_x;
+        m_quad.m_pos_x = m_pos_x + m_image->m_int_x;
     }
     // position y and
     // scaley
     if (m_scale_y != 1.0f) {
         // scale down and up
         if (m_scale_down && m_scale_up) {
-            request->m_scale_y = m_scale_y;
-            request->m_pos_y = m_pos_y + (m_image->m_int_y * m_scale_y) - ((m_image->m_h * 0.5f) * (m_scale_y - 1.0f));
+            m_quad.m_scale_y = m_scale_y;
+            m_quad.m_pos_y = m_pos_y + (m_image->m_int_y * m_scale_y) - ((m_image->m_h * 0.5f) * (m_scale_y - 1.0f));
         }
         // scale down only
         else if (m_scale_down) {
-            request->m_scale_y = m_scale_y;
-            request->m_pos_y = m_pos_y + (m_image->m_int_y * m_scale_y);
+            m_quad.m_scale_y = m_scale_y;
+            m_quad.m_pos_y = m_pos_y + (m_image->m_int_y * m_scale_y);
         }
         // scale up only
         else if (m_scale_up) {
-            request->m_scale_y = m_scale_y;
-            request->m_pos_y = m_pos_y + (m_image->m_int_y * m_scale_y) - ((m_image->m_h) * (m_scale_y - 1.0f));
+            m_quad.m_scale_y = m_scale_y;
+            m_quad.m_pos_y = m_pos_y + (m_image->m_int_y * m_scale_y) - ((m_image->m_h) * (m_scale_y - 1.0f));
         }
         // no scaling
         else {
-            request->m_pos_y = m_pos_y + m_image->m_int_y;
+            m_quad.m_pos_y = m_pos_y + m_image->m_int_y;
         }
     }
     // no scaley
     else {
-        request->m_pos_y = m_pos_y + m_image->m_int_y;
-    }
-
-    // position z
-    request->m_pos_z = m_pos_z;
-
-    // no camera setting
-    request->m_no_camera = m_no_camera;
-
-    // color
-    request->m_color = m_color;
-    // combine color
-    if (m_combine_type) {
-        request->m_combine_type = m_combine_type;
-        request->m_combine_color[0] = m_combine_color[0];
-        request->m_combine_color[1] = m_combine_color[1];
-        request->m_combine_color[2] = m_combine_color[2];
-    }
-
-    // shadow
-    if (m_shadow_pos) {
-        request->m_shadow_pos = m_shadow_pos;
-        request->m_shadow_color = m_shadow_color;
+        m_quad.m_pos_y = m_pos_y + m_image->m_int_y;
     }
 }
 
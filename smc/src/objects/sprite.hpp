@@ -26,6 +26,43 @@
 
 namespace SMC {
 
+    /* *** *** *** *** *** *** *** Update policies *** *** *** *** *** *** *** *** *** *** */
+
+    // how cSprite_Manager::Update_Items() calls Update()
+    enum Sprite_Update_Policy {
+        // every frame
+        UPDATE_POLICY_ALWAYS = 0,
+        // every m_update_interval frames with the speed factor of the skipped frames
+        UPDATE_POLICY_INTERVAL = 1,
+        // only in camera range or while the update is not valid ( dying, frozen )
+        UPDATE_POLICY_IN_RANGE = 2,
+        // every frame while awake and not at all while sleeping
+        UPDATE_POLICY_SLEEP = 3
+    };
+
+    /* *** *** *** *** *** *** *** cSprite_Quad *** *** *** *** *** *** *** *** *** *** */
+
+    /* World space image surface of a sprite
+     * Built from the image, position and scale when one of them changed and copied into the
+     * surface request by cSprite::Draw_Image_Normal().
+    */
+    struct cSprite_Quad {
+        // image and position it was built from
+        const cGL_Surface* m_image;
+        float m_sprite_pos_x;
+        float m_sprite_pos_y;
+
+        // position
+        float m_pos_x;
+        float m_pos_y;
+        // size
+        float m_w;
+        float m_h;
+        // scale or 1 if not scaled
+        float m_scale_x;
+        float m_scale_y;
+    };
+
     /* *** *** *** *** *** *** *** cCollidingSprite *** *** *** *** *** *** *** *** *** *** */
 
     class cCollidingSprite: public Scripting::cScriptable_Object {
@@ -297,6 +334,7 @@ namespace SMC {
             m_scale_down = down;
             m_scale_left = left;
             m_scale_right = right;
+            m_quad_dirty = 1;
         };
         // Set the scale
         void Set_Scale_X(const float scale, const bool new_startscale = 0);
@@ -342,9 +380,18 @@ namespace SMC {
 
         // default collision and movement handling
         virtual void Collide_Move(void) {};
+        /* Get the rect checked for collisions by Collide_Move() in this frame
+         * returns false if Collide_Move() does not move
+        */
+        virtual bool Get_Collide_Move_Rect(GL_rect& rect) const
+        {
+            return 0;
+        };
 
         // Update the position rect values
         void Update_Position_Rect(void);
+        // Tell the collision broad phase that the collision rect changed
+        void Col_Rect_Changed(void);
         // default update
         virtual void Update(void) {};
         /* late update
@@ -356,6 +403,25 @@ namespace SMC {
         // update updating validation
         virtual void Update_Valid_Update(void);
 
+        /* Set how the sprite manager calls Update()
+         * interval : frames between the updates with UPDATE_POLICY_INTERVAL
+        */
+        void Set_Update_Policy(Sprite_Update_Policy policy, unsigned int interval = 1);
+        /* Stop updating until woken up
+         * Only used with UPDATE_POLICY_SLEEP.
+         * time : wake up after this many speed factor frames or 0 to not wake up from time
+         * player_distance : wake up if the player is nearer or 0 to not wake up from the player
+         * wake_on_touch : wake up if a collision is handled
+        */
+        void Sleep(float time = 0.0f, float player_distance = 0.0f, bool wake_on_touch = 0);
+        // Wake up and update from the next frame
+        void Wake_Up(void);
+
+        /* Add the sound files this sprite can play
+         * Used to decode the level sounds before they are needed.
+        */
+        virtual void Get_Sound_Files(vector<std::string>& sound_files) const {};
+
         /* Draw
         * if request is NULL automatically creates the request
         */
@@ -538,6 +604,29 @@ namespace SMC {
         /// if updating is valid
         bool m_valid_update;
 
+        /// how the sprite manager calls Update()
+        Sprite_Update_Policy m_update_policy;
+        /// frames between the updates with UPDATE_POLICY_INTERVAL
+        unsigned int m_update_interval;
+        /// speed factor and ticks of the frames skipped with UPDATE_POLICY_INTERVAL
+        float m_update_skipped_speed_factor;
+        Uint32 m_update_skipped_ticks;
+        /// not updated until woken up with UPDATE_POLICY_SLEEP
+        bool m_sleeping;
+        /// wake up conditions of the sleep
+        float m_sleep_time;
+        float m_sleep_player_distance;
+        bool m_sleep_wake_on_touch;
+
+        /// moving sprites having this sprite as ground object. Maintained by cMovingSprite::Set_On_Ground() and Reset_On_Ground().
+        vector<cMovingSprite*> m_riders;
+        /// stamp of the ground ordered collision handling in cSprite_Manager::Handle_Collision_Items()
+        Uint32 m_collide_move_stamp;
+        /// cCollision_Broad_Phase snapshot stamp, object number and moving sprite number or -1
+        Uint32 m_broad_phase_stamp;
+        unsigned int m_broad_phase_num;
+        int m_broad_phase_mover;
+
         /// editor active window list
         typedef vector<cEditor_Object_Settings_Item*> Editor_Object_Settings_List;
         Editor_Object_Settings_List m_editor_windows;
@@ -554,10 +643,20 @@ namespace SMC {
         static const float m_pos_z_player; // Z position for the level player
         static const float m_pos_z_delta; // Minimum possible Z difference (i.e. one Z step).
 
+        /// Incremented when the start or editor rect or the z position of any sprite changes in the editor. Used by cEditor_Pick_Index.
+        static Uint32 m_editor_rect_change_count;
+
         /// Name as shown in the editor.
         virtual std::string Create_Name() const;
 
     protected:
+        // Build the image quad used by Draw_Image_Normal()
+        void Update_Quad(void) const;
+
+        /// cached image quad and if it needs to be rebuilt
+        mutable cSprite_Quad m_quad;
+        mutable bool m_quad_dirty;
+
         /// visible main name component for the user.
         /// Additions such as direction are added behind this.
         std::string m_name;
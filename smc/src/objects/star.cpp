@@ -47,6 +47,7 @@ cjStar::~cjStar(void)
 void cjStar::Init(void)
 {
     m_type = TYPE_STAR;
+    Set_Update_Policy(UPDATE_POLICY_IN_RANGE);
     m_pos_z = 0.053f;
 
     m_direction = DIR_RIGHT;
@@ -53,6 +53,7 @@ void cText_Box::Init(void)
 {
     m_type = TYPE_TEXT_BOX;
     box_type = m_type;
+    Set_Update_Policy(UPDATE_POLICY_IN_RANGE);
     m_can_be_on_ground = 0;
     m_name = "Text Box";
 
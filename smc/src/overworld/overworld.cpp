@@ -99,6 +99,16 @@ void cOverworld_description::Set_Path(fs::path directory, bool set_name /* = fal
         m_name = path_to_utf8(directory);
 }
 
+/* *** *** *** *** *** *** *** *** cWaypoint_Route *** *** *** *** *** *** *** *** *** */
+
+cWaypoint_Route::cWaypoint_Route(void)
+{
+    m_line_forward = NULL;
+    m_line_backward = NULL;
+    m_next = -1;
+    m_previous = -1;
+}
+
 /* *** *** *** *** *** *** *** *** cOverworld *** *** *** *** *** *** *** *** *** */
 
 cOverworld::cOverworld(void)
@@ -175,6 +185,7 @@ void cOverworld::Init()
     m_hud_level_name->Set_Shadow(black, 1.5f);
 
     m_next_level = 0;
+    m_routes_valid = 0;
 
     m_player_start_waypoint = 0;
     m_player_moving_state = STA_STAY;
@@ -216,6 +227,7 @@ void cOverworld::Unload(void)
     m_sprite_manager->Delete_All();
     // Waypoints
     m_waypoints.clear();
+    Invalidate_Routes();
     // Layer
     m_layer->Delete_All();
     // animations
@@ -623,6 +635,16 @@ bool cOverworld::Mouse_Down(Uint8 button)
         // processed by the editor
         return 1;
     }
+    // walk to the clicked Waypoint
+    else if (button == SDL_BUTTON_LEFT && !editor_world_enabled) {
+        const int waypoint = Get_Waypoint_Collision(GL_rect(pMouseCursor->m_x + pActive_Camera->m_x, pMouseCursor->m_y + pActive_Camera->m_y, 1, 1));
+
+        if (waypoint < 0 || !m_waypoints[waypoint]->m_access) {
+            return 0;
+        }
+
+        pOverworld_Player->Walk_To_Waypoint(waypoint);
+    }
     else {
         // not processed
         return 0;
@@ -790,6 +812,165 @@ int cOverworld::Get_Last_Valid_Waypoint(void)
     return -1;
 }
 
+bool cOverworld::Update_Routes(void)
+{
+    // objects can be moved
+    if (editor_world_enabled) {
+        return 0;
+    }
+
+    // up to date
+    if (m_routes_valid && m_layer->Is_Index_Valid()) {
+        return 1;
+    }
+
+    m_layer->Build_Index();
+
+    m_routes.assign(m_waypoints.size(), cWaypoint_Route());
+
+    for (unsigned int i = 0; i < m_waypoints.size(); i++) {
+        cWaypoint* waypoint = m_waypoints[i];
+        cWaypoint_Route& route = m_routes[i];
+
+        // the player stands in the center
+        const float x = waypoint->m_rect.m_x + (waypoint->m_rect.m_w * 0.5f);
+        const float y = waypoint->m_rect.m_y + (waypoint->m_rect.m_h * 0.5f);
+
+        route.m_line_forward = m_layer->Get_Line_Collision_Direction(x, y, waypoint->m_direction_forward).m_line;
+        route.m_line_backward = m_layer->Get_Line_Collision_Direction(x, y, waypoint->m_direction_backward).m_line;
+
+        if (route.m_line_forward) {
+            route.m_next = Get_Waypoint_Array_Num(route.m_line_forward->Get_End_Waypoint());
+        }
+    }
+
+    // walking backward returns to a Waypoint leading here
+    for (unsigned int i = 0; i < m_routes.size(); i++) {
+        const cWaypoint_Route& route = m_routes[i];
+
+        if (route.m_next < 0) {
+            continue;
+        }
+
+        cWaypoint_Route& next_route = m_routes[route.m_next];
+
+        if (!next_route.m_line_backward) {
+            continue;
+        }
+
+        // prefer the Waypoint the backward line belongs to
+        if (next_route.m_previous < 0 || next_route.m_line_backward->m_origin == route.m_line_forward->m_origin) {
+            next_route.m_previous = i;
+        }
+    }
+
+    m_routes_valid = 1;
+
+    return 1;
+}
+
+void cOverworld::Invalidate_Routes(void)
+{
+    m_routes.clear();
+    m_routes_valid = 0;
+}
+
+cLayer_Line_Point_Start* cOverworld::Get_Waypoint_Line(unsigned int waypoint, ObjectDirection dir)
+{
+    if (waypoint >= m_waypoints.size()) {
+        return NULL;
+    }
+
+    cWaypoint* obj = m_waypoints[waypoint];
+
+    if (Update_Routes()) {
+        if (dir == obj->m_direction_forward) {
+            return m_routes[waypoint].m_line_forward;
+        }
+        else if (dir == obj->m_direction_backward) {
+            return m_routes[waypoint].m_line_backward;
+        }
+    }
+
+    return m_layer->Get_Line_Collision_Direction(obj->m_rect.m_x + (obj->m_rect.m_w * 0.5f), obj->m_rect.m_y + (obj->m_rect.m_h * 0.5f), dir).m_line;
+}
+
+int cOverworld::Get_Next_Waypoint_Num(unsigned int waypoint)
+{
+    if (waypoint >= m_waypoints.size()) {
+        return -1;
+    }
+
+    if (Update_Routes()) {
+        return m_routes[waypoint].m_next;
+    }
+
+    cLayer_Line_Point_Start* front_line = Get_Waypoint_Line(waypoint, m_waypoints[waypoint]->m_direction_forward);
+
+    if (!front_line) {
+        return -1;
+    }
+
+    return Get_Waypoint_Array_Num(front_line->Get_End_Waypoint());
+}
+
+bool cOverworld::Get_Waypoint_Path(unsigned int start, unsigned int destination, vector<int>& path)
+{
+    path.clear();
+
+    if (start >= m_waypoints.size() || destination >= m_waypoints.size() || !Update_Routes()) {
+        return 0;
+    }
+
+    if (start == destination) {
+        return 1;
+    }
+
+    // breadth first search from the start
+    vector<int> from(m_waypoints.size(), -1);
+    vector<int> queue;
+    queue.push_back(start);
+    from[start] = start;
+
+    for (unsigned int pos = 0; pos < queue.size() && from[destination] < 0; pos++) {
+        const cWaypoint_Route& route = m_routes[queue[pos]];
+        const int neighbours[2] = { route.m_next, route.m_previous };
+
+        for (unsigned int i = 0; i < 2; i++) {
+            const int num = neighbours[i];
+
+            if (num < 0 || from[num] >= 0 || !m_waypoints[num]->m_access) {
+                continue;
+            }
+
+            from[num] = queue[pos];
+            queue.push_back(num);
+        }
+    }
+
+    // not reachable
+    if (from[destination] < 0) {
+        return 0;
+    }
+
+    for (int num = destination; num != static_cast<int>(start); num = from[num]) {
+        path.insert(path.begin(), num);
+    }
+
+    return 1;
+}
+
+int cOverworld::Get_Waypoint_Array_Num(const cWaypoint* waypoint) const
+{
+    WaypointList::const_iterator itr = std::find(m_waypoints.begin(), m_waypoints.end(), waypoint);
+
+    if (itr == m_waypoints.end()) {
+        return -1;
+    }
+
+    return static_cast<int>(itr - m_waypoints.begin());
+}
+
 void cOverworld::Update_Waypoint_text(void)
 {
     // get waypoint
@@ -830,21 +1011,16 @@ bool cOverworld::Goto_Next_Level(void)
         return 0;
     }
 
-    // Get Layer Line in front
-    cLayer_Line_Point_Start* front_line = pOverworld_Player->Get_Front_Line(current_waypoint->m_direction_forward);
-
-    if (!front_line) {
-        return 0;
-    }
-
     // Get forward Waypoint
-    cWaypoint* next_waypoint = front_line->Get_End_Waypoint();
+    const int next_waypoint_num = Get_Next_Waypoint_Num(pOverworld_Player->m_current_waypoint);
 
     // if no next waypoint available
-    if (!next_waypoint) {
+    if (next_waypoint_num < 0) {
         return 0;
     }
 
+    cWaypoint* next_waypoint = m_waypoints[next_waypoint_num];
+
     // if next waypoint is new
     if (!next_waypoint->m_access) {
         next_waypoint->Set_Access(1);
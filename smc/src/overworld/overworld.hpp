@@ -63,6 +63,25 @@ namespace SMC {
         std::string m_comment;
     };
 
+    /* *** *** *** *** *** *** *** *** cWaypoint_Route *** *** *** *** *** *** *** *** *** */
+
+    // Waypoint connections found on the layer lines
+    class cWaypoint_Route {
+    public:
+        cWaypoint_Route(void);
+
+        // layer line leaving into the forward direction
+        cLayer_Line_Point_Start* m_line_forward;
+        // layer line leaving into the backward direction
+        cLayer_Line_Point_Start* m_line_backward;
+        // Waypoint reached walking forward or -1
+        int m_next;
+        // Waypoint reached walking backward or -1
+        int m_previous;
+    };
+
+    typedef vector<cWaypoint_Route> WaypointRouteList;
+
     /* *** *** *** *** *** *** *** *** cOverworld *** *** *** *** *** *** *** *** *** */
 
 // forward declare
@@ -166,6 +185,27 @@ namespace SMC {
         // update the Waypoint text
         void Update_Waypoint_text(void);
 
+        /* Build the Waypoint routes and the layer index if outdated
+         * not available while the world editor is enabled as objects can be moved
+         * returns true if the routes are available
+        */
+        bool Update_Routes(void);
+        // Mark the Waypoint routes as outdated
+        void Invalidate_Routes(void);
+        /* Returns the layer line leaving the Waypoint into the given direction
+         * if not found returns NULL
+        */
+        cLayer_Line_Point_Start* Get_Waypoint_Line(unsigned int waypoint, ObjectDirection dir);
+        /* Returns the Waypoint reached by walking forward from the given Waypoint
+         * if not found returns -1
+        */
+        int Get_Next_Waypoint_Num(unsigned int waypoint);
+        /* Find the Waypoints to walk through from start to the destination
+         * only accessible Waypoints are used and the start is not included
+         * returns false if not reachable
+        */
+        bool Get_Waypoint_Path(unsigned int start, unsigned int destination, vector<int>& path);
+
         // Enable the next Level and walk into the forward direction
         bool Goto_Next_Level(void);
         // Resets the Waypoint access to the default
@@ -218,6 +258,16 @@ namespace SMC {
 
         // Save only the main overworld file, not layers and description files.
         void Save_To_File(boost::filesystem::path path);
+
+        /* Returns the Waypoint array number
+         * if not found returns -1
+        */
+        int Get_Waypoint_Array_Num(const cWaypoint* waypoint) const;
+
+        // Waypoint routes with the same array numbers as the Waypoints
+        WaypointRouteList m_routes;
+        // routes are up to date
+        bool m_routes_valid;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -38,6 +38,8 @@ cEditor_World::cEditor_World(cSprite_Manager* sprite_manager, cOverworld* overwo
 
     m_editor_item_tag = "world";
     m_camera_speed = 20;
+
+    m_journal.Set_Loader(items_loader_callback, m_overworld, world_engine_version);
 }
 
 cEditor_World::~cEditor_World(void)
@@ -67,6 +69,12 @@ void cEditor_World::Enable(void)
     editor_world_enabled = 1;
     pOverworld_Manager->m_draw_layer = 1;
 
+    // objects can be moved
+    if (m_overworld) {
+        m_overworld->Invalidate_Routes();
+        m_overworld->m_layer->Invalidate_Index();
+    }
+
     if (Game_Mode == MODE_OVERWORLD) {
         editor_enabled = 1;
     }
@@ -118,6 +126,7 @@ bool cEditor_World::Key_Down(SDLKey key)
 void cEditor_World::Set_Overworld(cOverworld* overworld)
 {
     m_overworld = overworld;
+    m_journal.Set_Loader(items_loader_callback, m_overworld, world_engine_version);
 }
 
 void cEditor_World::Activate_Menu_Item(cEditor_Menu_Object* entry)
@@ -232,7 +241,7 @@ void cEditor_World::Function_Reload(void)
     }
 
     cOverworld* p_old_world = m_overworld;
-    m_overworld = cOverworld::Load_From_Directory(p_old_world->m_description->Get_Path());
+    Set_Overworld(cOverworld::Load_From_Directory(p_old_world->m_description->Get_Path()));
     delete p_old_world;
 }
 
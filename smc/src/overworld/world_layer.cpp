@@ -275,9 +275,12 @@ cLine_collision::cLine_collision(void)
 
 /* *** *** *** *** *** *** *** *** Layer *** *** *** *** *** *** *** *** *** */
 
+const float cLayer::m_index_cell_size = 128.0f;
+
 cLayer::cLayer(cOverworld* origin)
 {
     m_overworld = origin;
+    m_index_valid = 0;
 }
 
 cLayer::~cLayer(void)
@@ -298,6 +301,7 @@ void cLayer::Add(cLayer_Line_Point_Start* line_point)
     }
 
     cObject_Manager<cLayer_Line_Point_Start>::Add(line_point);
+    Invalidate_Index();
 
     // check if in sprite manager
     if (m_overworld->m_sprite_manager->Get_Array_Num(line_point) == -1) {
@@ -336,14 +340,97 @@ void cLayer::Save_To_File(const fs::path& path)
     debug_print("Wrote world layer file '%s'.\n", path_to_utf8(path).c_str());
 }
 
+bool cLayer::Delete(size_t array_num, bool delete_data /* = 1 */)
+{
+    Invalidate_Index();
+
+    return cObject_Manager<cLayer_Line_Point_Start>::Delete(array_num, delete_data);
+}
+
+bool cLayer::Delete(cLayer_Line_Point_Start* line_point, bool delete_data /* = 1 */)
+{
+    Invalidate_Index();
+
+    return cObject_Manager<cLayer_Line_Point_Start>::Delete(line_point, delete_data);
+}
+
 void cLayer::Delete_All(void)
 {
     // only clear array
     objects.clear();
+    Invalidate_Index();
+}
+
+void cLayer::Build_Index(void)
+{
+    m_index.clear();
+
+    for (unsigned int i = 0; i < objects.size(); i++) {
+        cLayer_Line_Point_Start* layer_line = objects[i];
+
+        // the point rects are included for the start point collision
+        const GL_rect& start_rect = layer_line->m_col_rect;
+        const GL_rect& end_rect = layer_line->m_linked_point->m_col_rect;
+
+        const int cell_x1 = static_cast<int>(floor(std::min(start_rect.m_x, end_rect.m_x) / m_index_cell_size));
+        const int cell_y1 = static_cast<int>(floor(std::min(start_rect.m_y, end_rect.m_y) / m_index_cell_size));
+        const int cell_x2 = static_cast<int>(floor(std::max(start_rect.m_x + start_rect.m_w, end_rect.m_x + end_rect.m_w) / m_index_cell_size));
+        const int cell_y2 = static_cast<int>(floor(std::max(start_rect.m_y + start_rect.m_h, end_rect.m_y + end_rect.m_h) / m_index_cell_size));
+
+        for (int x = cell_x1; x <= cell_x2; x++) {
+            for (int y = cell_y1; y <= cell_y2; y++) {
+                m_index[std::make_pair(x, y)].push_back(i);
+            }
+        }
+    }
+
+    m_index_valid = 1;
+}
+
+void cLayer::Invalidate_Index(void)
+{
+    m_index_valid = 0;
+}
+
+void cLayer::Get_Index_Lines(float x1, float y1, float x2, float y2, vector<unsigned int>& lines) const
+{
+    const int cell_x1 = static_cast<int>(floor(std::min(x1, x2) / m_index_cell_size));
+    const int cell_y1 = static_cast<int>(floor(std::min(y1, y2) / m_index_cell_size));
+    const int cell_x2 = static_cast<int>(floor(std::max(x1, x2) / m_index_cell_size));
+    const int cell_y2 = static_cast<int>(floor(std::max(y1, y2) / m_index_cell_size));
+
+    for (int x = cell_x1; x <= cell_x2; x++) {
+        for (int y = cell_y1; y <= cell_y2; y++) {
+            LayerIndexMap::const_iterator cell = m_index.find(std::make_pair(x, y));
+
+            if (cell != m_index.end()) {
+                lines.insert(lines.end(), cell->second.begin(), cell->second.end());
+            }
+        }
+    }
+
+    // keep the order of the unindexed search
+    std::sort(lines.begin(), lines.end());
+    lines.erase(std::unique(lines.begin(), lines.end()), lines.end());
 }
 
 cLayer_Line_Point_Start* cLayer::Get_Line_Collision_Start(const GL_rect& line_rect)
 {
+    if (m_index_valid) {
+        vector<unsigned int> lines;
+        Get_Index_Lines(line_rect.m_x, line_rect.m_y, line_rect.m_x + line_rect.m_w, line_rect.m_y + line_rect.m_h, lines);
+
+        for (vector<unsigned int>::const_iterator itr = lines.begin(); itr != lines.end(); ++itr) {
+            cLayer_Line_Point_Start* layer_line = objects[*itr];
+
+            if (line_rect.Intersects(layer_line->m_col_rect)) {
+                return layer_line;
+            }
+        }
+
+        return NULL;
+    }
+
     for (LayerLineList::iterator itr = objects.begin(); itr != objects.end(); ++itr) {
         // get pointer
         cLayer_Line_Point_Start* layer_line = (*itr);
@@ -385,6 +472,37 @@ cLine_collision cLayer::Get_Line_Collision_Direction(float x, float y, ObjectDir
 
 cLine_collision cLayer::Get_Nearest(float x, float y, ObjectDirection dir /* = DIR_HORIZONTAL */, unsigned int check_size /* = 15 */, int only_origin_id /* = -1 */) const
 {
+    // only check the lines near the direction checking lines
+    if (m_index_valid) {
+        vector<unsigned int> lines;
+
+        if (dir == DIR_HORIZONTAL) {
+            Get_Index_Lines(x - check_size, y, x + check_size, y, lines);
+        }
+        else {
+            Get_Index_Lines(x, y - check_size, x, y + check_size, lines);
+        }
+
+        for (vector<unsigned int>::const_iterator itr = lines.begin(); itr != lines.end(); ++itr) {
+            cLayer_Line_Point_Start* layer_line = objects[*itr];
+
+            // line is not from waypoint
+            if (only_origin_id >= 0 && only_origin_id != layer_line->m_origin) {
+                continue;
+            }
+
+            cLine_collision col = Get_Nearest_Line(layer_line, x, y, dir, check_size);
+
+            // found
+            if (col.m_line) {
+                return col;
+            }
+        }
+
+        // none found
+        return cLine_collision();
+    }
+
     for (LayerLineList::const_iterator itr = objects.begin(); itr != objects.end(); ++itr) {
         // get pointer
         cLayer_Line_Point_Start* layer_line = (*itr);
@@ -124,6 +124,9 @@ namespace SMC {
 
         // Add a layer line
         virtual void Add(cLayer_Line_Point_Start* line_point);
+        // Remove a layer line
+        virtual bool Delete(size_t array_num, bool delete_data = 1);
+        virtual bool Delete(cLayer_Line_Point_Start* line_point, bool delete_data = 1);
 
         // Save to file, raises xmlpp::exception on failure
         void Save_To_File(const boost::filesystem::path& filename);
@@ -131,6 +134,18 @@ namespace SMC {
         // Delete all objects
         virtual void Delete_All(void);
 
+        /* Build the spatial index of the lines
+         * the lines must not be moved while the index is used
+        */
+        void Build_Index(void);
+        // Mark the spatial index as outdated
+        void Invalidate_Index(void);
+        // Return true if the spatial index is used for the line lookups
+        bool Is_Index_Valid(void) const
+        {
+            return m_index_valid;
+        };
+
         /* Returns the colliding Line start point
          * if not found returns NULL
         */
@@ -150,6 +165,21 @@ namespace SMC {
 
         // parent overworld
         cOverworld* m_overworld;
+
+    private:
+        /* Get the lines which may touch the given area
+         * in the array order without duplicates
+        */
+        void Get_Index_Lines(float x1, float y1, float x2, float y2, vector<unsigned int>& lines) const;
+
+        typedef std::map<std::pair<int, int>, vector<unsigned int> > LayerIndexMap;
+
+        // size of an index cell
+        static const float m_index_cell_size;
+        // line array numbers in each used cell
+        LayerIndexMap m_index;
+        // index is up to date
+        bool m_index_valid;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
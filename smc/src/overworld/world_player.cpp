@@ -259,6 +259,7 @@ void cOverworld_Player::Reset(void)
     m_current_waypoint = -2;
     m_line_waypoint = 0;
     m_current_line = -2;
+    m_route.clear();
 
     m_fixed_walking = 0;
     Set_Direction(DIR_UNDEFINED);
@@ -266,6 +267,9 @@ void cOverworld_Player::Reset(void)
 
 void cOverworld_Player::Action_Interact(input_identifier key_type)
 {
+    // input stops walking to a clicked Waypoint
+    m_route.clear();
+
     // Left
     if (key_type == INP_LEFT) {
         pOverworld_Player->Start_Walk(DIR_LEFT);
@@ -399,7 +403,7 @@ bool cOverworld_Player::Start_Walk(ObjectDirection new_direction)
     // a start from waypoint
     if (m_current_waypoint >= 0 && m_direction == DIR_UNDEFINED) {
         // Get Layer Line in front
-        cLayer_Line_Point_Start* front_line = Get_Front_Line(new_direction);
+        cLayer_Line_Point_Start* front_line = m_overworld->Get_Waypoint_Line(m_current_waypoint, new_direction);
 
         if (!front_line) {
             if (pOverworld_Manager->m_debug_mode) {
@@ -415,7 +419,7 @@ bool cOverworld_Player::Start_Walk(ObjectDirection new_direction)
 
         // forward
         if (Get_Waypoint()->m_direction_forward == new_direction) {
-            cWaypoint* next_waypoint = front_line->Get_End_Waypoint();
+            cWaypoint* next_waypoint = m_overworld->Get_Waypoint(m_overworld->Get_Next_Waypoint_Num(m_current_waypoint));
 
             if (!next_waypoint) {
                 cout << "Next waypoint not detected" << endl;
@@ -573,9 +577,60 @@ void cOverworld_Player::Update_Waypoint_Walk(void)
         Set_Waypoint(m_current_waypoint);
 
         pAudio->Play_Sound("waypoint_reached.ogg");
+
+        // continue walking to the destination
+        if (!m_route.empty()) {
+            if (m_route.front() == m_current_waypoint) {
+                m_route.erase(m_route.begin());
+                Walk_Route();
+            }
+            // walked off the route
+            else {
+                m_route.clear();
+            }
+        }
     }
 }
 
+bool cOverworld_Player::Walk_To_Waypoint(int waypoint)
+{
+    // only from a Waypoint
+    if (m_current_waypoint < 0 || m_direction != DIR_UNDEFINED) {
+        return 0;
+    }
+
+    if (!m_overworld->Get_Waypoint_Path(m_current_waypoint, waypoint, m_route)) {
+        if (pOverworld_Manager->m_debug_mode) {
+            cout << "No route to waypoint " << waypoint << endl;
+        }
+
+        return 0;
+    }
+
+    return Walk_Route();
+}
+
+bool cOverworld_Player::Walk_Route(void)
+{
+    if (m_route.empty()) {
+        return 0;
+    }
+
+    cWaypoint* waypoint = Get_Waypoint();
+    ObjectDirection direction = waypoint->m_direction_backward;
+
+    if (m_overworld->Get_Next_Waypoint_Num(m_current_waypoint) == m_route.front()) {
+        direction = waypoint->m_direction_forward;
+    }
+
+    if (!Start_Walk(direction)) {
+        m_route.clear();
+        return 0;
+    }
+
+    return 1;
+}
+
 bool cOverworld_Player::Set_Waypoint(int waypoint, bool new_startpos /* = 0 */)
 {
     if (waypoint < 0 || waypoint >= static_cast<int>(m_overworld->m_waypoints.size())) {
@@ -82,6 +82,11 @@ namespace SMC {
         */
         void Update_Waypoint_Walk(void);
 
+        /* Walk through the accessible Waypoints to the given Waypoint
+         * returns 0 if not reachable
+        */
+        bool Walk_To_Waypoint(int waypoint);
+
         // Set Maryo to the given Waypoint position
         bool Set_Waypoint(int waypoint, bool new_startpos = 0);
         // Get current Waypoint
@@ -121,7 +126,13 @@ namespace SMC {
         cLine_collision m_line_hor;
         cLine_collision m_line_ver;
 
+        // Waypoints still to walk through
+        vector<int> m_route;
+
     private:
+        // Start walking to the next Waypoint of the route
+        bool Walk_Route(void);
+
         // Debug last set data
         int m_debug_current_line_last;
         int m_debug_lines_last;
@@ -44,6 +44,7 @@ void cWorld_Sprite_Manager::Add(cSprite* sprite)
     // Add to Waypoints array
     if (sprite->m_type == TYPE_OW_WAYPOINT) {
         m_overworld->m_waypoints.push_back(static_cast<cWaypoint*>(sprite));
+        m_overworld->Invalidate_Routes();
     }
     // Add layer line point start to the world layer
     else if (sprite->m_type == TYPE_OW_LINE_START) {
@@ -95,6 +95,7 @@ void cWaypoint::Init(void)
     m_pos_z = cSprite::m_pos_z_massive_start;
 
     m_camera_range = 0;
+    Set_Update_Policy(UPDATE_POLICY_ALWAYS);
 
     m_waypoint_type = WAYPOINT_NORMAL;
     m_name = _("Waypoint");
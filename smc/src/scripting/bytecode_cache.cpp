@@ -0,0 +1,217 @@
+#include "bytecode_cache.hpp"
+#include "../core/filesystem/binary_file.hpp"
+#include "../core/property_helper.hpp"
+#include "../core/global_game.hpp"
+
+#include <mruby/dump.h>
+#include <mruby/irep.h>
+
+////////////////////////////////////////
+// Be sure to review docs/scripting.md!
+////////////////////////////////////////
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace SMC {
+
+namespace Scripting {
+
+// Cache file format version. Increase if the file layout changes.
+static const Uint32 bytecode_cache_version = 2;
+
+/**
+ * FNV-1a hash of the given string.
+ */
+static Uint64 Hash_String(const std::string& str)
+{
+    Uint64 hash = 14695981039346656037ULL;
+
+    for (std::string::const_iterator iter = str.begin(); iter != str.end(); iter++) {
+        hash ^= static_cast<unsigned char>(*iter);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+cMRuby_Bytecode_Cache::cMRuby_Bytecode_Cache()
+{
+    //
+}
+
+cMRuby_Bytecode_Cache::~cMRuby_Bytecode_Cache()
+{
+    Clear();
+}
+
+void cMRuby_Bytecode_Cache::Set_Directory(const fs::path& dir)
+{
+    m_directory = dir;
+
+    if (m_directory.empty())
+        return;
+
+    boost::system::error_code ec;
+    fs::create_directories(m_directory, ec);
+
+    if (ec) {
+        cerr << "Warning: Could not create mruby bytecode cache directory " << path_to_utf8(m_directory) << " : " << ec.message() << endl;
+        m_directory.clear();
+        return;
+    }
+
+    Prune_Files();
+}
+
+void cMRuby_Bytecode_Cache::Clear()
+{
+    m_entries.clear();
+}
+
+/**
+ * Runs the given code like mrb_load_nstring_cxt(), but skips
+ * parsing and compiling if the code was run before. On a syntax
+ * error the code is handed to mrb_load_nstring_cxt() so the error
+ * is reported as usual.
+ * Each source has one entry which is replaced if the code of the
+ * source changed, so edited scripts leave no old files behind.
+ */
+mrb_value cMRuby_Bytecode_Cache::Load_Code(mrb_state* p_state, const std::string& code, mrbc_context* p_context, const std::string& source /* = "" */)
+{
+    // The context filename ends up in the debug info of the bytecode
+    std::string key;
+    if (p_context && p_context->filename)
+        key = p_context->filename;
+
+    Uint64 hash = Hash_String(source.empty() ? key : source);
+
+    key += '\0';
+    key += code;
+
+    cEntry& entry = m_entries[hash];
+
+    // Not yet compiled in this session or the source changed
+    if (entry.m_key != key) {
+        entry.m_key = key;
+        entry.m_bytecode.clear();
+
+        if (!Load_File(hash, key, entry.m_bytecode)) {
+            if (!Compile(p_state, code, p_context, entry.m_bytecode)) {
+                m_entries.erase(hash);
+                return mrb_load_nstring_cxt(p_state, code.c_str(), code.length(), p_context);
+            }
+
+            Save_File(hash, key, entry.m_bytecode);
+        }
+    }
+
+    return mrb_load_irep_cxt(p_state, reinterpret_cast<const uint8_t*>(entry.m_bytecode.data()), p_context);
+}
+
+bool cMRuby_Bytecode_Cache::Compile(mrb_state* p_state, const std::string& code, mrbc_context* p_context, std::string& bytecode)
+{
+    struct mrb_parser_state* p_parser = mrb_parse_nstring(p_state, code.c_str(), code.length(), p_context);
+
+    // Syntax error
+    if (!p_parser || !p_parser->tree || p_parser->nerr > 0) {
+        if (p_parser)
+            mrb_parser_free(p_parser);
+        return false;
+    }
+
+    int arena = mrb_gc_arena_save(p_state);
+    struct RProc* p_proc = mrb_generate_code(p_state, p_parser);
+    mrb_parser_free(p_parser);
+
+    if (!p_proc) {
+        mrb_gc_arena_restore(p_state, arena);
+        return false;
+    }
+
+    // Dump with debug info so exceptions still show file and line
+    uint8_t* p_bin = NULL;
+    size_t bin_size = 0;
+    int result = mrb_dump_irep(p_state, p_proc->body.irep, 1, &p_bin, &bin_size);
+    mrb_gc_arena_restore(p_state, arena);
+
+    if (result != MRB_DUMP_OK || !p_bin)
+        return false;
+
+    bytecode.assign(reinterpret_cast<const char*>(p_bin), bin_size);
+    mrb_free(p_state, p_bin);
+    return true;
+}
+
+fs::path cMRuby_Bytecode_Cache::Get_Filename(Uint64 hash) const
+{
+    char name[32];
+    sprintf(name, "%08x%08x.mrbc", static_cast<unsigned int>(hash >> 32), static_cast<unsigned int>(hash & 0xFFFFFFFF));
+    return m_directory / utf8_to_path(name);
+}
+
+void cMRuby_Bytecode_Cache::Prune_Files() const
+{
+    boost::system::error_code ec;
+    fs::directory_iterator end_iter;
+
+    for (fs::directory_iterator dir_itr(m_directory, ec); !ec && dir_itr != end_iter; dir_itr.increment(ec)) {
+        const fs::path filename = dir_itr->path();
+
+        if (filename.extension() != ".mrbc")
+            continue;
+
+        // Files of other versions are never loaded again
+        bool valid;
+        {
+            cBinary_Reader reader(filename, "SMCMRBC", bytecode_cache_version);
+            valid = reader.Read_Uint32() == smc_version && reader.Read_String() == MRUBY_VERSION && reader.Is_Good();
+        }
+
+        if (!valid) {
+            boost::system::error_code remove_ec;
+            fs::remove(filename, remove_ec);
+        }
+    }
+}
+
+bool cMRuby_Bytecode_Cache::Load_File(Uint64 hash, const std::string& key, std::string& bytecode) const
+{
+    if (m_directory.empty())
+        return false;
+
+    fs::path filename = Get_Filename(hash);
+    if (!fs::exists(filename))
+        return false;
+
+    cBinary_Reader reader(filename, "SMCMRBC", bytecode_cache_version);
+    if (reader.Read_Uint32() != smc_version || reader.Read_String() != MRUBY_VERSION)
+        return false;
+
+    // Only use it for exactly the same script
+    if (reader.Read_String() != key)
+        return false;
+
+    bytecode = reader.Read_String();
+    return reader.Is_Good() && !bytecode.empty();
+}
+
+void cMRuby_Bytecode_Cache::Save_File(Uint64 hash, const std::string& key, const std::string& bytecode) const
+{
+    if (m_directory.empty())
+        return;
+
+    cBinary_Writer writer(Get_Filename(hash), "SMCMRBC", bytecode_cache_version);
+    writer.Write_Uint32(smc_version);
+    writer.Write_String(MRUBY_VERSION);
+    writer.Write_String(key);
+    writer.Write_String(bytecode);
+    writer.Finish();
+}
+
+cMRuby_Bytecode_Cache* pMRuby_Bytecode_Cache = NULL;
+
+}
+
+}
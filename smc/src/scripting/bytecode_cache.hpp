@@ -0,0 +1,60 @@
+#ifndef SMC_SCRIPTING_BYTECODE_CACHE_HPP
+#define SMC_SCRIPTING_BYTECODE_CACHE_HPP
+#include "../core/global_basic.hpp"
+
+namespace SMC {
+    namespace Scripting {
+
+        /**
+         * Caches the compiled mruby bytecode (irep) of scripts so
+         * the same code is only parsed and compiled once. Compiled
+         * scripts are kept in memory and in the user cache directory,
+         * one entry for each script source. A changed script replaces
+         * the entry of its source.
+         */
+        class cMRuby_Bytecode_Cache {
+        public:
+            cMRuby_Bytecode_Cache();
+            ~cMRuby_Bytecode_Cache();
+
+            // Set the directory compiled scripts are stored in and
+            // remove the files written by other versions.
+            // An empty path disables the disk cache.
+            void Set_Directory(const boost::filesystem::path& dir);
+
+            // Compile the code or take it from the cache and run it
+            // with the given context. Works like mrb_load_nstring_cxt():
+            // exceptions are left in p_state->exc.
+            // `source' identifies the script, e.g. its file path. If
+            // empty the context filename is used.
+            mrb_value Load_Code(mrb_state* p_state, const std::string& code, mrbc_context* p_context, const std::string& source = "");
+
+            // Remove all compiled scripts from memory.
+            void Clear();
+
+        private:
+            // Compile the code to bytecode. Returns false on syntax errors.
+            bool Compile(mrb_state* p_state, const std::string& code, mrbc_context* p_context, std::string& bytecode);
+            // Cache file for the given source hash.
+            boost::filesystem::path Get_Filename(Uint64 hash) const;
+            // Remove the cache files of other versions.
+            void Prune_Files() const;
+            bool Load_File(Uint64 hash, const std::string& key, std::string& bytecode) const;
+            void Save_File(Uint64 hash, const std::string& key, const std::string& bytecode) const;
+
+            struct cEntry {
+                // context filename and code, to detect hash collisions
+                std::string m_key;
+                std::string m_bytecode;
+            };
+
+            boost::filesystem::path m_directory;
+            std::map<Uint64, cEntry> m_entries;
+        };
+
+        // The bytecode cache shared by all mruby interpreters.
+        extern cMRuby_Bytecode_Cache* pMRuby_Bytecode_Cache;
+    };
+};
+
+#endif
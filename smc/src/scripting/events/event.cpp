@@ -1,6 +1,7 @@
 #include "event.hpp"
 #include "../../core/property_helper.hpp"
 #include "../../core/global_basic.hpp"
+#include "../../core/perf_counters.hpp"
 
 using namespace SMC;
 using namespace SMC::Scripting;
@@ -20,15 +21,23 @@ void cEvent::Fire(cMRuby_Interpreter* p_mruby, Scripting::cScriptable_Object* p_
     // Menu level has no mruby interpreter
     if (!p_mruby)
         return;
+    // Nothing registered for this object (the common case)
+    if (!p_obj->has_event_handlers())
+        return;
+
+    unsigned int evtid = Event_ID();
+    if (!p_obj->has_event_handler(evtid))
+        return;
+
     mrb_state* p_state = p_mruby->Get_MRuby_State();
 
     // Iterate through the list of callbacks and execute them
-    std::string evtname = Event_Name();
-    std::vector<mrb_value>::iterator start = p_obj->event_handlers_begin(evtname);
-    std::vector<mrb_value>::iterator end = p_obj->event_handlers_end(evtname);
+    std::vector<mrb_value>::iterator start = p_obj->event_handlers_begin(evtid);
+    std::vector<mrb_value>::iterator end = p_obj->event_handlers_end(evtid);
 
     std::vector<mrb_value>::iterator iter;
     for (iter=start; iter != end; iter++) {
+        pPerf_Counters->Add(PERF_COUNT_SCRIPT_CALLBACKS);
         Run_MRuby_Callback(p_mruby, *iter);
         if (p_state->exc) {
             cerr << "Warning: Error running mruby handler:" << endl;
@@ -51,6 +60,16 @@ std::string cEvent::Event_Name()
     return "generic";
 }
 
+/**
+ * Returns the interned ID of Event_Name(). Events fired very often
+ * should override this and cache the ID, as this default implementation
+ * builds and looks up the name on every call.
+ */
+unsigned int cEvent::Event_ID()
+{
+    return cScriptable_Object::intern_event_name(Event_Name());
+}
+
 /**
  * Called whenever a MRuby callback shall be run. The callback is
  * passed as a mruby lambda via the `callback' argument.
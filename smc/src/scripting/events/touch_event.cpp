@@ -15,6 +15,15 @@ std::string cTouch_Event::Event_Name()
     return "touch";
 }
 
+/**
+ * Fired for every collision, so the ID is only looked up once.
+ */
+unsigned int cTouch_Event::Event_ID()
+{
+    static unsigned int evtid = cScriptable_Object::intern_event_name("touch");
+    return evtid;
+}
+
 cSprite* cTouch_Event::Get_Collided()
 {
     return mp_collided;
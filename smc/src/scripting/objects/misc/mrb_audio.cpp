@@ -142,10 +142,11 @@ static mrb_value Play_Sound(mrb_state* p_state,  mrb_value self)
  *
  * #### Return value
  *
- * True on success, false otherwise. Possible failure reasons include
- * incorrect filenames or the music may simply have been muted by
- * the user in SMC’s preferences, so you probably shouldn’t give
- * too much on this.
+ * True if the music was queued, false otherwise. Possible failure
+ * reasons include incorrect filenames or the music may simply have
+ * been muted by the user in SMC’s preferences, so you probably
+ * shouldn’t give too much on this. The music is loaded in the
+ * background, a file which can not be decoded only prints a warning.
  */
 static mrb_value Play_Music(mrb_state* p_state,  mrb_value self)
 {
@@ -4,6 +4,7 @@
 #include "../../core/filesystem/resource_manager.hpp"
 #include "../../core/filesystem/package_manager.hpp"
 #include "../../core/framerate.hpp"
+#include "../bytecode_cache.hpp"
 
 /**
  * Module: SMC
@@ -64,8 +65,11 @@ static mrb_value Require(mrb_state* p_state, mrb_value self)
     p_context->lineno = 1;
     mrbc_filename(p_state, p_context, path_to_utf8(scriptfile.filename()).c_str());
 
-    // Compile and run the MRuby code
-    mrb_load_nstring_cxt(p_state, code.c_str(), code.length(), p_context);
+    // Compile and run the MRuby code, or the cached bytecode
+    if (Scripting::pMRuby_Bytecode_Cache)
+        Scripting::pMRuby_Bytecode_Cache->Load_Code(p_state, code, p_context, path_to_utf8(scriptfile));
+    else
+        mrb_load_nstring_cxt(p_state, code.c_str(), code.length(), p_context);
 
     // Check for exceptions
     if (p_state->exc)
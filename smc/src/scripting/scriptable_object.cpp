@@ -5,7 +5,7 @@ using namespace SMC::Scripting;
 
 cScriptable_Object::cScriptable_Object()
 {
-    //
+    m_event_mask = 0;
 }
 
 cScriptable_Object::~cScriptable_Object()
@@ -13,6 +13,25 @@ cScriptable_Object::~cScriptable_Object()
     clear_event_handlers();
 }
 
+/**
+ * Return the ID of the given event name. Each distinct name gets
+ * a small ID on its first use, so events can be looked up by index
+ * and tested against the per-object event bitmask instead of comparing
+ * strings every time an event is fired.
+ */
+unsigned int cScriptable_Object::intern_event_name(const std::string& evtname)
+{
+    static std::map<std::string, unsigned int> s_event_ids;
+
+    std::map<std::string, unsigned int>::const_iterator iter = s_event_ids.find(evtname);
+    if (iter != s_event_ids.end())
+        return iter->second;
+
+    unsigned int evtid = s_event_ids.size();
+    s_event_ids[evtname] = evtid;
+    return evtid;
+}
+
 /**
  * Clear all event handlers for all events. This is necessary when
  * you wipe out the mruby interpreter and set up a new one, as does
@@ -28,6 +47,7 @@ cScriptable_Object::~cScriptable_Object()
 void cScriptable_Object::clear_event_handlers()
 {
     m_callbacks.clear();
+    m_event_mask = 0;
 }
 
 /**
@@ -43,31 +63,44 @@ void cScriptable_Object::clear_event_handlers()
  */
 void cScriptable_Object::register_event_handler(const std::string& evtname, mrb_value callback)
 {
-    m_callbacks[evtname].push_back(callback);
+    unsigned int evtid = intern_event_name(evtname);
+
+    if (evtid >= m_callbacks.size())
+        m_callbacks.resize(evtid + 1);
+
+    m_callbacks[evtid].push_back(callback);
+    m_event_mask |= event_bit(evtid);
 }
 
 /**
  * Start iterator for the list of callbacks registered for the
- * given event name.
+ * given event ID. Must only be called if has_event_handler()
+ * returns true for the ID.
  *
- * \param evtname Name of the event you want the handlers for.
+ * \param evtid Interned ID of the event you want the handlers for.
  *
  * \returns Iterator pointing to the first callback.
  */
-std::vector<mrb_value>::iterator cScriptable_Object::event_handlers_begin(const std::string& evtname)
+std::vector<mrb_value>::iterator cScriptable_Object::event_handlers_begin(unsigned int evtid)
 {
-    return m_callbacks[evtname].begin();
+    if (evtid >= m_callbacks.size())
+        m_callbacks.resize(evtid + 1);
+
+    return m_callbacks[evtid].begin();
 }
 
 /**
  * Stop iterator for the list of callbacks registered for the
- * given event name.
+ * given event ID.
  *
- * \param evtname Name of the event you want the handlers for.
+ * \param evtid Interned ID of the event you want the handlers for.
  *
  * \returns Iterator pointing post the last callback (termination iterator).
  */
-std::vector<mrb_value>::iterator cScriptable_Object::event_handlers_end(const std::string& evtname)
+std::vector<mrb_value>::iterator cScriptable_Object::event_handlers_end(unsigned int evtid)
 {
-    return m_callbacks[evtname].end();
+    if (evtid >= m_callbacks.size())
+        m_callbacks.resize(evtid + 1);
+
+    return m_callbacks[evtid].end();
 }
@@ -15,15 +15,38 @@ namespace SMC {
             cScriptable_Object();
             virtual ~cScriptable_Object();
 
+            static unsigned int intern_event_name(const std::string& evtname);
+
             void clear_event_handlers();
             void register_event_handler(const std::string& evtname, mrb_value callback);
-            std::vector<mrb_value>::iterator event_handlers_begin(const std::string& evtname);
-            std::vector<mrb_value>::iterator event_handlers_end(const std::string& evtname);
+            std::vector<mrb_value>::iterator event_handlers_begin(unsigned int evtid);
+            std::vector<mrb_value>::iterator event_handlers_end(unsigned int evtid);
+
+            /// True if any event handler is registered.
+            inline bool has_event_handlers() const
+            {
+                return m_event_mask != 0;
+            }
+            /// True if an event handler may be registered for the event ID.
+            inline bool has_event_handler(unsigned int evtid) const
+            {
+                return (m_event_mask & event_bit(evtid)) != 0;
+            }
 
         protected:
-            /// Mapping of event names and registered callbacks.
-            std::map<std::string, std::vector<mrb_value> > m_callbacks;
+            /// Bit of the event ID in m_event_mask. IDs beyond the
+            /// mask share the last bit.
+            static inline Uint64 event_bit(unsigned int evtid)
+            {
+                return static_cast<Uint64>(1) << (evtid < 63 ? evtid : 63);
+            }
+
+            /// Registered callbacks indexed by interned event ID.
+            std::vector<std::vector<mrb_value> > m_callbacks;
+            /// Bitmask of the event IDs with registered callbacks.
+            Uint64 m_event_mask;
         };
     };
 };
+
 #endif
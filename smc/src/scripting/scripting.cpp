@@ -4,6 +4,7 @@
 #include "../core/sprite_manager.hpp"
 #include "../core/property_helper.hpp"
 #include "../core/filesystem/resource_manager.hpp"
+#include "bytecode_cache.hpp"
 
 #include "objects/mrb_smc.hpp"
 #include "objects/mrb_eventable.hpp"
@@ -115,12 +116,16 @@ cLevel* cMRuby_Interpreter::Get_Level()
     return mp_level;
 }
 
-mrb_value cMRuby_Interpreter::Run_Code_In_Context(const std::string& code, mrbc_context* p_context)
+mrb_value cMRuby_Interpreter::Run_Code_In_Context(const std::string& code, mrbc_context* p_context, const std::string& source /* = "" */)
 {
+    // Reuse the compiled bytecode of scripts run before
+    if (pMRuby_Bytecode_Cache)
+        return pMRuby_Bytecode_Cache->Load_Code(mp_mruby, code, p_context, source);
+
     return mrb_load_nstring_cxt(mp_mruby, code.c_str(), code.length(), p_context);
 }
 
-bool cMRuby_Interpreter::Run_Code(const std::string& code, const std::string& contextname)
+bool cMRuby_Interpreter::Run_Code(const std::string& code, const std::string& contextname, const std::string& source /* = "" */)
 {
     // Create a new context. This is important so we
     // can properly retrieve exceptions, which mrb_load_string()
@@ -130,7 +135,7 @@ bool cMRuby_Interpreter::Run_Code(const std::string& code, const std::string& co
     p_context->lineno = 1;
     mrbc_filename(mp_mruby, p_context, contextname.c_str()); // Set context filename (for exceptions)
 
-    Run_Code_In_Context(code, p_context);
+    Run_Code_In_Context(code, p_context, source);
 
     bool result;
     if (mp_mruby->exc) {
@@ -163,7 +168,7 @@ bool cMRuby_Interpreter::Run_File(const boost::filesystem::path& filepath)
     file.close();
 
     // Compile & execute it.
-    return Run_Code(code, path_to_utf8(filepath.filename()).c_str());
+    return Run_Code(code, path_to_utf8(filepath.filename()).c_str(), path_to_utf8(filepath));
 }
 
 void cMRuby_Interpreter::Load_Scripts()
@@ -206,6 +211,7 @@ void cMRuby_Interpreter::Evaluate_Timer_Callbacks()
     // and evaluate each one
     std::vector<mrb_value>::iterator iter;
     for (iter = m_callbacks.begin(); iter != m_callbacks.end(); iter++) {
+        pPerf_Counters->Add(PERF_COUNT_SCRIPT_CALLBACKS);
         mrb_funcall(mp_mruby, *iter, "call", 0);
         if (mp_mruby->exc) {
             cerr << "Warning: Error running timer callback: " << endl;
@@ -54,8 +54,10 @@ namespace SMC {
             // (including syntax errors), false is returned,
             // true otherwise. `contextname' is purely informational
             // and only ever used in exception messages.
+            // `source' identifies the code in the bytecode cache,
+            // e.g. its file path. If empty `contextname' is used.
             // This method prints exceptions to standard error.
-            bool Run_Code(const std::string& code, const std::string& contextname);
+            bool Run_Code(const std::string& code, const std::string& contextname, const std::string& source = "");
             // Execute MRuby code found in a file, using the filename
             // as the context name. Otherwise has the same
             // semantics as Run_Code().
@@ -63,8 +65,9 @@ namespace SMC {
             // Execute MRuby code in the given parsing context.
             // This method only does raw code execution, no
             // exception inspection is done for you. It’s basically
-            // a wrapper around mrb_load_nstring_cxt().
-            mrb_value Run_Code_In_Context(const std::string& code, mrbc_context* p_context);
+            // a wrapper around mrb_load_nstring_cxt() that uses
+            // the bytecode cache.
+            mrb_value Run_Code_In_Context(const std::string& code, mrbc_context* p_context, const std::string& source = "");
             // Registers an MRuby callback to be called on the next
             // call to Evaluate_Timer_Callbacks(). `callback'
             // is an MRuby proc.
@@ -56,6 +56,7 @@ const Uint8 cPreferences::m_video_screen_bpp_default = 32;
 */
 const bool cPreferences::m_video_vsync_default = 0;
 const Uint16 cPreferences::m_video_fps_limit_default = 240;
+const bool cPreferences::m_video_render_thread_default = 0;
 // default geometry detail is medium
 const float cPreferences::m_geometry_quality_default = 0.5f;
 // default texture detail is high
@@ -64,6 +65,7 @@ const float cPreferences::m_texture_quality_default = 0.75f;
 const bool cPreferences::m_audio_music_default = 1;
 const bool cPreferences::m_audio_sound_default = 1;
 const unsigned int cPreferences::m_audio_hz_default = 44100;
+const unsigned int cPreferences::m_audio_sound_cache_size_default = 0;
 const Uint8 cPreferences::m_sound_volume_default = 100;
 const Uint8 cPreferences::m_music_volume_default = 80;
 // Keyboard
@@ -161,6 +163,7 @@ void cPreferences::Save(void)
     Add_Property(p_root, "video_screen_bpp", static_cast<int>(m_video_screen_bpp));
     Add_Property(p_root, "video_vsync", m_video_vsync);
     Add_Property(p_root, "video_fps_limit", m_video_fps_limit);
+    Add_Property(p_root, "video_render_thread", m_video_render_thread);
     Add_Property(p_root, "video_geometry_quality", pVideo->m_geometry_quality);
     Add_Property(p_root, "video_texture_quality", pVideo->m_texture_quality);
     // Audio
@@ -169,6 +172,7 @@ void cPreferences::Save(void)
     Add_Property(p_root, "audio_sound_volume", static_cast<int>(pAudio->m_sound_volume));
     Add_Property(p_root, "audio_music_volume", static_cast<int>(pAudio->m_music_volume));
     Add_Property(p_root, "audio_hz", m_audio_hz);
+    Add_Property(p_root, "audio_sound_cache_size", m_audio_sound_cache_size);
     // Keyboard
     Add_Property(p_root, "keyboard_key_up", m_key_up);
     Add_Property(p_root, "keyboard_key_down", m_key_down);
@@ -203,6 +207,7 @@ void cPreferences::Save(void)
     // Special
     Add_Property(p_root, "level_background_images", m_level_background_images);
     Add_Property(p_root, "image_cache_enabled", m_image_cache_enabled);
+    Add_Property(p_root, "script_cache_enabled", m_script_cache_enabled);
     // Editor
     Add_Property(p_root, "editor_mouse_auto_hide", m_editor_mouse_auto_hide);
     Add_Property(p_root, "editor_show_item_images", m_editor_show_item_images);
@@ -228,6 +233,7 @@ void cPreferences::Reset_All(void)
     // Special
     m_level_background_images = 1;
     m_image_cache_enabled = 1;
+    m_script_cache_enabled = 1;
 }
 
 void cPreferences::Reset_Game(void)
@@ -247,6 +253,7 @@ void cPreferences::Reset_Video(void)
     m_video_screen_bpp = m_video_screen_bpp_default;
     m_video_vsync = m_video_vsync_default;
     m_video_fps_limit = m_video_fps_limit_default;
+    m_video_render_thread = m_video_render_thread_default;
     m_video_fullscreen = m_video_fullscreen_default;
     pVideo->m_geometry_quality = m_geometry_quality_default;
     pVideo->m_texture_quality = m_texture_quality_default;
@@ -258,6 +265,7 @@ void cPreferences::Reset_Audio(void)
     m_audio_music = m_audio_music_default;
     m_audio_sound = m_audio_sound_default;
     m_audio_hz = m_audio_hz_default;
+    m_audio_sound_cache_size = m_audio_sound_cache_size_default;
     pAudio->m_sound_volume = m_sound_volume_default;
     pAudio->m_music_volume = m_music_volume_default;
 }
@@ -76,6 +76,8 @@ namespace SMC {
         bool m_audio_music;
         bool m_audio_sound;
         unsigned int m_audio_hz;
+        // decoded sound cache memory budget in megabytes or 0 if unlimited
+        unsigned int m_audio_sound_cache_size;
 
         // Video
         bool m_video_fullscreen;
@@ -84,6 +86,8 @@ namespace SMC {
         Uint8 m_video_screen_bpp;
         bool m_video_vsync;
         Uint16 m_video_fps_limit;
+        // render the game in a thread while the next frame is updated (experimental)
+        bool m_video_render_thread;
 
         // Keyboard
         // key definitions
@@ -137,6 +141,8 @@ namespace SMC {
         bool m_level_background_images;
         // image cache enabled
         bool m_image_cache_enabled;
+        // compiled script cache enabled
+        bool m_script_cache_enabled;
 
         /* *** *** *** *** *** *** *** */
 
@@ -161,6 +167,7 @@ namespace SMC {
         static const bool m_audio_music_default;
         static const bool m_audio_sound_default;
         static const unsigned int m_audio_hz_default;
+        static const unsigned int m_audio_sound_cache_size_default;
         static const Uint8 m_sound_volume_default;
         static const Uint8 m_music_volume_default;
         // Video
@@ -170,6 +177,7 @@ namespace SMC {
         static const Uint8 m_video_screen_bpp_default;
         static const bool m_video_vsync_default;
         static const Uint16 m_video_fps_limit_default;
+        static const bool m_video_render_thread_default;
         static const float m_geometry_quality_default;
         static const float m_texture_quality_default;
         // Keyboard
@@ -147,6 +147,8 @@ void cPreferencesLoader::handle_property(const std::string& name, const std::str
         mp_preferences->m_video_vsync = string_to_bool(value);
     else if (name == "video_fps_limit")
         mp_preferences->m_video_fps_limit = string_to_int(value);
+    else if (name == "video_render_thread")
+        mp_preferences->m_video_render_thread = string_to_bool(value);
     else if (name == "video_fullscreen")
         mp_preferences->m_video_fullscreen = string_to_bool(value);
     else if (name == "video_geometry_detail" || name == "video_geometry_quality")
@@ -173,6 +175,11 @@ void cPreferencesLoader::handle_property(const std::string& name, const std::str
         if (val >= 0 && val <= 96000)
             mp_preferences->m_audio_hz = val;
     }
+    else if (name == "audio_sound_cache_size") {
+        val = string_to_int(value);
+        if (val >= 0 && val <= 2048)
+            mp_preferences->m_audio_sound_cache_size = val;
+    }
     //////////////////// Keyboard ////////////////////
     else if (name == "keyboard_key_up") {
         val = string_to_int(value);
@@ -313,6 +320,8 @@ void cPreferencesLoader::handle_property(const std::string& name, const std::str
         mp_preferences->m_level_background_images = string_to_bool(value);
     else if (name == "image_cache_enabled")
         mp_preferences->m_image_cache_enabled = string_to_bool(value);
+    else if (name == "script_cache_enabled")
+        mp_preferences->m_script_cache_enabled = string_to_bool(value);
     //////////////////// Editor ////////////////////
     else if (name == "editor_mouse_auto_hide")
         mp_preferences->m_editor_mouse_auto_hide = string_to_bool(value);
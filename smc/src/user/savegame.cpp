@@ -26,6 +26,7 @@
 #include "../core/filesystem/filesystem.hpp"
 #include "../core/filesystem/resource_manager.hpp"
 #include "../core/filesystem/package_manager.hpp"
+#include "../core/filesystem/xml_save_writer.hpp"
 #include "../scripting/events/level_load_event.hpp"
 #include "../scripting/events/level_save_event.hpp"
 #include "../core/global_basic.hpp"
@@ -231,10 +232,10 @@ std::string cSave::Get_Active_Level(void)
     return "";
 }
 
-void cSave::Write_To_File(fs::path filepath)
+xmlpp::Document* cSave::Create_Document(void)
 {
-    xmlpp::Document doc;
-    xmlpp::Element* p_root = doc.create_root_node("savegame");
+    xmlpp::Document* doc = new xmlpp::Document();
+    xmlpp::Element* p_root = doc->create_root_node("savegame");
     xmlpp::Element* p_node = NULL;
 
     // <information>
@@ -355,8 +356,23 @@ void cSave::Write_To_File(fs::path filepath)
         // </overworld>
     }
 
+    return doc;
+}
+
+void cSave::Write_To_File(fs::path filepath)
+{
+    xmlpp::Document* doc = Create_Document();
+
     // Write to file (raises xmlpp::exception on error)
-    doc.write_to_file_formatted(Glib::filename_from_utf8(path_to_utf8(filepath)));
+    try {
+        doc->write_to_file_formatted(Glib::filename_from_utf8(path_to_utf8(filepath)));
+    }
+    catch (xmlpp::exception&) {
+        delete doc;
+        throw;
+    }
+
+    delete doc;
     debug_print("Wrote savegame file '%s'.\n", path_to_utf8(filepath).c_str());
 }
 
@@ -747,18 +763,8 @@ bool cSavegame::Save_Game(unsigned int save_slot, std::string description)
     // remove old format savegame
     fs::remove(save_dir / utf8_to_path(int_to_string(save_slot) + ".save"));
 
-    try {
-        savegame->Write_To_File(filename);
-    }
-    catch (xmlpp::exception& e) {
-        cerr << "Failed to save savegame '" << filename << "': " << e.what() << endl
-             << "Is the file read-only?" << endl;
-        pHud_Debug->Set_Text(_("Couldn't save savegame ") + path_to_utf8(filename), speedfactor_fps * 5.0f);
-    }
-
-    if (pHud_Debug) {
-        pHud_Debug->Set_Text(_("Saved to Slot ") + int_to_string(save_slot));
-    }
+    // write in the background
+    pSave_Writer->Write(savegame->Create_Document(), filename, _("Saved to Slot ") + int_to_string(save_slot), _("Couldn't save savegame ") + path_to_utf8(filename));
 
     delete savegame;
 
@@ -767,6 +773,9 @@ bool cSavegame::Save_Game(unsigned int save_slot, std::string description)
 
 cSave* cSavegame::Load(unsigned int save_slot)
 {
+    // the slot may still be written
+    pSave_Writer->Wait();
+
     fs::path save_dir = pPackage_Manager->Get_User_Savegame_Path();
     fs::path filename = save_dir / utf8_to_path(int_to_string(save_slot) + ".smcsav");
 
@@ -840,6 +849,9 @@ std::string cSavegame::Get_Description(unsigned int save_slot, bool only_descrip
 
 bool cSavegame::Is_Valid(unsigned int save_slot) const
 {
+    // a new slot exists when written
+    pSave_Writer->Wait();
+
     fs::path save_dir = pPackage_Manager->Get_User_Savegame_Path();
     return (File_Exists(save_dir / utf8_to_path(int_to_string(save_slot) + ".smcsav")) || File_Exists(save_dir / utf8_to_path(int_to_string(save_slot) + ".save")));
 }
@@ -137,6 +137,11 @@ namespace SMC {
         // return the active level if available
         std::string Get_Active_Level(void);
 
+        /* Create the XML document of the savegame
+         * The document only contains copied values and can be written in another thread.
+         * The caller owns the document.
+        */
+        xmlpp::Document* Create_Document(void);
         // Write the savegame out to the given file; raises
         // xmlpp::exception on error.
         void Write_To_File(boost::filesystem::path filepath);
@@ -90,6 +90,11 @@ void cAnimation::Set_Fading_Speed(float speed)
 
 void cAnimation::Set_Pos_Z(float pos, float pos_rand /* = 0.0f */)
 {
+    // the editor picking order changes
+    if (editor_enabled && !Is_Float_Equal(m_pos_z, pos)) {
+        cSprite::m_editor_rect_change_count++;
+    }
+
     m_pos_z = pos;
     m_pos_z_rand = pos_rand;
 }
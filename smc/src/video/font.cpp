@@ -17,6 +17,7 @@
 #include "../video/gl_surface.hpp"
 #include "../core/property_helper.hpp"
 #include "../core/filesystem/resource_manager.hpp"
+#include "../core/perf_counters.hpp"
 #include "../core/global_basic.hpp"
 
 using namespace std;
@@ -114,6 +115,8 @@ void cFont_Manager::Delete_Ref(cGL_Surface* surface)
 
 cGL_Surface* cFont_Manager::Render_Text(TTF_Font* font, const std::string& text, const Color color)
 {
+    pPerf_Counters->Add(PERF_COUNT_RENDER_TEXT);
+
     // get SDL Color
     SDL_Color sdlcolor = color.Get_SDL_Color();
     // create text surface
@@ -68,8 +68,14 @@ cGL_Surface::cGL_Surface(void)
 cGL_Surface::~cGL_Surface(void)
 {
     // don't delete a managed OpenGL image if still in use by another managed cGL_Surface
-    if (m_auto_del_img && glIsTexture(m_image) && (!m_managed || !Is_Texture_Use_Multiple())) {
-        glDeleteTextures(1, &m_image);
+    if (m_auto_del_img && m_image && (!m_managed || !Is_Texture_Use_Multiple())) {
+        // deferred if the render thread is active
+        if (pVideo) {
+            pVideo->Delete_Texture(m_image);
+        }
+        else if (glIsTexture(m_image)) {
+            glDeleteTextures(1, &m_image);
+        }
     }
 
     if (destruction_function) {
@@ -159,6 +165,9 @@ void cGL_Surface::Save(const std::string& filename)
         return;
     }
 
+    // the render thread owns the context
+    pVideo->Render_Finish();
+
     // bind the texture
     glBindTexture(GL_TEXTURE_2D, m_image);
 
@@ -200,6 +209,9 @@ cSaved_Texture* cGL_Surface::Get_Software_Texture(bool only_filename /* = 0 */)
 
     // hardware texture to software texture
     if (!only_filename) {
+        // the render thread owns the context
+        pVideo->Render_Finish();
+
         // bind the texture
         glBindTexture(GL_TEXTURE_2D, m_image);
 
@@ -246,6 +258,9 @@ void cGL_Surface::Load_Software_Texture(cSaved_Texture* soft_tex)
 
     // software texture
     if (soft_tex->m_pixels) {
+        // the render thread owns the context
+        pVideo->Render_Finish();
+
         GLuint tex_id;
         glGenTextures(1, &tex_id);
 
@@ -15,6 +15,7 @@
 
 #include "../video/img_manager.hpp"
 #include "../video/renderer.hpp"
+#include "../video/video.hpp"
 #include "../core/i18n.hpp"
 #include "../core/global_basic.hpp"
 
@@ -107,6 +108,9 @@ cGL_Surface* cImage_Manager::Copy(const fs::path& path)
 
 void cImage_Manager::Grab_Textures(bool from_file /* = 0 */, bool draw_gui /* = 0 */)
 {
+    // the render thread owns the context
+    pVideo->Render_Finish();
+
     // progress bar
     CEGUI::ProgressBar* progress_bar = NULL;
 
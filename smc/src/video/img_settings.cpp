@@ -18,6 +18,8 @@
 #include "../core/math/utilities.hpp"
 #include "../core/math/size.hpp"
 #include "../core/filesystem/filesystem.hpp"
+#include "../core/filesystem/binary_file.hpp"
+#include "../core/filesystem/package_manager.hpp"
 #include "../core/global_basic.hpp"
 
 using namespace std;
@@ -235,29 +237,247 @@ void cImage_Settings_Data::Apply_Base(const cImage_Settings_Data* base_settings_
     }
 }
 
+/* *** *** *** *** *** *** cImage_Settings_Cache_Entry *** *** *** *** *** *** *** *** *** *** *** */
+
+// Return the last write time of the file or its package archive or 0 if it does not exist
+static std::time_t Get_Settings_File_Time(const fs::path& filename)
+{
+    return pPackage_Manager->Get_Resource_Write_Time(filename);
+}
+
+cImage_Settings_Cache_Entry::cImage_Settings_Cache_Entry(void)
+{
+    m_data = NULL;
+    m_verified = 0;
+}
+
+cImage_Settings_Cache_Entry::~cImage_Settings_Cache_Entry(void)
+{
+    if (m_data) {
+        delete m_data;
+        m_data = NULL;
+    }
+}
+
+bool cImage_Settings_Cache_Entry::Is_Up_To_Date(void) const
+{
+    for (unsigned int i = 0; i < m_files.size(); i++) {
+        if (Get_Settings_File_Time(m_files[i]) != m_file_times[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
 /* *** *** *** *** *** *** cImage_Settings_Parser *** *** *** *** *** *** *** *** *** *** *** */
 
+// compiled settings table file type and format version
+static const char* image_settings_cache_magic = "SMCIMGST";
+static const Uint32 image_settings_cache_version = 1;
+
 cImage_Settings_Parser::cImage_Settings_Parser(void)
     : cFile_parser()
 {
     m_settings_temp = NULL;
     m_load_base = 1;
+    m_cache_owner = NULL;
 }
 
 cImage_Settings_Parser::~cImage_Settings_Parser(void)
 {
-    //
+    Clear_Cache();
 }
 
 cImage_Settings_Data* cImage_Settings_Parser::Get(const boost::filesystem::path& filename, bool load_base_settings /* = 1 */)
 {
-    m_load_base = load_base_settings;
-    m_settings_temp = new cImage_Settings_Data();
+    const cImage_Settings_Cache_Entry* entry = Get_Entry(filename, load_base_settings);
 
-    Parse(filename);
-    cImage_Settings_Data* settings = m_settings_temp;
-    m_settings_temp = NULL;
-    return settings;
+    if (!entry) {
+        return new cImage_Settings_Data();
+    }
+
+    return new cImage_Settings_Data(*entry->m_data);
+}
+
+const cImage_Settings_Cache_Entry* cImage_Settings_Parser::Get_Entry(const boost::filesystem::path& filename, bool load_base_settings)
+{
+    const std::string key = (load_base_settings ? "1:" : "0:") + path_to_utf8(filename);
+
+    // already parsed
+    Settings_Cache_Map::iterator itr = m_cache.find(key);
+
+    if (itr != m_cache.end()) {
+        cImage_Settings_Cache_Entry* entry = itr->second;
+
+        if (entry->m_verified) {
+            return entry;
+        }
+
+        // loaded from the compiled table
+        if (entry->Is_Up_To_Date()) {
+            entry->m_verified = 1;
+            return entry;
+        }
+
+        // outdated
+        delete entry;
+        m_cache.erase(itr);
+    }
+
+    if (m_parsing.find(key) != m_parsing.end()) {
+        cerr << "Error : " << path_to_utf8(filename) << " has circular base settings" << endl;
+        return NULL;
+    }
+
+    m_parsing.insert(key);
+
+    // parse with a separate parser as base settings are resolved recursively through this cache
+    cImage_Settings_Parser parser;
+    parser.m_cache_owner = this;
+    parser.m_load_base = load_base_settings;
+    parser.m_settings_temp = new cImage_Settings_Data();
+    parser.m_files_temp.push_back(filename);
+    parser.Parse(filename);
+
+    m_parsing.erase(key);
+
+    cImage_Settings_Cache_Entry* entry = new cImage_Settings_Cache_Entry();
+    entry->m_data = parser.m_settings_temp;
+    entry->m_files = parser.m_files_temp;
+    entry->m_verified = 1;
+    parser.m_settings_temp = NULL;
+
+    for (vector<fs::path>::const_iterator file_itr = entry->m_files.begin(); file_itr != entry->m_files.end(); ++file_itr) {
+        entry->m_file_times.push_back(Get_Settings_File_Time(*file_itr));
+    }
+
+    m_cache[key] = entry;
+    return entry;
+}
+
+void cImage_Settings_Parser::Clear_Cache(void)
+{
+    for (Settings_Cache_Map::iterator itr = m_cache.begin(); itr != m_cache.end(); ++itr) {
+        delete itr->second;
+    }
+
+    m_cache.clear();
+}
+
+bool cImage_Settings_Parser::Load_Cache(const boost::filesystem::path& filename)
+{
+    if (!File_Exists(filename)) {
+        return 0;
+    }
+
+    cBinary_Reader reader(filename, image_settings_cache_magic, image_settings_cache_version);
+
+    // created by another game version
+    if (reader.Read_Uint32() != smc_version) {
+        return 0;
+    }
+
+    Uint32 count = reader.Read_Uint32();
+
+    for (Uint32 i = 0; i < count && reader.Is_Good(); i++) {
+        std::string key = reader.Read_String();
+        cImage_Settings_Cache_Entry* entry = new cImage_Settings_Cache_Entry();
+
+        // files
+        Uint32 file_count = reader.Read_Uint32();
+
+        for (Uint32 j = 0; j < file_count && reader.Is_Good(); j++) {
+            entry->m_files.push_back(utf8_to_path(reader.Read_String()));
+            entry->m_file_times.push_back(static_cast<std::time_t>(reader.Read_Uint64()));
+        }
+
+        // settings
+        cImage_Settings_Data* data = new cImage_Settings_Data();
+        entry->m_data = data;
+        data->m_base = utf8_to_path(reader.Read_String());
+        data->m_base_settings = reader.Read_Uint8() != 0;
+        data->m_int_x = reader.Read_Int32();
+        data->m_int_y = reader.Read_Int32();
+        data->m_col_rect.m_x = reader.Read_Float();
+        data->m_col_rect.m_y = reader.Read_Float();
+        data->m_col_rect.m_w = reader.Read_Float();
+        data->m_col_rect.m_h = reader.Read_Float();
+        data->m_width = reader.Read_Int32();
+        data->m_height = reader.Read_Int32();
+        data->m_rotation_x = reader.Read_Int32();
+        data->m_rotation_y = reader.Read_Int32();
+        data->m_rotation_z = reader.Read_Int32();
+        data->m_mipmap = reader.Read_Uint8() != 0;
+        data->m_editor_tags = reader.Read_String();
+        data->m_name = reader.Read_String();
+        data->m_massive_type = static_cast<MassiveType>(reader.Read_Int32());
+        data->m_ground_type = static_cast<GroundType>(reader.Read_Int32());
+        data->m_author = reader.Read_String();
+        data->m_obsolete = reader.Read_Uint8() != 0;
+
+        // keep already parsed settings
+        if (!reader.Is_Good() || m_cache.find(key) != m_cache.end()) {
+            delete entry;
+            continue;
+        }
+
+        m_cache[key] = entry;
+    }
+
+    if (!reader.Is_Good()) {
+        cerr << "Warning : Image settings cache " << path_to_utf8(filename) << " is invalid" << endl;
+        return 0;
+    }
+
+    return 1;
+}
+
+bool cImage_Settings_Parser::Save_Cache(const boost::filesystem::path& filename) const
+{
+    cBinary_Writer writer(filename, image_settings_cache_magic, image_settings_cache_version);
+
+    writer.Write_Uint32(smc_version);
+    writer.Write_Uint32(m_cache.size());
+
+    for (Settings_Cache_Map::const_iterator itr = m_cache.begin(); itr != m_cache.end(); ++itr) {
+        const cImage_Settings_Cache_Entry* entry = itr->second;
+        const cImage_Settings_Data* data = entry->m_data;
+
+        writer.Write_String(itr->first);
+
+        // files
+        writer.Write_Uint32(entry->m_files.size());
+
+        for (unsigned int i = 0; i < entry->m_files.size(); i++) {
+            writer.Write_String(path_to_utf8(entry->m_files[i]));
+            writer.Write_Uint64(static_cast<Uint64>(entry->m_file_times[i]));
+        }
+
+        // settings
+        writer.Write_String(path_to_utf8(data->m_base));
+        writer.Write_Uint8(data->m_base_settings);
+        writer.Write_Int32(data->m_int_x);
+        writer.Write_Int32(data->m_int_y);
+        writer.Write_Float(data->m_col_rect.m_x);
+        writer.Write_Float(data->m_col_rect.m_y);
+        writer.Write_Float(data->m_col_rect.m_w);
+        writer.Write_Float(data->m_col_rect.m_h);
+        writer.Write_Int32(data->m_width);
+        writer.Write_Int32(data->m_height);
+        writer.Write_Int32(data->m_rotation_x);
+        writer.Write_Int32(data->m_rotation_y);
+        writer.Write_Int32(data->m_rotation_z);
+        writer.Write_Uint8(data->m_mipmap);
+        writer.Write_String(data->m_editor_tags);
+        writer.Write_String(data->m_name);
+        writer.Write_Int32(data->m_massive_type);
+        writer.Write_Int32(data->m_ground_type);
+        writer.Write_String(data->m_author);
+        writer.Write_Uint8(data->m_obsolete);
+    }
+
+    return writer.Finish();
 }
 
 bool cImage_Settings_Parser::HandleMessage(const std::string* parts, unsigned int count, unsigned int line)
@@ -285,35 +505,39 @@ bool cImage_Settings_Parser::HandleMessage(const std::string* parts, unsigned in
             if (m_load_base) {
                 fs::path settings_file = data_file.parent_path() / m_settings_temp->m_base;
 
+                // base settings are parsed once and shared through the cache
+                cImage_Settings_Parser* cache_owner = m_cache_owner ? m_cache_owner : this;
+
                 // if settings file exists
                 while (!settings_file.empty()) {
                     // if not already image settings based
                     if (settings_file.extension() != utf8_to_path(".settings"))
                         settings_file.replace_extension(".settings");
 
+                    // a created base settings file also invalidates the cached settings
+                    m_files_temp.push_back(settings_file);
+
                     // not found
-                    if (!fs::exists(settings_file)) {
+                    if (!pPackage_Manager->Resource_Exists(settings_file)) {
                         break;
                     }
 
-                    // create new temporary parser
-                    cImage_Settings_Parser* temp_parser = new cImage_Settings_Parser();
-                    cImage_Settings_Data* base_settings = temp_parser->Get(settings_file);
-                    // finished loading base settings
-                    delete temp_parser;
+                    const cImage_Settings_Cache_Entry* base_entry = cache_owner->Get_Entry(settings_file, 1);
                     settings_file.clear();
 
                     // handle
-                    if (base_settings) {
+                    if (base_entry) {
+                        const cImage_Settings_Data* base_settings = base_entry->m_data;
+
                         // todo : apply settings in reverse order ( deepest settings should override first )
                         m_settings_temp->Apply_Base(base_settings);
+                        // the base settings files are dependencies as well
+                        m_files_temp.insert(m_files_temp.end(), base_entry->m_files.begin() + 1, base_entry->m_files.end());
 
                         // if also based on settings
                         if (!base_settings->m_base.empty() && base_settings->m_base_settings) {
                             settings_file = base_settings->m_base;
                         }
-
-                        delete base_settings;
                     }
                 }
             }
@@ -20,6 +20,7 @@
 #include "../core/file_parser.hpp"
 #include "../video/gl_surface.hpp"
 #include "../core/math/rect.hpp"
+#include <boost/unordered_map.hpp>
 
 namespace SMC {
 
@@ -70,8 +71,34 @@ namespace SMC {
         bool m_obsolete;
     };
 
+    /* *** *** *** *** *** *** cImage_Settings_Cache_Entry *** *** *** *** *** *** *** *** *** *** *** */
+
+// Parsed settings with the files they were created from
+    class cImage_Settings_Cache_Entry {
+    public:
+        cImage_Settings_Cache_Entry(void);
+        ~cImage_Settings_Cache_Entry(void);
+
+        // Return true if none of the files changed since parsing
+        bool Is_Up_To_Date(void) const;
+
+        // settings with the base settings applied
+        cImage_Settings_Data* m_data;
+        // settings file and all base settings files
+        vector<boost::filesystem::path> m_files;
+        // last write time of the files or 0 if it did not exist
+        vector<std::time_t> m_file_times;
+        // if set the files were checked since loading from the compiled cache
+        bool m_verified;
+    };
+
     /* *** *** *** *** *** *** cImage_Settings_Parser *** *** *** *** *** *** *** *** *** *** *** */
 
+    /* Parses image settings files
+     * Parsed settings are cached by path with the base settings chain already resolved.
+     * The cache can be saved as compiled table and loaded at the next start
+     * so settings files do not need to be parsed again.
+    */
     class cImage_Settings_Parser : public cFile_parser {
     public:
         cImage_Settings_Parser(void);
@@ -83,13 +110,38 @@ namespace SMC {
         */
         cImage_Settings_Data* Get(const boost::filesystem::path& filename, bool load_base_settings = 1);
 
+        // Remove all cached settings
+        void Clear_Cache(void);
+        /* Load a compiled settings table
+         * entries are checked against the settings file modification times on first use
+         * returns false if the file does not exist or is invalid
+        */
+        bool Load_Cache(const boost::filesystem::path& filename);
+        // Save all cached settings as compiled table
+        bool Save_Cache(const boost::filesystem::path& filename) const;
+
         // Handle one tokenized line
         virtual bool HandleMessage(const std::string* parts, unsigned int count, unsigned int line);
 
         // temp settings used for loading
         cImage_Settings_Data* m_settings_temp;
+        // files the temp settings were created from
+        vector<boost::filesystem::path> m_files_temp;
         // load base settings
         bool m_load_base;
+        // parser with the settings cache used to resolve base settings
+        cImage_Settings_Parser* m_cache_owner;
+
+    private:
+        /* Return the cached settings and parse them if needed
+         * returns NULL if the base settings are circular
+        */
+        const cImage_Settings_Cache_Entry* Get_Entry(const boost::filesystem::path& filename, bool load_base_settings);
+
+        typedef boost::unordered_map<std::string, cImage_Settings_Cache_Entry*> Settings_Cache_Map;
+        Settings_Cache_Map m_cache;
+        // settings currently being parsed to detect circular base settings
+        std::set<std::string> m_parsing;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -16,6 +16,8 @@
 #include "../video/renderer.hpp"
 #include "../core/game_core.hpp"
 #include "../core/global_basic.hpp"
+#include "../video/video.hpp"
+#include "../core/perf_counters.hpp"
 
 using namespace std;
 
@@ -27,6 +29,9 @@ namespace SMC {
 
 const float doubled_pi = static_cast<float>(M_PI * 2.0f);
 static GLuint last_bind_texture = 0;
+// camera position of the queue currently rendered
+static float render_camera_x = 0.0f;
+static float render_camera_y = 0.0f;
 
 /* *** *** *** *** *** *** cRender_Request *** *** *** *** *** *** *** *** *** *** *** */
 
@@ -189,7 +194,7 @@ void cLine_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        glTranslatef(-pActive_Camera->m_x, -pActive_Camera->m_y, m_pos_z);
+        glTranslatef(-render_camera_x, -render_camera_y, m_pos_z);
     }
     else {
         // only z position
@@ -276,8 +281,8 @@ void cRect_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        final_pos_x -= pActive_Camera->m_x;
-        final_pos_y -= pActive_Camera->m_y;
+        final_pos_x -= render_camera_x;
+        final_pos_y -= render_camera_y;
     }
 
     glTranslatef(final_pos_x, final_pos_y, m_pos_z);
@@ -365,7 +370,7 @@ void cGradient_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        glTranslatef(m_rect.m_x - pActive_Camera->m_x, m_rect.m_y - pActive_Camera->m_y, m_pos_z);
+        glTranslatef(m_rect.m_x - render_camera_x, m_rect.m_y - render_camera_y, m_pos_z);
     }
     // ignore camera position
     else {
@@ -431,7 +436,7 @@ void cCircle_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        glTranslatef(m_pos.m_x - pActive_Camera->m_x, m_pos.m_y - pActive_Camera->m_y, m_pos_z);
+        glTranslatef(m_pos.m_x - render_camera_x, m_pos.m_y - render_camera_y, m_pos_z);
     }
     // ignore camera position
     else {
@@ -513,6 +518,12 @@ cSurface_Request::cSurface_Request(void)
     m_w = 0.0f;
     m_h = 0.0f;
 
+    m_tex_start_x = 0.0f;
+    m_tex_start_y = 0.0f;
+    m_tex_end_x = 1.0f;
+    m_tex_end_y = 1.0f;
+    m_tex_repeat = 0;
+
     m_scale_x = 1.0f;
     m_scale_y = 1.0f;
     m_scale_z = 1.0f;
@@ -584,8 +595,8 @@ void cSurface_Request::Draw(void)
 
     // set camera position
     if (!m_no_camera) {
-        final_pos_x -= pActive_Camera->m_x;
-        final_pos_y -= pActive_Camera->m_y;
+        final_pos_x -= render_camera_x;
+        final_pos_y -= render_camera_y;
     }
 
     glTranslatef(final_pos_x, final_pos_y, m_pos_z);
@@ -610,6 +621,12 @@ void cSurface_Request::Draw(void)
     if (last_bind_texture != m_texture_id) {
         glBindTexture(GL_TEXTURE_2D, m_texture_id);
         last_bind_texture = m_texture_id;
+        pPerf_Counters->Add(PERF_COUNT_TEXTURE_BINDS);
+    }
+
+    if (m_tex_repeat) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     }
 
     /* vertex arrays should not be used to draw simple primitives as it
@@ -618,19 +635,25 @@ void cSurface_Request::Draw(void)
     // rectangle
     glBegin(GL_QUADS);
     // top left
-    glTexCoord2f(0.0f, 0.0f);
+    glTexCoord2f(m_tex_start_x, m_tex_start_y);
     glVertex2f(-half_w, -half_h);
     // top right
-    glTexCoord2f(1.0f, 0.0f);
+    glTexCoord2f(m_tex_end_x, m_tex_start_y);
     glVertex2f(half_w, -half_h);
     // bottom right
-    glTexCoord2f(1.0f, 1.0f);
+    glTexCoord2f(m_tex_end_x, m_tex_end_y);
     glVertex2f(half_w, half_h);
     // bottom left
-    glTexCoord2f(0.0f, 1.0f);
+    glTexCoord2f(m_tex_start_x, m_tex_end_y);
     glVertex2f(-half_w, half_h);
     glEnd();
 
+    // textures are created with clamped coordinates
+    if (m_tex_repeat) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
     // clear color
     if (m_color.red != 255 || m_color.green != 255 || m_color.blue != 255 || m_color.alpha != 255) {
         /* alpha is automatically 1 for glColor3f
@@ -643,11 +666,196 @@ void cSurface_Request::Draw(void)
     Render_Basic_Clear();
 }
 
+/* *** *** *** *** *** *** cRender_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+cRender_Command::cRender_Command(void)
+{
+
+}
+
+cRender_Command::~cRender_Command(void)
+{
+
+}
+
+/* *** *** *** *** *** *** cTexture_Upload_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+cTexture_Upload_Command::cTexture_Upload_Command(void)
+    : cRender_Command()
+{
+    m_texture_id = 0;
+    m_surface = NULL;
+    m_width = 0;
+    m_height = 0;
+    m_row_length = 0;
+    m_mipmap = 0;
+}
+
+cTexture_Upload_Command::~cTexture_Upload_Command(void)
+{
+    if (m_surface) {
+        SDL_FreeSurface(m_surface);
+        m_surface = NULL;
+    }
+}
+
+void cTexture_Upload_Command::Execute(void)
+{
+    // set SDL_image pixel store mode
+    if (m_row_length) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, m_row_length);
+    }
+
+    // use the generated texture
+    glBindTexture(GL_TEXTURE_2D, m_texture_id);
+    // the renderer may think a different texture is still bound
+    last_bind_texture = m_texture_id;
+    pPerf_Counters->Add(PERF_COUNT_TEXTURE_BINDS);
+
+    // set texture wrap modes which control how to interpret texture coordinates
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // set texture magnification function
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // upload to OpenGL texture
+    pVideo->Create_GL_Texture(m_width, m_height, m_surface->pixels, m_mipmap);
+
+    // unset pixel store mode
+    if (m_row_length) {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
+    // if debug build check for errors
+#ifdef _DEBUG
+    // glGetError only saves one error flag
+    GLenum error = glGetError();
+
+    if (error != GL_NO_ERROR) {
+        cerr << "CreateTexture : GL Error found : " << gluErrorString(error) << endl;
+    }
+#endif
+}
+
+/* *** *** *** *** *** *** cTexture_Delete_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+cTexture_Delete_Command::cTexture_Delete_Command(GLuint texture_id)
+    : cRender_Command()
+{
+    m_texture_id = texture_id;
+}
+
+cTexture_Delete_Command::~cTexture_Delete_Command(void)
+{
+
+}
+
+void cTexture_Delete_Command::Execute(void)
+{
+    if (glIsTexture(m_texture_id)) {
+        glDeleteTextures(1, &m_texture_id);
+    }
+}
+
+/* *** *** *** *** *** *** cRender_Command_Queue *** *** *** *** *** *** *** *** *** *** *** */
+
+// texture names kept ready for texture creation while the render thread is active
+static const unsigned int render_texture_name_pool_size = 64;
+
+cRender_Command_Queue::cRender_Command_Queue(void)
+{
+    m_texture_names.reserve(render_texture_name_pool_size);
+}
+
+cRender_Command_Queue::~cRender_Command_Queue(void)
+{
+    Clear();
+}
+
+void cRender_Command_Queue::Add(cRender_Command* command)
+{
+    if (!command) {
+        return;
+    }
+
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    m_commands.push_back(command);
+}
+
+void cRender_Command_Queue::Execute(void)
+{
+    RenderCommandList commands;
+
+    // take the commands so recording is not blocked while executing
+    {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        commands.swap(m_commands);
+    }
+
+    for (RenderCommandList::iterator itr = commands.begin(); itr != commands.end(); ++itr) {
+        cRender_Command* command = (*itr);
+
+        command->Execute();
+        delete command;
+    }
+}
+
+void cRender_Command_Queue::Clear(void)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    for (RenderCommandList::iterator itr = m_commands.begin(); itr != m_commands.end(); ++itr) {
+        delete *itr;
+    }
+
+    m_commands.clear();
+}
+
+bool cRender_Command_Queue::Get_Texture_Name(GLuint& texture_id)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    if (m_texture_names.empty()) {
+        return 0;
+    }
+
+    texture_id = m_texture_names.back();
+    m_texture_names.pop_back();
+    return 1;
+}
+
+void cRender_Command_Queue::Fill_Texture_Names(void)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    const unsigned int count = render_texture_name_pool_size - m_texture_names.size();
+
+    if (!count) {
+        return;
+    }
+
+    const unsigned int old_size = m_texture_names.size();
+    m_texture_names.resize(render_texture_name_pool_size);
+    glGenTextures(count, &m_texture_names[old_size]);
+}
+
+void cRender_Command_Queue::Delete_Texture_Names(void)
+{
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+
+    if (!m_texture_names.empty()) {
+        glDeleteTextures(m_texture_names.size(), &m_texture_names[0]);
+        m_texture_names.clear();
+    }
+}
+
 /* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
 
 cRenderQueue::cRenderQueue(unsigned int reserve_items)
 {
     m_render_data.reserve(reserve_items);
+    m_camera_set = 0;
+    m_camera_x = 0.0f;
+    m_camera_y = 0.0f;
 }
 
 cRenderQueue::~cRenderQueue(void)
@@ -668,12 +876,30 @@ void cRenderQueue::Add(cRender_Request* obj)
     }
 
     m_render_data.push_back(obj);
+    pPerf_Counters->Add(PERF_COUNT_RENDER_REQUESTS);
 }
 
 void cRenderQueue::Render(bool clear /* = 1 */)
 {
+    // camera position
+    if (m_camera_set) {
+        render_camera_x = m_camera_x;
+        render_camera_y = m_camera_y;
+        m_camera_set = 0;
+    }
+    else if (pActive_Camera) {
+        render_camera_x = pActive_Camera->m_x;
+        render_camera_y = pActive_Camera->m_y;
+    }
+
     // z position sort
-    std::sort(m_render_data.begin(), m_render_data.end(), zpos_sort());
+    m_zpos_sorter.Clear();
+
+    for (RenderList::const_iterator itr = m_render_data.begin(); itr != m_render_data.end(); ++itr) {
+        m_zpos_sorter.Add_Key(Float_To_Sort_Key((*itr)->m_pos_z));
+    }
+
+    m_zpos_sorter.Sort(m_render_data);
     // reset last texture
     last_bind_texture = 0;
 
@@ -718,6 +944,13 @@ void cRenderQueue::Clear(bool force /* = 1 */)
     }
 }
 
+void cRenderQueue::Set_Camera(float x, float y)
+{
+    m_camera_set = 1;
+    m_camera_x = x;
+    m_camera_y = y;
+}
+
 /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
 
 cRenderQueue* pRenderer = NULL;
@@ -19,6 +19,7 @@
 #include "../video/video.hpp"
 #include "../core/math/line.hpp"
 #include "../core/math/rect.hpp"
+#include "../core/math/radix_sort.hpp"
 
 namespace SMC {
 
@@ -211,6 +212,13 @@ namespace SMC {
         // size
         float m_w;
         float m_h;
+        // texture coordinates of the top left and bottom right corner
+        float m_tex_start_x;
+        float m_tex_start_y;
+        float m_tex_end_x;
+        float m_tex_end_y;
+        // repeat the texture for coordinates outside of 0 to 1
+        bool m_tex_repeat;
 
         // color
         Color m_color;
@@ -219,6 +227,90 @@ namespace SMC {
         bool m_delete_texture;
     };
 
+    /* *** *** *** *** *** *** cRender_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* OpenGL state change recorded on the main thread
+     * Executed in recording order by the thread owning the OpenGL context before the next frame is rendered.
+    */
+    class cRender_Command {
+    public:
+        cRender_Command(void);
+        virtual ~cRender_Command(void);
+
+        // execute with the current OpenGL context
+        virtual void Execute(void) = 0;
+    };
+
+    typedef vector<cRender_Command*> RenderCommandList;
+
+    /* *** *** *** *** *** *** cTexture_Upload_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+// Upload a software image into a reserved texture name
+    class cTexture_Upload_Command : public cRender_Command {
+    public:
+        cTexture_Upload_Command(void);
+        virtual ~cTexture_Upload_Command(void);
+
+        virtual void Execute(void);
+
+        // reserved texture name
+        GLuint m_texture_id;
+        // 32 bit source image which gets deleted with the command
+        SDL_Surface* m_surface;
+        // texture size
+        unsigned int m_width;
+        unsigned int m_height;
+        // if set the surface pixel rows are longer than the texture width
+        int m_row_length;
+        // create mipmaps
+        bool m_mipmap;
+    };
+
+    /* *** *** *** *** *** *** cTexture_Delete_Command *** *** *** *** *** *** *** *** *** *** *** */
+
+    class cTexture_Delete_Command : public cRender_Command {
+    public:
+        cTexture_Delete_Command(GLuint texture_id);
+        virtual ~cTexture_Delete_Command(void);
+
+        virtual void Execute(void);
+
+        GLuint m_texture_id;
+    };
+
+    /* *** *** *** *** *** *** cRender_Command_Queue *** *** *** *** *** *** *** *** *** *** *** */
+
+    /* Thread-safe queue of render commands
+     * Also keeps a pool of texture names generated by the context owning thread
+     * so textures can be created without waiting for the render thread.
+    */
+    class cRender_Command_Queue {
+    public:
+        cRender_Command_Queue(void);
+        ~cRender_Command_Queue(void);
+
+        // Add a command. The queue takes ownership.
+        void Add(cRender_Command* command);
+        // Execute and delete all commands. Needs the current OpenGL context.
+        void Execute(void);
+        // Delete all commands without executing them
+        void Clear(void);
+
+        /* Take a texture name from the pool
+         * returns false if the pool is empty
+        */
+        bool Get_Texture_Name(GLuint& texture_id);
+        // Fill the texture name pool. Needs the current OpenGL context.
+        void Fill_Texture_Names(void);
+        // Delete the unused texture names. Needs the current OpenGL context.
+        void Delete_Texture_Names(void);
+
+    private:
+        boost::mutex m_mutex;
+        RenderCommandList m_commands;
+        vector<GLuint> m_texture_names;
+    };
+
     /* *** *** *** *** *** *** cRenderQueue *** *** *** *** *** *** *** *** *** *** *** */
 
     class cRenderQueue {
@@ -246,16 +338,24 @@ namespace SMC {
         */
         void Clear(bool force = 1);
 
+        /* Set the camera position used for the next rendering
+         * Needed if the camera moves while the queue is rendered in the render thread.
+         * If not set the active camera position is used.
+        */
+        void Set_Camera(float x, float y);
+
         // render data array
         RenderList m_render_data;
 
-        // Z position sort
-        struct zpos_sort {
-            bool operator()(const cRender_Request* a, const cRender_Request* b) const
-            {
-                return a->m_pos_z < b->m_pos_z;
-            }
-        };
+        // camera position snapshot
+        bool m_camera_set;
+        float m_camera_x;
+        float m_camera_y;
+
+        /* Z position sort
+         * Stable so requests with the same z position are drawn in the order they were added.
+        */
+        cRadix_Sorter<cRender_Request*> m_zpos_sorter;
     };
 
     /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
@@ -0,0 +1,484 @@
+/***************************************************************************
+ * resample.cpp  -  Image resampling
+ *
+ * Copyright © 2005 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../video/resample.hpp"
+#include "../core/math/utilities.hpp"
+
+#include <cstring>
+
+/* SSE2 and AVX2 paths are compiled with function target attributes so the
+ * rest of the game does not need to be built with special instruction set flags.
+ * The AVX2 path is only used if the cpu supports it at runtime.
+*/
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SMC_RESAMPLE_X86 1
+#define SMC_TARGET_SSE2 __attribute__((target("sse2")))
+#define SMC_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define SMC_RESAMPLE_X86 1
+#define SMC_TARGET_SSE2
+#define SMC_TARGET_AVX2
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace SMC {
+
+/* *** *** *** *** *** *** *** Filter contributions *** *** *** *** *** *** *** *** *** *** */
+
+/* Source pixels contributing to each destination pixel along one axis
+ * the weights of destination pixel i start at i * m_max_count
+*/
+class cResample_Contributions {
+public:
+    void Init(int src_size, int dst_size);
+
+    // first source pixel
+    vector<int> m_first;
+    // amount of source pixels
+    vector<int> m_count;
+    // weights normalized to 1
+    vector<float> m_weights;
+    // maximum source pixels of a destination pixel
+    int m_max_count;
+};
+
+void cResample_Contributions::Init(int src_size, int dst_size)
+{
+    const double scale = static_cast<double>(src_size) / static_cast<double>(dst_size);
+
+    // downscaling covers up to ceil( scale ) + 1 pixels and bilinear upscaling 2
+    m_max_count = scale > 1.0 ? static_cast<int>(ceil(scale)) + 1 : 2;
+
+    m_first.assign(dst_size, 0);
+    m_count.assign(dst_size, 0);
+    m_weights.assign(dst_size * m_max_count, 0.0f);
+
+    for (int i = 0; i < dst_size; i++) {
+        float* weights = &m_weights[i * m_max_count];
+        int first;
+        int count = 0;
+
+        // box filter over the covered source area
+        if (scale >= 1.0) {
+            const double start = i * scale;
+            const double end = Clamp<double>((i + 1) * scale, start, src_size);
+
+            first = static_cast<int>(floor(start));
+            int last = static_cast<int>(ceil(end)) - 1;
+
+            if (last >= src_size) {
+                last = src_size - 1;
+            }
+
+            for (int k = first; k <= last && count < m_max_count; k++) {
+                const double coverage = min<double>(end, k + 1) - max<double>(start, k);
+
+                weights[count] = static_cast<float>(coverage / scale);
+                count++;
+            }
+        }
+        // bilinear
+        else {
+            const double center = (i + 0.5) * scale - 0.5;
+            const int k = static_cast<int>(floor(center));
+            const float t = static_cast<float>(center - k);
+
+            if (k < 0) {
+                first = 0;
+                weights[0] = 1.0f;
+                count = 1;
+            }
+            else if (k >= src_size - 1) {
+                first = src_size - 1;
+                weights[0] = 1.0f;
+                count = 1;
+            }
+            else {
+                first = k;
+                weights[0] = 1.0f - t;
+                weights[1] = t;
+                count = 2;
+            }
+        }
+
+        // normalize to avoid brightness drift from rounding errors
+        float sum = 0.0f;
+
+        for (int k = 0; k < count; k++) {
+            sum += weights[k];
+        }
+
+        if (sum > 0.0f) {
+            for (int k = 0; k < count; k++) {
+                weights[k] /= sum;
+            }
+        }
+
+        m_first[i] = first;
+        m_count[i] = count;
+    }
+}
+
+/* *** *** *** *** *** *** *** Row kernels *** *** *** *** *** *** *** *** *** *** */
+
+/* Vertical pass
+ * adds the source byte row multiplied with weight to the float row
+*/
+typedef void (*Resample_Vertical_Func)(float* row, const unsigned char* src, int length, float weight);
+/* Horizontal pass
+ * filters the float row into the destination byte row
+*/
+typedef void (*Resample_Horizontal_Func)(const float* row, unsigned char* dst, int dst_width, int channels, const cResample_Contributions& contrib);
+
+static void Resample_Vertical_Scalar(float* row, const unsigned char* src, int length, float weight)
+{
+    for (int x = 0; x < length; x++) {
+        row[x] += weight * src[x];
+    }
+}
+
+static void Resample_Horizontal_Scalar(const float* row, unsigned char* dst, int dst_width, int channels, const cResample_Contributions& contrib)
+{
+    for (int i = 0; i < dst_width; i++) {
+        const float* weights = &contrib.m_weights[i * contrib.m_max_count];
+        const float* src = row + contrib.m_first[i] * channels;
+        const int count = contrib.m_count[i];
+
+        for (int c = 0; c < channels; c++) {
+            float sum = 0.5f;
+
+            for (int k = 0; k < count; k++) {
+                sum += weights[k] * src[k * channels + c];
+            }
+
+            dst[i * channels + c] = static_cast<unsigned char>(Clamp<int>(static_cast<int>(sum), 0, 255));
+        }
+    }
+}
+
+#ifdef SMC_RESAMPLE_X86
+
+SMC_TARGET_SSE2 static void Resample_Vertical_SSE2(float* row, const unsigned char* src, int length, float weight)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 w = _mm_set1_ps(weight);
+    int x = 0;
+
+    // 16 bytes per iteration
+    for (; x + 16 <= length; x += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+        const __m128i lo16 = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i hi16 = _mm_unpackhi_epi8(bytes, zero);
+
+        const __m128 f0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo16, zero));
+        const __m128 f1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo16, zero));
+        const __m128 f2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi16, zero));
+        const __m128 f3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi16, zero));
+
+        _mm_storeu_ps(row + x, _mm_add_ps(_mm_loadu_ps(row + x), _mm_mul_ps(f0, w)));
+        _mm_storeu_ps(row + x + 4, _mm_add_ps(_mm_loadu_ps(row + x + 4), _mm_mul_ps(f1, w)));
+        _mm_storeu_ps(row + x + 8, _mm_add_ps(_mm_loadu_ps(row + x + 8), _mm_mul_ps(f2, w)));
+        _mm_storeu_ps(row + x + 12, _mm_add_ps(_mm_loadu_ps(row + x + 12), _mm_mul_ps(f3, w)));
+    }
+
+    // remaining bytes
+    for (; x < length; x++) {
+        row[x] += weight * src[x];
+    }
+}
+
+// store one RGBA pixel with rounding and saturation
+SMC_TARGET_SSE2 static inline void Resample_Store_Pixel_SSE2(unsigned char* dst, __m128 pixel)
+{
+    const __m128i ints = _mm_cvtps_epi32(pixel);
+    const __m128i words = _mm_packs_epi32(ints, ints);
+    const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+
+    memcpy(dst, &packed, 4);
+}
+
+SMC_TARGET_SSE2 static void Resample_Horizontal_SSE2(const float* row, unsigned char* dst, int dst_width, int channels, const cResample_Contributions& contrib)
+{
+    // only RGBA pixels fit a register
+    if (channels != 4) {
+        Resample_Horizontal_Scalar(row, dst, dst_width, channels, contrib);
+        return;
+    }
+
+    for (int i = 0; i < dst_width; i++) {
+        const float* weights = &contrib.m_weights[i * contrib.m_max_count];
+        const float* src = row + contrib.m_first[i] * 4;
+        const int count = contrib.m_count[i];
+        __m128 sum = _mm_setzero_ps();
+
+        for (int k = 0; k < count; k++) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + k * 4), _mm_set1_ps(weights[k])));
+        }
+
+        Resample_Store_Pixel_SSE2(dst + i * 4, sum);
+    }
+}
+
+SMC_TARGET_AVX2 static void Resample_Vertical_AVX2(float* row, const unsigned char* src, int length, float weight)
+{
+    const __m256 w = _mm256_set1_ps(weight);
+    int x = 0;
+
+    // 16 bytes per iteration
+    for (; x + 16 <= length; x += 16) {
+        const __m256 f0 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + x))));
+        const __m256 f1 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + x + 8))));
+
+        _mm256_storeu_ps(row + x, _mm256_add_ps(_mm256_loadu_ps(row + x), _mm256_mul_ps(f0, w)));
+        _mm256_storeu_ps(row + x + 8, _mm256_add_ps(_mm256_loadu_ps(row + x + 8), _mm256_mul_ps(f1, w)));
+    }
+
+    // remaining bytes
+    for (; x < length; x++) {
+        row[x] += weight * src[x];
+    }
+}
+
+SMC_TARGET_AVX2 static void Resample_Horizontal_AVX2(const float* row, unsigned char* dst, int dst_width, int channels, const cResample_Contributions& contrib)
+{
+    // only RGBA pixels fit a register
+    if (channels != 4) {
+        Resample_Horizontal_Scalar(row, dst, dst_width, channels, contrib);
+        return;
+    }
+
+    for (int i = 0; i < dst_width; i++) {
+        const float* weights = &contrib.m_weights[i * contrib.m_max_count];
+        const float* src = row + contrib.m_first[i] * 4;
+        const int count = contrib.m_count[i];
+        __m256 sum2 = _mm256_setzero_ps();
+        int k = 0;
+
+        // two source pixels per iteration
+        for (; k + 2 <= count; k += 2) {
+            const __m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(weights[k])), _mm_set1_ps(weights[k + 1]), 1);
+
+            sum2 = _mm256_add_ps(sum2, _mm256_mul_ps(_mm256_loadu_ps(src + k * 4), w));
+        }
+
+        // combine both pixel halves
+        __m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum2), _mm256_extractf128_ps(sum2, 1));
+
+        // odd pixel
+        if (k < count) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + k * 4), _mm_set1_ps(weights[k])));
+        }
+
+        const __m128i ints = _mm_cvtps_epi32(sum);
+        const __m128i words = _mm_packs_epi32(ints, ints);
+        const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+
+        memcpy(dst + i * 4, &packed, 4);
+    }
+}
+
+// Return true if the cpu and the operating system support AVX2
+static bool Cpu_Has_AVX2(void)
+{
+#if defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    int info[4];
+    __cpuid(info, 0);
+
+    if (info[0] < 7) {
+        return 0;
+    }
+
+    __cpuid(info, 1);
+
+    // osxsave and avx
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) {
+        return 0;
+    }
+    // ymm state enabled by the operating system
+    if ((_xgetbv(0) & 6) != 6) {
+        return 0;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#endif
+}
+
+#endif // SMC_RESAMPLE_X86
+
+/* *** *** *** *** *** *** *** Resampling *** *** *** *** *** *** *** *** *** *** */
+
+Resample_Impl Get_Resample_Impl(Resample_Impl impl /* = RESAMPLE_IMPL_AUTO */)
+{
+#ifdef SMC_RESAMPLE_X86
+    static const bool has_avx2 = Cpu_Has_AVX2();
+
+    if (impl == RESAMPLE_IMPL_AUTO) {
+        return has_avx2 ? RESAMPLE_IMPL_AVX2 : RESAMPLE_IMPL_SSE2;
+    }
+    if (impl == RESAMPLE_IMPL_AVX2 && !has_avx2) {
+        return RESAMPLE_IMPL_SSE2;
+    }
+
+    return impl;
+#else
+    return RESAMPLE_IMPL_SCALAR;
+#endif
+}
+
+const char* Get_Resample_Impl_Name(Resample_Impl impl)
+{
+    switch (impl) {
+    case RESAMPLE_IMPL_SCALAR:
+        return "scalar";
+    case RESAMPLE_IMPL_SSE2:
+        return "sse2";
+    case RESAMPLE_IMPL_AVX2:
+        return "avx2";
+    default:
+        return "auto";
+    }
+}
+
+// A block of destination rows processed by one thread
+class cResample_Rows {
+public:
+    void operator()(void) const;
+
+    const unsigned char* m_orig;
+    int m_width;
+    int m_channels;
+    unsigned char* m_resampled;
+    int m_new_width;
+    int m_row_start;
+    int m_row_end;
+    const cResample_Contributions* m_contrib_x;
+    const cResample_Contributions* m_contrib_y;
+    Resample_Vertical_Func m_vertical;
+    Resample_Horizontal_Func m_horizontal;
+};
+
+void cResample_Rows::operator()(void) const
+{
+    const int row_length = m_width * m_channels;
+    vector<float> row(row_length);
+
+    for (int j = m_row_start; j < m_row_end; j++) {
+        const float* weights = &m_contrib_y->m_weights[j * m_contrib_y->m_max_count];
+        const int first = m_contrib_y->m_first[j];
+        const int count = m_contrib_y->m_count[j];
+
+        // filter the source rows into one float row
+        memset(&row[0], 0, row_length * sizeof(float));
+
+        for (int k = 0; k < count; k++) {
+            m_vertical(&row[0], m_orig + (first + k) * row_length, row_length, weights[k]);
+        }
+
+        // filter the float row to the destination
+        m_horizontal(&row[0], m_resampled + j * m_new_width * m_channels, m_new_width, m_channels, *m_contrib_x);
+    }
+}
+
+bool Resample_Image(const unsigned char* orig, int width, int height, int channels, unsigned char* resampled, int new_width, int new_height, Resample_Impl impl /* = RESAMPLE_IMPL_AUTO */, unsigned int threads /* = 0 */)
+{
+    // error check
+    if (width <= 0 || height <= 0 || channels <= 0 || new_width <= 0 || new_height <= 0 || orig == NULL || resampled == NULL) {
+        // invalid argument
+        return 0;
+    }
+
+    cResample_Contributions contrib_x;
+    cResample_Contributions contrib_y;
+    contrib_x.Init(width, new_width);
+    contrib_y.Init(height, new_height);
+
+    cResample_Rows rows;
+    rows.m_orig = orig;
+    rows.m_width = width;
+    rows.m_channels = channels;
+    rows.m_resampled = resampled;
+    rows.m_new_width = new_width;
+    rows.m_row_start = 0;
+    rows.m_row_end = new_height;
+    rows.m_contrib_x = &contrib_x;
+    rows.m_contrib_y = &contrib_y;
+    rows.m_vertical = Resample_Vertical_Scalar;
+    rows.m_horizontal = Resample_Horizontal_Scalar;
+
+#ifdef SMC_RESAMPLE_X86
+    impl = Get_Resample_Impl(impl);
+
+    if (impl == RESAMPLE_IMPL_AVX2) {
+        rows.m_vertical = Resample_Vertical_AVX2;
+        rows.m_horizontal = Resample_Horizontal_AVX2;
+    }
+    else if (impl == RESAMPLE_IMPL_SSE2) {
+        rows.m_vertical = Resample_Vertical_SSE2;
+        rows.m_horizontal = Resample_Horizontal_SSE2;
+    }
+#endif
+
+    // auto select thread count
+    if (!threads) {
+        // small images are faster without thread startup overhead
+        if (static_cast<long>(width) * height < 512 * 512) {
+            threads = 1;
+        }
+        else {
+            threads = Clamp<unsigned int>(boost::thread::hardware_concurrency(), 1, 8);
+        }
+    }
+    // at least one row per thread
+    if (threads > static_cast<unsigned int>(new_height)) {
+        threads = new_height;
+    }
+
+    if (threads <= 1) {
+        rows();
+        return 1;
+    }
+
+    // split rows across threads and process the last block in this thread
+    boost::thread_group thread_group;
+    const int rows_per_thread = (new_height + threads - 1) / threads;
+
+    for (int start = 0; start < new_height; start += rows_per_thread) {
+        cResample_Rows block = rows;
+        block.m_row_start = start;
+        block.m_row_end = min(start + rows_per_thread, new_height);
+
+        if (block.m_row_end >= new_height) {
+            block();
+        }
+        else {
+            thread_group.create_thread(block);
+        }
+    }
+
+    thread_group.join_all();
+    return 1;
+}
+
+/* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
@@ -0,0 +1,56 @@
+/***************************************************************************
+ * resample.h
+ *
+ * Copyright © 2005 - 2011 The SMC Contributors
+ ***************************************************************************/
+/*
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 3 of the License, or
+   (at your option) any later version.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SMC_RESAMPLE_HPP
+#define SMC_RESAMPLE_HPP
+
+#include "../core/global_basic.hpp"
+
+namespace SMC {
+
+    /* *** *** *** *** *** *** *** Resample implementation *** *** *** *** *** *** *** *** *** *** */
+
+    enum Resample_Impl {
+        // use the fastest implementation supported by the cpu
+        RESAMPLE_IMPL_AUTO = 0,
+        // plain C++
+        RESAMPLE_IMPL_SCALAR = 1,
+        // SSE2 ( always available on x86_64 )
+        RESAMPLE_IMPL_SSE2 = 2,
+        // AVX2 ( detected at runtime )
+        RESAMPLE_IMPL_AVX2 = 3
+    };
+
+    /* Resample an image to the given size
+     * Downscaling uses an area-averaging box filter which weights partially covered source pixels
+     * so any ratio is supported. Upscaling uses a bilinear filter.
+     * orig : source pixels with a row length of width * channels bytes
+     * resampled : destination buffer with at least new_width * new_height * channels bytes
+     * impl : force an implementation. Falls back to the next supported one if not available.
+     * threads : number of threads the rows are split across. If 0 it is selected from the image size and core count.
+     * returns false on invalid arguments
+    */
+    bool Resample_Image(const unsigned char* orig, int width, int height, int channels, unsigned char* resampled, int new_width, int new_height, Resample_Impl impl = RESAMPLE_IMPL_AUTO, unsigned int threads = 0);
+
+    // Return the implementation used for the given request after checking cpu support
+    Resample_Impl Get_Resample_Impl(Resample_Impl impl = RESAMPLE_IMPL_AUTO);
+    // Return the implementation name
+    const char* Get_Resample_Impl_Name(Resample_Impl impl);
+
+    /* *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** *** */
+
+} // namespace SMC
+
+#endif
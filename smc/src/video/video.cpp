@@ -22,8 +22,10 @@
 #include "../video/img_settings.hpp"
 #include "../input/mouse.hpp"
 #include "../video/renderer.hpp"
+#include "../video/resample.hpp"
 #include "../core/main.hpp"
 #include "../core/math/utilities.hpp"
+#include "../core/job_system.hpp"
 #include "../core/i18n.hpp"
 #include "../core/math/size.hpp"
 #include "../core/filesystem/filesystem.hpp"
@@ -38,6 +40,64 @@ namespace fs = boost::filesystem;
 
 namespace SMC {
 
+// Load the image from a package archive or the disk
+static SDL_Surface* Load_SDL_Surface(const fs::path& filename)
+{
+    SDL_RWops* rw = pPackage_Manager->Open_Resource_RW(filename);
+
+    if (!rw) {
+        return NULL;
+    }
+
+    // closes the read operation
+    return IMG_Load_RW(rw, 1);
+}
+
+/* *** *** *** *** *** *** *** cImage_Cache_Job *** *** *** *** *** *** *** *** *** *** */
+
+// Downsamples an image and saves it into the image cache
+class cImage_Cache_Job : public cJob {
+public:
+    // takes ownership of the surface
+    cImage_Cache_Job(SDL_Surface* surface, const fs::path& filename, int width, int height)
+        : cJob("image cache", JOB_PRIORITY_HIGH)
+    {
+        m_surface = surface;
+        m_filename = filename;
+        m_width = width;
+        m_height = height;
+    }
+
+    virtual ~cImage_Cache_Job(void)
+    {
+        if (m_surface) {
+            SDL_FreeSurface(m_surface);
+        }
+    }
+
+    virtual void Run(void)
+    {
+        const unsigned int image_bpp = m_surface->format->BytesPerPixel;
+        unsigned char* image_downsampled = new unsigned char[m_width * m_height * image_bpp];
+
+        // the other workers process other images
+        if (Resample_Image(static_cast<unsigned char*>(m_surface->pixels), m_surface->w, m_surface->h, image_bpp, image_downsampled, m_width, m_height, RESAMPLE_IMPL_AUTO, 1)) {
+            pVideo->Save_Surface(m_filename, image_downsampled, m_width, m_height, image_bpp);
+        }
+
+        delete[] image_downsampled;
+
+        SDL_FreeSurface(m_surface);
+        m_surface = NULL;
+    }
+
+private:
+    SDL_Surface* m_surface;
+    fs::path m_filename;
+    int m_width;
+    int m_height;
+};
+
 /* *** *** *** *** *** *** *** Video class *** *** *** *** *** *** *** *** *** *** */
 
 cVideo::cVideo(void)
@@ -63,15 +123,36 @@ cVideo::cVideo(void)
     glx_context = NULL;
 #endif
     m_render_thread = boost::thread();
+    m_render_commands = new cRender_Command_Queue();
 
     m_initialised = 0;
+
+    m_render_pending = 0;
+    m_render_thread_exit = 0;
+    m_render_thread_active = 0;
 }
 
 cVideo::~cVideo(void)
 {
+    Render_Thread_Exit();
+
+    delete m_render_commands;
+}
+
+/* *** *** *** *** *** *** *** cCEGUI_Resource_Provider *** *** *** *** *** *** *** *** *** *** */
+
+void cCEGUI_Resource_Provider::loadRawDataContainer(const CEGUI::String& filename, CEGUI::RawDataContainer& output, const CEGUI::String& resourceGroup)
+{
+    // the render thread owns the context
+    if (pVideo) {
+        pVideo->Render_Finish();
+    }
 
+    CEGUI::DefaultResourceProvider::loadRawDataContainer(filename, output, resourceGroup);
 }
 
+/* *** *** *** *** *** *** *** cVideo *** *** *** *** *** *** *** *** *** *** */
+
 void cVideo::Init_CEGUI(void) const
 {
     // create renderer
@@ -87,7 +168,7 @@ void cVideo::Init_CEGUI(void) const
     pGuiRenderer->enableExtraStateSettings(1);
 
     // create Resource Provider
-    CEGUI::DefaultResourceProvider* rp = new CEGUI::DefaultResourceProvider();
+    CEGUI::DefaultResourceProvider* rp = new cCEGUI_Resource_Provider();
 
     // set Resource Provider directories
     rp->setResourceGroupDirectory("schemes", path_to_utf8(pResource_Manager->Get_Gui_Scheme_Directory()));
@@ -330,6 +411,8 @@ void cVideo::Init_Video(bool reload_textures_from_file /* = 0 */, bool use_prefe
         pImage_Manager->Grab_Textures(reload_textures_from_file, cegui_initialized);
         pFont->Grab_Textures();
         pGuiRenderer->grabTextures();
+        Render_Finish();
+        m_render_commands->Delete_Texture_Names();
         pImage_Manager->Delete_Hardware_Textures();
 
         // exit loading screen
@@ -669,6 +752,7 @@ void cVideo::Init_Image_Cache(bool recreate /* = 0 */, bool draw_gui /* = 0 */)
 
     unsigned int loaded_files = 0;
     unsigned int file_count = image_files.size();
+    vector<Job_ID> cache_jobs;
 
     // create directories, load images and save to cache
     for (vector<fs::path>::iterator itr = image_files.begin(); itr != image_files.end(); ++itr) {
@@ -737,29 +821,19 @@ void cVideo::Init_Image_Cache(bool recreate /* = 0 */, bool draw_gui /* = 0 */)
             continue;
         }
 
-        // calculate block reduction
-        int reduce_block_x = sdl_surface->w / new_width;
-        int reduce_block_y = sdl_surface->h / new_height;
-
-        // create downsampled image
-        unsigned int image_bpp = sdl_surface->format->BytesPerPixel;
-        unsigned char* image_downsampled = new unsigned char[new_width * new_height * image_bpp];
-        bool downsampled = Downscale_Image(static_cast<unsigned char*>(sdl_surface->pixels), sdl_surface->w, sdl_surface->h, image_bpp, image_downsampled, reduce_block_x, reduce_block_y);
-
-        SDL_FreeSurface(sdl_surface);
-
-        // if image is available
-        if (downsampled) {
-            // save as png
-            if (settings_file) {
-                cache_filename.replace_extension(".png");
-            }
+        // save as png
+        if (settings_file) {
+            cache_filename.replace_extension(".png");
+        }
 
-            // save image
-            Save_Surface(cache_filename, image_downsampled, new_width, new_height, image_bpp);
+        // limit the decoded images waiting for a worker
+        if (cache_jobs.size() >= pJob_System->Get_Worker_Count() * 2) {
+            pJob_System->Wait(cache_jobs.front());
+            cache_jobs.erase(cache_jobs.begin());
         }
 
-        delete[] image_downsampled;
+        // downsample and save in the background while the next image loads
+        cache_jobs.push_back(pJob_System->Add(new cImage_Cache_Job(sdl_surface, cache_filename, new_width, new_height)));
 
         // count files
         loaded_files++;
@@ -783,6 +857,8 @@ void cVideo::Init_Image_Cache(bool recreate /* = 0 */, bool draw_gui /* = 0 */)
         }
     }
 
+    pJob_System->Wait(cache_jobs);
+
     // set back texture detail
     m_texture_quality = real_texture_detail;
     // set directory after surfaces got loaded from Load_GL_Surface()
@@ -880,15 +956,66 @@ void cVideo::Render_From_Thread(void)
 {
     Make_GL_Context_Current();
 
+    // textures created or deleted since the last frame
+    m_render_commands->Execute();
+
     pRenderer_current->Render();
     // under linux with sofware mesa 7.9 it only showed the rendered output with SDL_GL_SwapBuffers()
 
     // update performance timer
     //pFramerate->m_perf_timer[PERF_RENDER_GAME]->Update();
 
+    // reserve texture names for the main thread
+    m_render_commands->Fill_Texture_Names();
+
     Make_GL_Context_Inactive();
 }
 
+void cVideo::Render_Thread_Loop(void)
+{
+    boost::unique_lock<boost::mutex> lock(m_render_mutex);
+
+    while (1) {
+        // wait for the next frame
+        while (!m_render_pending && !m_render_thread_exit) {
+            m_render_cond.wait(lock);
+        }
+
+        if (m_render_thread_exit) {
+            break;
+        }
+
+        lock.unlock();
+        Render_From_Thread();
+        lock.lock();
+
+        m_render_pending = 0;
+        m_render_cond.notify_all();
+    }
+}
+
+void cVideo::Render_Thread_Exit(void)
+{
+    if (!m_render_thread.joinable()) {
+        return;
+    }
+
+    Render_Finish();
+
+    {
+        boost::lock_guard<boost::mutex> lock(m_render_mutex);
+        m_render_thread_exit = 1;
+    }
+
+    m_render_cond.notify_all();
+    m_render_thread.join();
+    m_render_thread = boost::thread();
+    m_render_thread_exit = 0;
+
+    // the main thread owns the context again
+    m_render_commands->Delete_Texture_Names();
+}
+
 void cVideo::Render(bool threaded /* = 0 */)
 {
     Render_Finish();
@@ -915,10 +1042,28 @@ void cVideo::Render(bool threaded /* = 0 */)
             pRenderer->m_render_data.clear();
         }
 
+        // the camera may move before the thread renders
+        if (pActive_Camera) {
+            pRenderer_current->Set_Camera(pActive_Camera->m_x, pActive_Camera->m_y);
+        }
+
         // make main thread inactive
         Make_GL_Context_Inactive();
+
         // start render thread
-        m_render_thread = boost::thread(&cVideo::Render_From_Thread, this);
+        if (!m_render_thread.joinable()) {
+            m_render_thread = boost::thread(&cVideo::Render_Thread_Loop, this);
+        }
+
+        m_render_thread_active = 1;
+
+        // render the frame
+        {
+            boost::lock_guard<boost::mutex> lock(m_render_mutex);
+            m_render_pending = 1;
+        }
+
+        m_render_cond.notify_all();
     }
     // single thread mode
     else {
@@ -941,15 +1086,40 @@ void cVideo::Render(bool threaded /* = 0 */)
 
 void cVideo::Render_Finish(void)
 {
-#ifndef SMC_RENDER_THREAD_TEST
-    return;
-#endif
-    if (m_render_thread.joinable()) {
-        m_render_thread.join();
+    // the main thread owns the context
+    if (!m_render_thread_active) {
+        return;
+    }
+
+    // wait until the frame is rendered
+    {
+        boost::unique_lock<boost::mutex> lock(m_render_mutex);
+
+        while (m_render_pending) {
+            m_render_cond.wait(lock);
+        }
     }
 
+    m_render_thread_active = 0;
+
     // todo : use opengl in only one thread
     Make_GL_Context_Current();
+
+    // commands recorded while the frame was rendered
+    m_render_commands->Execute();
+}
+
+void cVideo::Delete_Texture(GLuint texture_id)
+{
+    // the render thread may still use it
+    if (m_render_thread_active) {
+        m_render_commands->Add(new cTexture_Delete_Command(texture_id));
+        return;
+    }
+
+    if (glIsTexture(texture_id)) {
+        glDeleteTextures(1, &texture_id);
+    }
 }
 
 void cVideo::Toggle_Fullscreen(void)
@@ -1058,7 +1228,7 @@ cVideo::cSoftware_Image cVideo :: Load_Image_Helper(boost::filesystem::path file
         if (settings_file.extension() != fs::path(".settings"))
             settings_file.replace_extension(".settings");
 
-        if (fs::exists(settings_file) && fs::is_regular_file(settings_file)) {
+        if (pPackage_Manager->Is_Archived(settings_file) || (fs::exists(settings_file) && fs::is_regular_file(settings_file))) {
             settings = pSettingsParser->Get(settings_file);
 
             // With packages support, an image loaded from a user path would have a relative path
@@ -1080,7 +1250,7 @@ cVideo::cSoftware_Image cVideo :: Load_Image_Helper(boost::filesystem::path file
                 // use current directory
                 fs::path img_filename = filename.parent_path() / settings->m_base;
 
-                if (!exists(img_filename)) {
+                if (!pPackage_Manager->Resource_Exists(img_filename)) {
                     // use data dir
                     img_filename = settings->m_base;
 
@@ -1091,14 +1261,14 @@ cVideo::cSoftware_Image cVideo :: Load_Image_Helper(boost::filesystem::path file
                         img_filename = fs::absolute(img_filename, pResource_Manager->Get_Game_Pixmaps_Directory());
                 }
 
-                sdl_surface = IMG_Load(path_to_utf8(img_filename).c_str());
+                sdl_surface = Load_SDL_Surface(img_filename);
             }
         }
     }
 
     // if not set in image settings and file exists
-    if (!sdl_surface && exists(filename) && (!settings || settings->m_base.empty())) {
-        sdl_surface = IMG_Load(path_to_utf8(filename).c_str());
+    if (!sdl_surface && pPackage_Manager->Resource_Exists(filename) && (!settings || settings->m_base.empty())) {
+        sdl_surface = Load_SDL_Surface(filename);
     }
 
     if (!sdl_surface) {
@@ -1218,20 +1388,25 @@ cGL_Surface* cVideo::Create_Texture(SDL_Surface* surface, bool mipmap /* = 0 */,
     // create final image
     surface = Convert_To_Final_Software_Image(surface);
 
-    /* todo : Make this a render request because it forces an early thread render finish as opengl commands are used directly.
-     * Reduces performance if the render thread is on. It's usually called from the text rendering in cTimeDisplay::Update.
+    GLuint image_num = 0;
+
+    /* While the render thread owns the OpenGL context use a texture name reserved by it
+     * and record the upload. Only finish the rendering early if no name is left.
     */
-    pVideo->Render_Finish();
+    if (m_render_thread_active && !m_render_commands->Get_Texture_Name(image_num)) {
+        pVideo->Render_Finish();
+    }
 
     // create one texture
-    GLuint image_num = 0;
-    glGenTextures(1, &image_num);
-
-    // if image id is 0 it failed
     if (!image_num) {
-        cerr << "Error : GL image generation failed" << endl;
-        SDL_FreeSurface(surface);
-        return NULL;
+        glGenTextures(1, &image_num);
+
+        // if image id is 0 it failed
+        if (!image_num) {
+            cerr << "Error : GL image generation failed" << endl;
+            SDL_FreeSurface(surface);
+            return NULL;
+        }
     }
 
     // set highest texture id
@@ -1261,37 +1436,36 @@ cGL_Surface* cVideo::Create_Texture(SDL_Surface* surface, bool mipmap /* = 0 */,
     // check if the image size is greater than the maximum texture size
     Apply_Max_Texture_Size(texture_width, texture_height);
 
+    // upload command which owns the surface
+    cTexture_Upload_Command* upload = new cTexture_Upload_Command();
+    upload->m_texture_id = image_num;
+    upload->m_width = texture_width;
+    upload->m_height = texture_height;
+    upload->m_mipmap = mipmap;
+
     // scale to new size
     if (texture_width != surface->w || texture_height != surface->h) {
-        int reduce_block_x = surface->w / texture_width;
-        int reduce_block_y = surface->h / texture_height;
-
         // create scaled image
         unsigned char* new_pixels = static_cast<unsigned char*>(SDL_malloc(texture_width * texture_height * 4));
-        Downscale_Image(static_cast<unsigned char*>(surface->pixels), surface->w, surface->h, surface->format->BytesPerPixel, new_pixels, reduce_block_x, reduce_block_y);
+        Resample_Image(static_cast<unsigned char*>(surface->pixels), surface->w, surface->h, surface->format->BytesPerPixel, new_pixels, texture_width, texture_height);
         SDL_free(surface->pixels);
         surface->pixels = new_pixels;
     }
     // set SDL_image pixel store mode
     else {
-        glPixelStorei(GL_UNPACK_ROW_LENGTH, surface->pitch / surface->format->BytesPerPixel);
+        upload->m_row_length = surface->pitch / surface->format->BytesPerPixel;
     }
 
-    // use the generated texture
-    glBindTexture(GL_TEXTURE_2D, image_num);
+    upload->m_surface = surface;
 
-    // set texture wrap modes which control how to interpret texture coordinates
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    // set texture magnification function
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     // upload to OpenGL texture
-    Create_GL_Texture(texture_width, texture_height, surface->pixels, mipmap);
-
-    // unset pixel store mode
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-
-    SDL_FreeSurface(surface);
+    if (m_render_thread_active) {
+        m_render_commands->Add(upload);
+    }
+    else {
+        upload->Execute();
+        delete upload;
+    }
 
     // create OpenGL surface class
     cGL_Surface* image = new cGL_Surface();
@@ -1305,16 +1479,6 @@ cGL_Surface* cVideo::Create_Texture(SDL_Surface* surface, bool mipmap /* = 0 */,
     image->m_col_w = image->m_w;
     image->m_col_h = image->m_h;
 
-    // if debug build check for errors
-#ifdef _DEBUG
-    // glGetError only saves one error flag
-    GLenum error = glGetError();
-
-    if (error != GL_NO_ERROR) {
-        cerr << "CreateTexture : GL Error found : " << gluErrorString(error) << endl;
-    }
-#endif
-
     return image;
 }
 
@@ -1576,69 +1740,19 @@ void cVideo::Apply_Max_Texture_Size(int& width, int& height) const
     }
 }
 
-/* function from Jonathan Dummer
- * from image helper functions
- * MIT license
-*/
 bool cVideo::Downscale_Image(const unsigned char* const orig, int width, int height, int channels, unsigned char* resampled, int block_size_x, int block_size_y) const
 {
     // error check
-    if (width <= 0 || height <= 0 || channels <= 0 || orig == NULL || resampled == NULL || block_size_x <= 0 || block_size_y <= 0) {
+    if (block_size_x <= 0 || block_size_y <= 0) {
         // invalid argument
         return 0;
     }
 
-    int mip_width = width / block_size_x;
-    int mip_height = height / block_size_y;
-
     // check size
-    if (mip_width < 1) {
-        mip_width = 1;
-    }
-    if (mip_height < 1) {
-        mip_height = 1;
-    }
-
-    int j, i, c;
-
-    for (j = 0; j < mip_height; ++j) {
-        for (i = 0; i < mip_width; ++i) {
-            for (c = 0; c < channels; ++c) {
-                const int index = (j * block_size_y) * width * channels + (i * block_size_x) * channels + c;
-                int sum_value;
-                int u,v;
-                int u_block = block_size_x;
-                int v_block = block_size_y;
-                int block_area;
-
-                /* do a bit of checking so we don't over-run the boundaries
-                 * necessary for non-square textures!
-                 */
-                if (block_size_x * (i + 1) > width) {
-                    u_block = width - i * block_size_y;
-                }
-                if (block_size_y * (j + 1) > height) {
-                    v_block = height - j * block_size_y;
-                }
-                block_area = u_block * v_block;
-
-                /* for this pixel, see what the average
-                 * of all the values in the block are.
-                 * note: start the sum at the rounding value, not at 0
-                 */
-                sum_value = block_area >> 1;
-                for (v = 0; v < v_block; ++v) {
-                    for (u = 0; u < u_block; ++u) {
-                        sum_value += orig[index + v * width * channels + u * channels];
-                    }
-                }
-
-                resampled[j * mip_width * channels + i * channels + c] = sum_value / block_area;
-            }
-        }
-    }
+    int mip_width = max(width / block_size_x, 1);
+    int mip_height = max(height / block_size_y, 1);
 
-    return 1;
+    return Resample_Image(orig, width, height, channels, resampled, mip_width, mip_height);
 }
 
 void cVideo::Save_Screenshot(void)
@@ -1669,6 +1783,35 @@ void cVideo::Save_Screenshot(void)
     }
 }
 
+void cVideo::Save_Screenshot(const fs::path& filename, unsigned int width, unsigned int height)
+{
+    Render_Finish();
+
+    const unsigned int screen_w = pPreferences->m_video_screen_w;
+    const unsigned int screen_h = pPreferences->m_video_screen_h;
+
+    // keep aspect ratio
+    if (screen_w * height > screen_h * width) {
+        height = std::max(1u, width * screen_h / screen_w);
+    }
+    else {
+        width = std::max(1u, height * screen_w / screen_h);
+    }
+
+    // read opengl screen
+    GLubyte* data = new GLubyte[screen_w * screen_h * 3];
+    glReadPixels(0, 0, screen_w, screen_h, GL_RGB, GL_UNSIGNED_BYTE, static_cast<GLvoid*>(data));
+
+    unsigned char* resampled = new unsigned char[width * height * 3];
+
+    if (Resample_Image(data, screen_w, screen_h, 3, resampled, width, height)) {
+        Save_Surface(filename, resampled, width, height, 3, 1);
+    }
+
+    delete[] resampled;
+    delete[] data;
+}
+
 void cVideo::Save_Surface(const fs::path& filename, const unsigned char* data, unsigned int width, unsigned int height, unsigned int bpp /* = 4 */, bool reverse_data /* = 0 */) const
 {
     FILE* fp = NULL;
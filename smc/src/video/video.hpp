@@ -47,6 +47,16 @@ namespace SMC {
         EFFECT_IN_AMOUNT
     };
 
+    /* *** *** *** *** *** *** *** cCEGUI_Resource_Provider *** *** *** *** *** *** *** *** *** *** */
+
+    /* CEGUI creates its textures while loading schemes, imagesets and layouts
+     * which needs the OpenGL context. Takes it back from the render thread before loading.
+    */
+    class cCEGUI_Resource_Provider : public CEGUI::DefaultResourceProvider {
+    public:
+        virtual void loadRawDataContainer(const CEGUI::String& filename, CEGUI::RawDataContainer& output, const CEGUI::String& resourceGroup);
+    };
+
     /* *** *** *** *** *** *** *** Video class *** *** *** *** *** *** *** *** *** *** */
 
     class cVideo {
@@ -99,10 +109,16 @@ namespace SMC {
 
         // Render. Should be called from a thread
         void Render_From_Thread(void);
-        // Render game, GUI and swap the opengl buffer
+        /* Render game, GUI and swap the opengl buffer
+         * threaded : render the game in the render thread while the next frame is updated
+        */
         void Render(bool threaded = 0);
-        // Finish thread rendering
+        /* Finish thread rendering
+         * Needed before using OpenGL directly from the main thread.
+        */
         void Render_Finish(void);
+        // Delete the texture. Deferred to the render thread if it is active.
+        void Delete_Texture(GLuint texture_id);
 
         // Toggle fullscreen video mode ( new mode is set to preferences )
         void Toggle_Fullscreen(void);
@@ -193,14 +209,18 @@ namespace SMC {
         // scale the size down if the width or height is bigger than the maximum supported texture size
         void Apply_Max_Texture_Size(int& width, int& height) const;
 
-        /* Downscale an image
+        /* Downscale an image by the given block size
          * Can be used for creating MIPmaps
-         * The incoming image should have a power-of-two size
+         * Use Resample_Image() for a target size that is not a whole block multiple
         */
         bool Downscale_Image(const unsigned char* const orig, int width, int height, int channels, unsigned char* resampled, int block_size_x, int block_size_y) const;
 
         // Save an image of the current screen
         void Save_Screenshot(void);
+        /* Save a downscaled image of the current screen
+         * The height is reduced to keep the screen aspect ratio.
+        */
+        void Save_Screenshot(const boost::filesystem::path& filename, unsigned int width, unsigned int height);
         // Save data as png image
         void Save_Surface(const boost::filesystem::path& filename, const unsigned char* data, unsigned int width, unsigned int height, unsigned int bpp = 4, bool reverse_data = 0) const;
 
@@ -239,10 +259,27 @@ namespace SMC {
 #endif
         // rendering thread
         boost::thread m_render_thread;
+        // OpenGL commands recorded while the render thread is active
+        cRender_Command_Queue* m_render_commands;
 
     private:
+        // Wait for frames and render them until exit is requested
+        void Render_Thread_Loop(void);
+        // Stop and join the render thread
+        void Render_Thread_Exit(void);
+
         // if set video is initialized successfully
         bool m_initialised;
+
+        // render thread synchronisation
+        boost::mutex m_render_mutex;
+        boost::condition_variable m_render_cond;
+        // a frame is waiting for or in rendering
+        bool m_render_pending;
+        // the render thread should exit
+        bool m_render_thread_exit;
+        // the render thread owns the OpenGL context
+        bool m_render_thread_active;
     };
 
     /* Draw an Screen Fadeout Effect